@@ -0,0 +1,228 @@
+#include "IO/BulkPuzzleImporter.h"
+#include "IO/PuzzleCollection.h"
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+const size_t BulkPuzzleImporter::kChunkSize = 1 << 22;
+
+namespace
+{
+    // regions of the default layout of a grid
+    std::vector<CellsInRegion> DefaultRegionsBuild(unsigned short size)
+    {
+        int rf = std::sqrt(size);
+        while (size % rf != 0)
+        {
+            rf--;
+        }
+        int cf = size / rf;
+
+        std::vector<CellsInRegion> regions(size);
+        for (unsigned int row = 0; row < size; ++row)
+        {
+            for (unsigned int col = 0; col < size; ++col)
+            {
+                regions[(row / rf) * rf + col / cf].insert(row * size + col);
+            }
+        }
+        return regions;
+    }
+
+    // built on first use, the initialisation of local statics is thread safe
+    const std::vector<CellsInRegion>& DefaultRegionsGet(unsigned short size)
+    {
+        static const std::vector<CellsInRegion> s_regions9 = DefaultRegionsBuild(9);
+        static const std::vector<CellsInRegion> s_regions16 = DefaultRegionsBuild(16);
+        static const std::vector<CellsInRegion> s_regions25 = DefaultRegionsBuild(25);
+        switch (size)
+        {
+        case 9:     return s_regions9;
+        case 16:    return s_regions16;
+        default:    return s_regions25;
+        }
+    }
+
+    bool IsMetadataSeparator(char c)
+    {
+        return c == ' ' || c == '\t' || c == ',' || c == ';';
+    }
+}
+
+BulkPuzzleImporter::BulkPuzzleImporter():
+    mBuffer(),
+    mCharTable(256, kInvalidChar),
+    mStats()
+{
+    mCharTable['.'] = 0;
+    mCharTable['0'] = 0;
+    mCharTable['-'] = 0;
+    for (char c = '1'; c <= '9'; ++c)
+    {
+        mCharTable[static_cast<unsigned char>(c)] = c - '0';
+    }
+    for (char c = 'A'; c <= 'P'; ++c)
+    {
+        mCharTable[static_cast<unsigned char>(c)] = c - 'A' + 10;
+        mCharTable[static_cast<unsigned char>(c - 'A' + 'a')] = c - 'A' + 10;
+    }
+}
+
+bool BulkPuzzleImporter::ParseGrid(const char *grid, unsigned short size, PuzzleData *puzzleData) const
+{
+    const std::vector<CellsInRegion>& regions = DefaultRegionsGet(size);
+    std::vector<uint32_t> rowMasks(size, 0);
+    std::vector<uint32_t> colMasks(size, 0);
+    std::vector<uint32_t> boxMasks(size, 0);
+
+    int rf = std::sqrt(size);
+    int cf = size / rf;
+
+    const unsigned int cellCount = size * size;
+    for (unsigned int i = 0; i < cellCount; ++i)
+    {
+        const signed char value = mCharTable[static_cast<unsigned char>(grid[i])];
+        if (value == kInvalidChar || value > size)
+        {
+            return false;
+        }
+        else if (value > 0)
+        {
+            const unsigned int row = i / size;
+            const unsigned int col = i % size;
+            const unsigned int box = (row / rf) * rf + col / cf;
+            const uint32_t bit = 1u << value;
+            if ((rowMasks[row] | colMasks[col] | boxMasks[box]) & bit)
+            {
+                return false;
+            }
+            rowMasks[row] |= bit;
+            colMasks[col] |= bit;
+            boxMasks[box] |= bit;
+            puzzleData->mGivens.emplace_hint(puzzleData->mGivens.end(), i, static_cast<unsigned short>(value));
+        }
+    }
+    puzzleData->mRegions = regions;
+    return true;
+}
+
+bool BulkPuzzleImporter::ParseLine(const char *begin, const char *end, const PuzzleConsumer &consumer)
+{
+    ++mStats.mLinesRead;
+
+    if (end > begin && *(end - 1) == '\r')
+    {
+        --end;
+    }
+    if (begin == end || *begin == '#')
+    {
+        return true;
+    }
+
+    const char* gridEnd = begin;
+    while (gridEnd != end && !IsMetadataSeparator(*gridEnd))
+    {
+        ++gridEnd;
+    }
+
+    const size_t length = gridEnd - begin;
+    unsigned short size = length == 81 ? 9 : (length == 256 ? 16 : (length == 625 ? 25 : 0));
+    std::unique_ptr<PuzzleData> puzzleData;
+    if (size != 0)
+    {
+        puzzleData = std::make_unique<PuzzleData>(size);
+        if (!ParseGrid(begin, size, puzzleData.get()))
+        {
+            puzzleData.reset();
+        }
+    }
+    if (!puzzleData)
+    {
+        ++mStats.mLinesRejected;
+        return true;
+    }
+
+    // skip the separators between the grid and the metadata
+    while (gridEnd != end && IsMetadataSeparator(*gridEnd))
+    {
+        ++gridEnd;
+    }
+
+    ++mStats.mPuzzlesImported;
+    return consumer(std::move(puzzleData), std::string(gridEnd, end), mStats.mLinesRead);
+}
+
+bool BulkPuzzleImporter::Import(const std::string &filepath, const PuzzleConsumer &consumer)
+{
+    mStats = Stats();
+
+    std::ifstream file(filepath, std::ios::binary);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    mBuffer.resize(kChunkSize);
+    size_t pending = 0;    // bytes of an incomplete line carried over from the previous chunk
+    while (file)
+    {
+        if (pending == mBuffer.size())
+        {
+            // a single line longer than the buffer
+            mBuffer.resize(mBuffer.size() * 2);
+        }
+        file.read(mBuffer.data() + pending, mBuffer.size() - pending);
+        const size_t read = static_cast<size_t>(file.gcount());
+        mStats.mBytesRead += read;
+
+        const char* data = mBuffer.data();
+        const char* end = data + pending + read;
+        const char* lineBegin = data;
+        while (const char* lineEnd = static_cast<const char*>(std::memchr(lineBegin, '\n', end - lineBegin)))
+        {
+            if (!ParseLine(lineBegin, lineEnd, consumer))
+            {
+                return false;
+            }
+            lineBegin = lineEnd + 1;
+        }
+
+        pending = end - lineBegin;
+        std::memmove(mBuffer.data(), lineBegin, pending);
+    }
+
+    // last line without a line break
+    if (pending > 0 && !ParseLine(mBuffer.data(), mBuffer.data() + pending, consumer))
+    {
+        return false;
+    }
+    return !file.bad();
+}
+
+const BulkPuzzleImporter::Stats &BulkPuzzleImporter::StatsGet() const
+{
+    return mStats;
+}
+
+bool BulkPuzzleImporter::ImportToCollection(const std::string &textFile, const std::string &collectionPath, Stats *outStats)
+{
+    PuzzleCollectionWriter writer;
+    if (!writer.Open(collectionPath))
+    {
+        return false;
+    }
+
+    BulkPuzzleImporter importer;
+    bool success = importer.Import(textFile, [&writer](std::unique_ptr<PuzzleData> puzzleData, const std::string&, size_t)
+    {
+        writer.AddPuzzle(*puzzleData);
+        return true;
+    });
+    success = writer.Finish() && success;
+
+    if (outStats)
+    {
+        *outStats = importer.StatsGet();
+    }
+    return success;
+}
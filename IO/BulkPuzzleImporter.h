@@ -0,0 +1,71 @@
+#ifndef BULK_PUZZLE_IMPORTER_H
+#define BULK_PUZZLE_IMPORTER_H
+
+#include "puzzledata.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+/*
+ * Streaming reader for the one-line puzzle formats:
+ *   81 characters   9x9 grid,   '1'-'9' for givens
+ *   256 characters  16x16 grid, '1'-'9' and 'A'-'G' (or 'a'-'g') for givens
+ *   625 characters  25x25 grid, '1'-'9' and 'A'-'P' (or 'a'-'p') for givens
+ * Empty cells are written as '.', '0' or '-'. Anything following the grid on
+ * the same line, after a space, tab, comma or semicolon, is passed along as
+ * metadata (rating, name, source, ...). Empty lines and lines starting with
+ * '#' are skipped.
+ */
+
+/// <summary>
+/// Import puzzles from a one-line collection file. The file is read in large
+/// chunks and parsed in place; each valid puzzle is handed to a consumer
+/// together with its metadata and line number.
+/// </summary>
+class BulkPuzzleImporter
+{
+public:
+    /// <summary>
+    /// Receives each imported puzzle. Returning false stops the import.
+    /// </summary>
+    typedef std::function<bool(std::unique_ptr<PuzzleData> puzzleData, const std::string& metadata, size_t lineNumber)> PuzzleConsumer;
+
+    struct Stats
+    {
+        uint64_t mBytesRead;
+        size_t mLinesRead;
+        size_t mPuzzlesImported;
+        size_t mLinesRejected;      // malformed lines or grids with repeated givens
+    };
+
+private:
+    static const size_t kChunkSize;
+    static constexpr signed char kInvalidChar = -1;
+
+    std::vector<char> mBuffer;
+    std::vector<signed char> mCharTable;    // maps each character to a cell value, 0 for empty cells
+    Stats mStats;
+
+    bool ParseLine(const char* begin, const char* end, const PuzzleConsumer& consumer);
+    bool ParseGrid(const char* grid, unsigned short size, PuzzleData* puzzleData) const;
+
+public:
+    BulkPuzzleImporter();
+
+    /// <summary>
+    /// Parse the file at the specified path. Returns false if the file cannot
+    /// be read or the consumer stopped the import.
+    /// </summary>
+    bool Import(const std::string& filepath, const PuzzleConsumer& consumer);
+
+    const Stats& StatsGet() const;
+
+    /// <summary>
+    /// Convert a one-line collection into a binary puzzle collection
+    /// </summary>
+    static bool ImportToCollection(const std::string& textFile, const std::string& collectionPath, Stats* outStats = nullptr);
+};
+
+#endif // BULK_PUZZLE_IMPORTER_H
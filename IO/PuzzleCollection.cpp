@@ -0,0 +1,513 @@
+#include "IO/PuzzleCollection.h"
+#include "IO/SaveLoadManager.h"
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    enum Flags : unsigned char
+    {
+        Flag_PositiveDiagonal = 1 << 0,
+        Flag_NegativeDiagonal = 1 << 1
+    };
+
+    void WriteVarint(std::string& out, uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            out += static_cast<char>((value & 0x7F) | 0x80);
+            value >>= 7;
+        }
+        out += static_cast<char>(value);
+    }
+
+    bool ReadVarint(const unsigned char*& p, const unsigned char* end, uint64_t& value)
+    {
+        value = 0;
+        for (unsigned int shift = 0; shift < 64; shift += 7)
+        {
+            if (p == end)
+            {
+                return false;
+            }
+            const unsigned char byte = *p++;
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void WriteFixed(std::string& out, uint64_t value, size_t bytes)
+    {
+        for (size_t i = 0; i < bytes; ++i)
+        {
+            out += static_cast<char>((value >> (8 * i)) & 0xFF);
+        }
+    }
+
+    uint64_t ReadFixed(const unsigned char* p, size_t bytes)
+    {
+        uint64_t value = 0;
+        for (size_t i = 0; i < bytes; ++i)
+        {
+            value |= static_cast<uint64_t>(p[i]) << (8 * i);
+        }
+        return value;
+    }
+
+    // cells are written in ascending order as the difference from the previous one
+    void WriteCells(std::string& out, const CellsInRegion& cells)
+    {
+        WriteVarint(out, cells.size());
+        CellCoord previous = 0;
+        for (const CellCoord& c : cells)
+        {
+            WriteVarint(out, c - previous);
+            previous = c;
+        }
+    }
+
+    bool ReadCells(const unsigned char*& p, const unsigned char* end, uint64_t cellCount, CellsInRegion& outCells)
+    {
+        uint64_t count;
+        if (!ReadVarint(p, end, count) || count > cellCount)
+        {
+            return false;
+        }
+        uint64_t cell = 0;
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            uint64_t delta;
+            // a delta past the grid could wrap the cell id around
+            if (!ReadVarint(p, end, delta) || delta >= cellCount)
+            {
+                return false;
+            }
+            cell += delta;
+            if (cell >= cellCount)
+            {
+                return false;
+            }
+            outCells.emplace_hint(outCells.end(), static_cast<CellCoord>(cell));
+        }
+        return true;
+    }
+}
+
+const char* const PuzzleCollection::kFileExtension = "sdkc";
+const char PuzzleCollection::kMagic[4] = {'S', 'D', 'K', 'C'};
+const uint16_t PuzzleCollection::kVersion = 1;
+const size_t PuzzleCollection::kHeaderSize = 32;
+
+PuzzleCollection::PuzzleCollection():
+    mData(nullptr),
+    mSize(0),
+    mCount(0),
+    mIndex(nullptr),
+#ifdef _WIN32
+    mFileHandle(INVALID_HANDLE_VALUE),
+    mMappingHandle(nullptr)
+#else
+    mFileDescriptor(-1)
+#endif
+{
+}
+
+PuzzleCollection::~PuzzleCollection()
+{
+    Close();
+}
+
+bool PuzzleCollection::Open(const std::string &filepath)
+{
+    Close();
+
+#ifdef _WIN32
+    mFileHandle = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (mFileHandle == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(mFileHandle, &fileSize) || fileSize.QuadPart < static_cast<LONGLONG>(kHeaderSize))
+    {
+        Close();
+        return false;
+    }
+    mSize = static_cast<size_t>(fileSize.QuadPart);
+    mMappingHandle = CreateFileMappingA(mFileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mMappingHandle)
+    {
+        Close();
+        return false;
+    }
+    mData = static_cast<const unsigned char*>(MapViewOfFile(mMappingHandle, FILE_MAP_READ, 0, 0, 0));
+#else
+    mFileDescriptor = open(filepath.c_str(), O_RDONLY);
+    if (mFileDescriptor < 0)
+    {
+        return false;
+    }
+    struct stat fileStat;
+    if (fstat(mFileDescriptor, &fileStat) != 0 || fileStat.st_size < static_cast<off_t>(kHeaderSize))
+    {
+        Close();
+        return false;
+    }
+    mSize = static_cast<size_t>(fileStat.st_size);
+    void* map = mmap(nullptr, mSize, PROT_READ, MAP_SHARED, mFileDescriptor, 0);
+    mData = map == MAP_FAILED ? nullptr : static_cast<const unsigned char*>(map);
+#endif
+    if (!mData)
+    {
+        Close();
+        return false;
+    }
+
+    // validate the header and the index
+    const uint64_t count = ReadFixed(mData + 8, 8);
+    const uint64_t indexOffset = ReadFixed(mData + 16, 8);
+    if (std::memcmp(mData, kMagic, sizeof(kMagic)) != 0 ||
+        ReadFixed(mData + 4, 2) != kVersion ||
+        indexOffset < kHeaderSize ||
+        indexOffset > mSize ||
+        count >= (mSize - indexOffset) / 8)
+    {
+        Close();
+        return false;
+    }
+    mCount = count;
+    mIndex = mData + indexOffset;
+    return true;
+}
+
+void PuzzleCollection::Close()
+{
+#ifdef _WIN32
+    if (mData)
+    {
+        UnmapViewOfFile(mData);
+    }
+    if (mMappingHandle)
+    {
+        CloseHandle(mMappingHandle);
+    }
+    if (mFileHandle != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(mFileHandle);
+    }
+    mMappingHandle = nullptr;
+    mFileHandle = INVALID_HANDLE_VALUE;
+#else
+    if (mData)
+    {
+        munmap(const_cast<unsigned char*>(mData), mSize);
+    }
+    if (mFileDescriptor >= 0)
+    {
+        close(mFileDescriptor);
+    }
+    mFileDescriptor = -1;
+#endif
+    mData = nullptr;
+    mSize = 0;
+    mCount = 0;
+    mIndex = nullptr;
+}
+
+bool PuzzleCollection::IsOpen() const
+{
+    return mData != nullptr;
+}
+
+size_t PuzzleCollection::CountGet() const
+{
+    return static_cast<size_t>(mCount);
+}
+
+bool PuzzleCollection::RecordGet(size_t index, const unsigned char *&outData, size_t &outSize) const
+{
+    if (!mData || index >= mCount)
+    {
+        return false;
+    }
+    // the records lie in order between the header and the index
+    const uint64_t begin = ReadFixed(mIndex + 8 * index, 8);
+    const uint64_t end = ReadFixed(mIndex + 8 * (index + 1), 8);
+    if (begin < kHeaderSize || end < begin || end > static_cast<uint64_t>(mIndex - mData))
+    {
+        return false;
+    }
+    outData = mData + begin;
+    outSize = static_cast<size_t>(end - begin);
+    return true;
+}
+
+bool PuzzleCollection::LoadPuzzle(size_t index, std::unique_ptr<PuzzleData> &puzzleData) const
+{
+    const unsigned char* data;
+    size_t size;
+    return RecordGet(index, data, size) && DecodePuzzle(data, size, puzzleData);
+}
+
+bool PuzzleCollection::ExportPuzzle(size_t index, const std::string &filepath) const
+{
+    std::unique_ptr<PuzzleData> puzzleData;
+    return LoadPuzzle(index, puzzleData) && SaveLoadManager::Get()->SaveSudoku(filepath, *puzzleData);
+}
+
+void PuzzleCollection::EncodePuzzle(const PuzzleData &puzzleData, std::string &outBuffer)
+{
+    WriteVarint(outBuffer, puzzleData.mSize);
+
+    unsigned char flags = 0;
+    if (puzzleData.mPositiveDiagonal) flags |= Flag_PositiveDiagonal;
+    if (puzzleData.mNegativeDiagonal) flags |= Flag_NegativeDiagonal;
+    outBuffer += static_cast<char>(flags);
+
+    // givens
+    WriteVarint(outBuffer, puzzleData.mGivens.size());
+    CellCoord previous = 0;
+    for (const auto& g : puzzleData.mGivens)
+    {
+        WriteVarint(outBuffer, g.first - previous);
+        WriteVarint(outBuffer, g.second);
+        previous = g.first;
+    }
+
+    // hints
+    WriteVarint(outBuffer, puzzleData.mHints.size());
+    previous = 0;
+    for (const auto& h : puzzleData.mHints)
+    {
+        WriteVarint(outBuffer, h.first - previous);
+        WriteVarint(outBuffer, h.second.size());
+        for (const auto& v : h.second)
+        {
+            WriteVarint(outBuffer, v);
+        }
+        previous = h.first;
+    }
+
+    // regions (empty regions are not stored)
+    size_t regionCount = 0;
+    for (const auto& r : puzzleData.mRegions)
+    {
+        regionCount += r.empty() ? 0 : 1;
+    }
+    WriteVarint(outBuffer, regionCount);
+    for (size_t i = 0; i < puzzleData.mRegions.size(); ++i)
+    {
+        if (puzzleData.mRegions[i].empty()) continue;
+        WriteVarint(outBuffer, i);
+        WriteCells(outBuffer, puzzleData.mRegions[i]);
+    }
+
+    // killer cages
+    WriteVarint(outBuffer, puzzleData.mKillerCages.size());
+    previous = 0;
+    for (const auto& k : puzzleData.mKillerCages)
+    {
+        WriteVarint(outBuffer, k.first - previous);
+        WriteVarint(outBuffer, k.second.first);
+        WriteCells(outBuffer, k.second.second);
+        previous = k.first;
+    }
+}
+
+bool PuzzleCollection::DecodePuzzle(const unsigned char *data, size_t size, std::unique_ptr<PuzzleData> &puzzleData)
+{
+    const unsigned char* p = data;
+    const unsigned char* end = data + size;
+    uint64_t value;
+
+    if (!ReadVarint(p, end, value) || value == 0 || value > 0xFF || p == end)
+    {
+        return false;
+    }
+    const unsigned short gridSize = static_cast<unsigned short>(value);
+    const uint64_t cellCount = static_cast<uint64_t>(gridSize) * gridSize;
+    auto result = std::make_unique<PuzzleData>(gridSize);
+
+    const unsigned char flags = *p++;
+    result->mPositiveDiagonal = (flags & Flag_PositiveDiagonal) != 0;
+    result->mNegativeDiagonal = (flags & Flag_NegativeDiagonal) != 0;
+
+    // givens
+    uint64_t count;
+    if (!ReadVarint(p, end, count)) return false;
+    uint64_t cell = 0;
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        uint64_t delta;
+        if (!ReadVarint(p, end, delta) || delta >= cellCount || !ReadVarint(p, end, value)) return false;
+        cell += delta;
+        if (cell >= cellCount || value == 0 || value > gridSize) return false;
+        result->mGivens.emplace_hint(result->mGivens.end(), static_cast<CellCoord>(cell), static_cast<unsigned short>(value));
+    }
+
+    // hints
+    if (!ReadVarint(p, end, count)) return false;
+    cell = 0;
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        uint64_t delta;
+        uint64_t hintCount;
+        if (!ReadVarint(p, end, delta) || delta >= cellCount || !ReadVarint(p, end, hintCount)) return false;
+        cell += delta;
+        if (cell >= cellCount || hintCount > gridSize) return false;
+        auto& hints = result->mHints[static_cast<CellCoord>(cell)];
+        for (uint64_t j = 0; j < hintCount; ++j)
+        {
+            if (!ReadVarint(p, end, value) || value == 0 || value > gridSize) return false;
+            hints.insert(static_cast<unsigned short>(value));
+        }
+    }
+
+    // regions
+    if (!ReadVarint(p, end, count)) return false;
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        if (!ReadVarint(p, end, value) || value >= result->mRegions.size()) return false;
+        if (!ReadCells(p, end, cellCount, result->mRegions[value])) return false;
+    }
+
+    // killer cages
+    if (!ReadVarint(p, end, count)) return false;
+    uint64_t cageId = 0;
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        uint64_t delta;
+        if (!ReadVarint(p, end, delta) || delta >= cellCount || !ReadVarint(p, end, value)) return false;
+        cageId += delta;
+        // the id of a cage is the id of one of its cells
+        if (cageId >= cellCount) return false;
+        auto& cage = result->mKillerCages[static_cast<CellCoord>(cageId)];
+        cage.first = static_cast<unsigned int>(value);
+        if (!ReadCells(p, end, cellCount, cage.second)) return false;
+    }
+
+    if (p != end)
+    {
+        return false;
+    }
+    puzzleData = std::move(result);
+    return true;
+}
+
+bool PuzzleCollection::ImportTextPuzzles(const std::vector<std::string> &textFiles, const std::string &collectionPath)
+{
+    PuzzleCollectionWriter writer;
+    if (!writer.Open(collectionPath))
+    {
+        return false;
+    }
+    for (const auto& path : textFiles)
+    {
+        std::unique_ptr<PuzzleData> puzzleData;
+        if (!SaveLoadManager::Get()->LoadSudoku(path, puzzleData))
+        {
+            return false;
+        }
+        writer.AddPuzzle(*puzzleData);
+    }
+    return writer.Finish();
+}
+
+const size_t PuzzleCollectionWriter::kFlushSize = 1 << 20;
+
+PuzzleCollectionWriter::PuzzleCollectionWriter():
+    mFile(),
+    mOffsets(),
+    mBuffer(),
+    mPosition(0),
+    mFailed(false)
+{
+}
+
+PuzzleCollectionWriter::~PuzzleCollectionWriter()
+{
+}
+
+bool PuzzleCollectionWriter::Open(const std::string &filepath)
+{
+    mFile.open(filepath, std::ios::binary | std::ios::trunc);
+    mOffsets.clear();
+    mBuffer.clear();
+    mFailed = !mFile.is_open();
+
+    // the header is written again by Finish(), once the number of puzzles is known
+    mBuffer.assign(PuzzleCollection::kHeaderSize, '\0');
+    mPosition = PuzzleCollection::kHeaderSize;
+    return !mFailed;
+}
+
+void PuzzleCollectionWriter::AddPuzzle(const PuzzleData &puzzleData)
+{
+    const size_t bufferSize = mBuffer.size();
+    mOffsets.push_back(mPosition);
+    PuzzleCollection::EncodePuzzle(puzzleData, mBuffer);
+    mPosition += mBuffer.size() - bufferSize;
+
+    if (mBuffer.size() >= kFlushSize)
+    {
+        Flush();
+    }
+}
+
+void PuzzleCollectionWriter::Flush()
+{
+    if (!mBuffer.empty())
+    {
+        mFile.write(mBuffer.data(), static_cast<std::streamsize>(mBuffer.size()));
+        mFailed = mFailed || !mFile;
+        mBuffer.clear();
+    }
+}
+
+bool PuzzleCollectionWriter::Finish()
+{
+    if (!mFile.is_open())
+    {
+        return false;
+    }
+
+    // index
+    const uint64_t indexOffset = mPosition;
+    mOffsets.push_back(indexOffset);
+    for (const auto& offset : mOffsets)
+    {
+        WriteFixed(mBuffer, offset, 8);
+        if (mBuffer.size() >= kFlushSize)
+        {
+            Flush();
+        }
+    }
+    Flush();
+
+    // header
+    std::string header(PuzzleCollection::kMagic, sizeof(PuzzleCollection::kMagic));
+    WriteFixed(header, PuzzleCollection::kVersion, 2);
+    WriteFixed(header, 0, 2);
+    WriteFixed(header, mOffsets.size() - 1, 8);
+    WriteFixed(header, indexOffset, 8);
+    WriteFixed(header, 0, 8);
+    mFile.seekp(0);
+    mFile.write(header.data(), static_cast<std::streamsize>(header.size()));
+    mFailed = mFailed || !mFile;
+
+    mFile.close();
+    mOffsets.clear();
+    return !mFailed;
+}
@@ -0,0 +1,121 @@
+#ifndef PUZZLE_COLLECTION_H
+#define PUZZLE_COLLECTION_H
+
+#include "puzzledata.h"
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+/*
+ * Binary container for large collections of puzzles.
+ *
+ * Layout (all fixed-width integers are little endian):
+ *   header    magic "SDKC", uint16 version, uint16 reserved,
+ *             uint64 puzzle count, uint64 offset of the index, uint64 reserved
+ *   records   one varint-packed record per puzzle (see PuzzleCollection::EncodePuzzle)
+ *   index     uint64 offset of each record, followed by the offset of the index itself,
+ *             so that the size of record i is offset[i + 1] - offset[i]
+ */
+
+/// <summary>
+/// Read-only view of a puzzle collection file. The file is memory mapped and
+/// each puzzle is decoded on demand, so opening a collection and accessing
+/// any of its puzzles takes constant time regardless of the collection size.
+/// </summary>
+class PuzzleCollection
+{
+    const unsigned char* mData;     // start of the mapped file
+    size_t mSize;                   // size of the mapped file
+    uint64_t mCount;                // number of puzzles
+    const unsigned char* mIndex;    // start of the offset table
+#ifdef _WIN32
+    void* mFileHandle;
+    void* mMappingHandle;
+#else
+    int mFileDescriptor;
+#endif
+
+public:
+    static const char* const kFileExtension;
+    static const char kMagic[4];
+    static const uint16_t kVersion;
+    static const size_t kHeaderSize;
+
+    PuzzleCollection();
+    ~PuzzleCollection();
+    PuzzleCollection(const PuzzleCollection&) = delete;
+    PuzzleCollection& operator=(const PuzzleCollection&) = delete;
+
+    /// <summary>
+    /// Map the collection at the specified path. Returns false if the file
+    /// cannot be opened or is not a valid collection.
+    /// </summary>
+    bool Open(const std::string& filepath);
+    void Close();
+
+    bool IsOpen() const;
+    size_t CountGet() const;
+
+    /// <summary>
+    /// Zero-copy access to the encoded record of a puzzle
+    /// </summary>
+    bool RecordGet(size_t index, const unsigned char*& outData, size_t& outSize) const;
+
+    /// <summary>
+    /// Decode the puzzle at the specified index
+    /// </summary>
+    bool LoadPuzzle(size_t index, std::unique_ptr<PuzzleData>& puzzleData) const;
+
+    /// <summary>
+    /// Save the puzzle at the specified index in the text format used by SaveLoadManager
+    /// </summary>
+    bool ExportPuzzle(size_t index, const std::string& filepath) const;
+
+    /// <summary>
+    /// Append the binary representation of a puzzle to a buffer
+    /// </summary>
+    static void EncodePuzzle(const PuzzleData& puzzleData, std::string& outBuffer);
+
+    /// <summary>
+    /// Build a puzzle from its binary representation. Returns false if the record is malformed.
+    /// </summary>
+    static bool DecodePuzzle(const unsigned char* data, size_t size, std::unique_ptr<PuzzleData>& puzzleData);
+
+    /// <summary>
+    /// Pack a list of puzzles saved in the text format into a new collection
+    /// </summary>
+    static bool ImportTextPuzzles(const std::vector<std::string>& textFiles, const std::string& collectionPath);
+};
+
+/// <summary>
+/// Writes a puzzle collection sequentially. The records are streamed to disk
+/// as they are added; the index and the header are written by Finish().
+/// </summary>
+class PuzzleCollectionWriter
+{
+    std::ofstream mFile;
+    std::vector<uint64_t> mOffsets;
+    std::string mBuffer;
+    uint64_t mPosition;
+    bool mFailed;
+
+    static const size_t kFlushSize;
+
+    void Flush();
+
+public:
+    PuzzleCollectionWriter();
+    ~PuzzleCollectionWriter();
+
+    bool Open(const std::string& filepath);
+    void AddPuzzle(const PuzzleData& puzzleData);
+
+    /// <summary>
+    /// Write the index and the header. Returns false if any write has failed.
+    /// </summary>
+    bool Finish();
+};
+
+#endif // PUZZLE_COLLECTION_H
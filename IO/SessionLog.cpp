@@ -0,0 +1,283 @@
+#include "SessionLog.h"
+#include "solver/BruteForceSolver.h"
+#include "solver/GridProgressManager.h"
+#include <fstream>
+#include <sstream>
+
+const int SessionLog::kVersion = 1;
+const unsigned int SessionLog::kMaxGridSize = 36;
+
+namespace
+{
+    const char* const kHeader = "SudokuSession";
+
+    char EntryCodeGet(SessionLog::EntryType type)
+    {
+        switch (type)
+        {
+        case SessionLog::Entry_Command:          return 'C';
+        case SessionLog::Entry_Submit:           return 'S';
+        case SessionLog::Entry_SetPaused:        return 'P';
+        case SessionLog::Entry_TakeStep:         return 'T';
+        case SessionLog::Entry_SearchEngine:     return 'E';
+        case SessionLog::Entry_SchedulingMode:   return 'M';
+        case SessionLog::Entry_CountSolutions:   return 'B';
+        case SessionLog::Entry_DisplaySolution:  return 'D';
+        case SessionLog::Entry_AbortBruteForce:  return 'A';
+        case SessionLog::Entry_End:              return 'X';
+        }
+        return '?';
+    }
+
+    bool EntryTypeGet(char code, SessionLog::EntryType& outType)
+    {
+        static const SessionLog::EntryType types[] =
+        {
+            SessionLog::Entry_Command, SessionLog::Entry_Submit, SessionLog::Entry_SetPaused,
+            SessionLog::Entry_TakeStep, SessionLog::Entry_SearchEngine, SessionLog::Entry_SchedulingMode,
+            SessionLog::Entry_CountSolutions, SessionLog::Entry_DisplaySolution, SessionLog::Entry_AbortBruteForce,
+            SessionLog::Entry_End
+        };
+        for (const auto type : types)
+        {
+            if (EntryCodeGet(type) == code)
+            {
+                outType = type;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // whether the id and the value of a command refer to a cell, region or digit of the grid
+    bool IsValidCommand(const SolverCommand& command, unsigned int gridSize)
+    {
+        const CellCoord cellsCount = gridSize * gridSize;
+        switch (command.mType)
+        {
+        case SolverCommand::Command_AddGiven:
+        case SolverCommand::Command_AddHint:
+        case SolverCommand::Command_RemoveHint:
+            return command.mId < cellsCount && command.mValue >= 1 && command.mValue <= gridSize;
+        case SolverCommand::Command_RemoveGiven:
+        case SolverCommand::Command_AddKillerCage:
+        case SolverCommand::Command_RemoveKillerCage:
+            return command.mId < cellsCount;
+        case SolverCommand::Command_SetRegion:
+            return command.mId < gridSize;
+        case SolverCommand::Command_SetDiagonal:
+            return (command.mId == PuzzleData::Diagonal_Negative || command.mId == PuzzleData::Diagonal_Positive) &&
+                   command.mValue <= 1;
+        default:
+            return true;
+        }
+    }
+}
+
+SessionLog::SessionLog(unsigned short gridSize):
+    mGridSize(gridSize),
+    mEntries(),
+    mStart(std::chrono::steady_clock::now()),
+    mMutex()
+{
+}
+
+unsigned short SessionLog::GridSizeGet() const
+{
+    return mGridSize;
+}
+
+std::vector<SessionLog::Entry> SessionLog::EntriesGet() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mEntries;
+}
+
+void SessionLog::Record(EntryType type, SolverCommand command, unsigned int value, bool useHints)
+{
+    const long long time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - mStart).count();
+    std::lock_guard<std::mutex> lock(mMutex);
+    mEntries.push_back(Entry{time, type, std::move(command), value, useHints});
+}
+
+void SessionLog::RecordCommand(const SolverCommand &command)
+{
+    Record(Entry_Command, command);
+}
+
+void SessionLog::RecordSubmit()
+{
+    Record(Entry_Submit, SolverCommand());
+}
+
+void SessionLog::RecordSetPaused(bool paused)
+{
+    Record(Entry_SetPaused, SolverCommand(), paused ? 1 : 0);
+}
+
+void SessionLog::RecordTakeStep()
+{
+    Record(Entry_TakeStep, SolverCommand());
+}
+
+void SessionLog::RecordSearchEngine(unsigned int engine)
+{
+    Record(Entry_SearchEngine, SolverCommand(), engine);
+}
+
+void SessionLog::RecordSchedulingMode(unsigned int mode)
+{
+    Record(Entry_SchedulingMode, SolverCommand(), mode);
+}
+
+void SessionLog::RecordCountSolutions(size_t maxSolutionsCount, bool useHints)
+{
+    Record(Entry_CountSolutions, SolverCommand(), static_cast<unsigned int>(maxSolutionsCount), useHints);
+}
+
+void SessionLog::RecordDisplaySolution(size_t maxSolutionsCount, bool useHints)
+{
+    Record(Entry_DisplaySolution, SolverCommand(), static_cast<unsigned int>(maxSolutionsCount), useHints);
+}
+
+void SessionLog::RecordAbortBruteForce()
+{
+    Record(Entry_AbortBruteForce, SolverCommand());
+}
+
+void SessionLog::RecordEnd()
+{
+    Record(Entry_End, SolverCommand());
+}
+
+void SessionLog::Write(std::ostream &stream) const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    stream << kHeader << " " << kVersion << " " << mGridSize << "\n";
+    for (const auto& entry : mEntries)
+    {
+        stream << entry.mTime << " " << EntryCodeGet(entry.mType);
+        switch (entry.mType)
+        {
+        case Entry_Command:
+            stream << " " << entry.mCommand.mType << " " << entry.mCommand.mId << " " << entry.mCommand.mValue
+                   << " " << entry.mCommand.mCells.size();
+            for (const CellCoord cell : entry.mCommand.mCells)
+            {
+                stream << " " << cell;
+            }
+            break;
+        case Entry_SetPaused:
+        case Entry_SearchEngine:
+        case Entry_SchedulingMode:
+            stream << " " << entry.mValue;
+            break;
+        case Entry_CountSolutions:
+        case Entry_DisplaySolution:
+            stream << " " << entry.mValue << " " << (entry.mUseHints ? 1 : 0);
+            break;
+        default:
+            break;
+        }
+        stream << "\n";
+    }
+}
+
+bool SessionLog::Save(const std::string &filepath) const
+{
+    std::ofstream file(filepath, std::ios::trunc);
+    if (!file.is_open())
+    {
+        return false;
+    }
+    Write(file);
+    return static_cast<bool>(file);
+}
+
+bool SessionLog::Read(std::istream &stream)
+{
+    std::string header;
+    int version = 0;
+    unsigned int gridSize = 0;
+    if (!(stream >> header >> version >> gridSize) || header != kHeader || version != kVersion ||
+        gridSize == 0 || gridSize > kMaxGridSize)
+    {
+        return false;
+    }
+
+    std::vector<Entry> entries;
+    const CellCoord cellsCount = gridSize * gridSize;
+    std::string line;
+    while (std::getline(stream, line))
+    {
+        if (line.empty())
+        {
+            continue;
+        }
+        std::istringstream lineStream(line);
+        Entry entry{0, Entry_Submit, SolverCommand(), 0, false};
+        char code = 0;
+        if (!(lineStream >> entry.mTime >> code) || !EntryTypeGet(code, entry.mType))
+        {
+            return false;
+        }
+
+        bool valid = true;
+        switch (entry.mType)
+        {
+        case Entry_Command:
+        {
+            int type = 0;
+            size_t count = 0;
+            valid = static_cast<bool>(lineStream >> type >> entry.mCommand.mId >> entry.mCommand.mValue >> count) &&
+                    type > SolverCommand::Command_None && type <= SolverCommand::Command_ResetSolver && count <= cellsCount;
+            entry.mCommand.mType = static_cast<SolverCommand::Type>(type);
+            for (size_t i = 0; valid && i < count; ++i)
+            {
+                CellCoord cell = 0;
+                valid = static_cast<bool>(lineStream >> cell) && cell < cellsCount;
+                entry.mCommand.mCells.insert(cell);
+            }
+            valid = valid && IsValidCommand(entry.mCommand, gridSize);
+            break;
+        }
+        case Entry_SetPaused:
+            valid = static_cast<bool>(lineStream >> entry.mValue) && entry.mValue <= 1;
+            break;
+        case Entry_SearchEngine:
+            valid = static_cast<bool>(lineStream >> entry.mValue) &&
+                    entry.mValue <= static_cast<unsigned int>(BruteForceSolver::SearchEngine::ConflictDriven);
+            break;
+        case Entry_SchedulingMode:
+            valid = static_cast<bool>(lineStream >> entry.mValue) &&
+                    entry.mValue <= static_cast<unsigned int>(SchedulingMode::Adaptive);
+            break;
+        case Entry_CountSolutions:
+        case Entry_DisplaySolution:
+        {
+            int useHints = 0;
+            valid = static_cast<bool>(lineStream >> entry.mValue >> useHints);
+            entry.mUseHints = useHints != 0;
+            break;
+        }
+        default:
+            break;
+        }
+        if (!valid)
+        {
+            return false;
+        }
+        entries.push_back(std::move(entry));
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    mGridSize = static_cast<unsigned short>(gridSize);
+    mEntries = std::move(entries);
+    return true;
+}
+
+bool SessionLog::Load(const std::string &filepath)
+{
+    std::ifstream file(filepath);
+    return file.is_open() && Read(file);
+}
@@ -0,0 +1,98 @@
+#ifndef SESSION_LOG_H
+#define SESSION_LOG_H
+
+#include "solvercommand.h"
+#include <chrono>
+#include <istream>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/*
+ * Log file layout: a header line "SudokuSession <version> <grid size>", then one line per entry,
+ * starting with its time in milliseconds from the start of the recording and a letter for its type:
+ *   C <command type> <id> <value> <cells count> <cells...>   puzzle edit posted to the solver
+ *   S                                                        edits submitted to the solver
+ *   P <0|1>                                                  logical solver resumed or paused
+ *   T                                                        single logical step
+ *   E <engine>                                               brute force search engine changed
+ *   M <mode>                                                 logical solver scheduling mode changed
+ *   B <max solutions> <0|1>                                  solutions count, with the hints flag
+ *   D <max solutions> <0|1>                                  solution display, with the hints flag
+ *   A                                                        brute force calculation aborted
+ *   X                                                        end of the session
+ */
+
+/// <summary>
+/// Record of the inputs of a solver session, in the order they were given to the solvers,
+/// so that a session reported as slow can be replayed (see SessionReplayer).
+/// Entries can be recorded from any thread.
+/// </summary>
+class SessionLog
+{
+public:
+    enum EntryType
+    {
+        Entry_Command,
+        Entry_Submit,
+        Entry_SetPaused,
+        Entry_TakeStep,
+        Entry_SearchEngine,
+        Entry_SchedulingMode,
+        Entry_CountSolutions,
+        Entry_DisplaySolution,
+        Entry_AbortBruteForce,
+        Entry_End
+    };
+
+    struct Entry
+    {
+        long long mTime;            // milliseconds from the start of the recording
+        EntryType mType;
+        SolverCommand mCommand;     // Entry_Command only
+        unsigned int mValue;        // paused flag, search engine, scheduling mode or max solutions count
+        bool mUseHints;             // brute force requests only
+    };
+
+    static const int kVersion;
+    static const unsigned int kMaxGridSize;     // largest grid the solvers support
+
+private:
+    unsigned short mGridSize;
+    std::vector<Entry> mEntries;
+    std::chrono::steady_clock::time_point mStart;
+    mutable std::mutex mMutex;
+
+    void Record(EntryType type, SolverCommand command, unsigned int value = 0, bool useHints = false);
+
+public:
+    explicit SessionLog(unsigned short gridSize);
+    SessionLog(const SessionLog&) = delete;
+    SessionLog& operator=(const SessionLog&) = delete;
+
+    unsigned short GridSizeGet() const;
+    std::vector<Entry> EntriesGet() const;
+
+    void RecordCommand(const SolverCommand& command);
+    void RecordSubmit();
+    void RecordSetPaused(bool paused);
+    void RecordTakeStep();
+    void RecordSearchEngine(unsigned int engine);
+    void RecordSchedulingMode(unsigned int mode);
+    void RecordCountSolutions(size_t maxSolutionsCount, bool useHints);
+    void RecordDisplaySolution(size_t maxSolutionsCount, bool useHints);
+    void RecordAbortBruteForce();
+    void RecordEnd();
+
+    void Write(std::ostream& stream) const;
+    bool Save(const std::string& filepath) const;
+
+    /// <summary>
+    /// Read a log written by Write. Returns false if the stream is not a valid log.
+    /// </summary>
+    bool Read(std::istream& stream);
+    bool Load(const std::string& filepath);
+};
+
+#endif // SESSION_LOG_H
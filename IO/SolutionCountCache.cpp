@@ -0,0 +1,256 @@
+#include "IO/SolutionCountCache.h"
+#include "IO/PuzzleCollection.h"
+#include <QLockFile>
+#include <QString>
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+
+namespace
+{
+    void WriteVarint(std::string& out, uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            out += static_cast<char>((value & 0x7F) | 0x80);
+            value >>= 7;
+        }
+        out += static_cast<char>(value);
+    }
+
+    bool ReadVarint(const unsigned char*& p, const unsigned char* end, uint64_t& value)
+    {
+        value = 0;
+        for (unsigned int shift = 0; shift < 64; shift += 7)
+        {
+            if (p == end)
+            {
+                return false;
+            }
+            const unsigned char byte = *p++;
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool ReadRecord(const unsigned char*& p, const unsigned char* end, std::string& key, SolutionCountCache::Result& result)
+    {
+        uint64_t value;
+        if (!ReadVarint(p, end, value) || value > static_cast<uint64_t>(end - p))
+        {
+            return false;
+        }
+        key.assign(reinterpret_cast<const char*>(p), static_cast<size_t>(value));
+        p += value;
+
+        uint64_t count, stopped, solutionsCount;
+        if (!ReadVarint(p, end, count) || !ReadVarint(p, end, stopped) || !ReadVarint(p, end, solutionsCount) ||
+            solutionsCount > SolutionCountCache::kMaxStoredSolutions)
+        {
+            return false;
+        }
+        result.mCount = static_cast<size_t>(count);
+        result.mStopped = stopped != 0;
+        result.mSolutions.assign(static_cast<size_t>(solutionsCount), {});
+        for (auto& solution : result.mSolutions)
+        {
+            uint64_t length;
+            if (!ReadVarint(p, end, length) || length > static_cast<uint64_t>(end - p))
+            {
+                return false;
+            }
+            solution.resize(static_cast<size_t>(length));
+            for (auto& digit : solution)
+            {
+                if (!ReadVarint(p, end, value))
+                {
+                    return false;
+                }
+                digit = static_cast<unsigned short>(value);
+            }
+        }
+        return true;
+    }
+}
+
+const size_t SolutionCountCache::kDefaultCapacity = 256;
+const size_t SolutionCountCache::kMaxStoredSolutions = 16;
+const int SolutionCountCache::kLockTimeoutMs = 1000;
+
+SolutionCountCache::SolutionCountCache(size_t capacity):
+    mCapacity(capacity),
+    mEntries(),
+    mUsage(),
+    mFilepath()
+{
+}
+
+std::string SolutionCountCache::KeyGet(const PuzzleData &puzzleData, bool useHints)
+{
+    // the solutions do not depend on the numbering of the regions
+    PuzzleData canonical = puzzleData;
+    canonical.mRegions.erase(std::remove_if(canonical.mRegions.begin(), canonical.mRegions.end(),
+                                            [](const CellsInRegion& r) { return r.empty(); }),
+                             canonical.mRegions.end());
+    std::sort(canonical.mRegions.begin(), canonical.mRegions.end());
+    if (!useHints)
+    {
+        canonical.mHints.clear();
+    }
+
+    std::string key;
+    PuzzleCollection::EncodePuzzle(canonical, key);
+    return key;
+}
+
+bool SolutionCountCache::Get(const std::string &key, Result &outResult)
+{
+    auto it = mEntries.find(key);
+    if (it == mEntries.end())
+    {
+        return false;
+    }
+    mUsage.splice(mUsage.begin(), mUsage, it->second.mUsage);
+    outResult = it->second.mResult;
+    return true;
+}
+
+void SolutionCountCache::Store(const std::string &key, Result result)
+{
+    if (result.mSolutions.size() > kMaxStoredSolutions)
+    {
+        result.mSolutions.resize(kMaxStoredSolutions);
+    }
+
+    auto it = mEntries.find(key);
+    if (it != mEntries.end())
+    {
+        const Result& cached = it->second.mResult;
+        const bool betterCount = !cached.mStopped || cached.mCount > result.mCount;
+        const bool moreSolutions = cached.mSolutions.size() >= result.mSolutions.size();
+        if (betterCount && moreSolutions)
+        {
+            // the cached result is already more informative
+            return;
+        }
+        if (betterCount)
+        {
+            result.mCount = cached.mCount;
+            result.mStopped = cached.mStopped;
+        }
+        else if (moreSolutions)
+        {
+            result.mSolutions = cached.mSolutions;
+        }
+    }
+
+    if (!mFilepath.empty())
+    {
+        std::string buffer;
+        EncodeRecord(key, result, buffer);
+        AppendRecords(buffer);
+    }
+    Insert(key, std::move(result));
+}
+
+void SolutionCountCache::Insert(const std::string &key, Result &&result)
+{
+    auto it = mEntries.find(key);
+    if (it != mEntries.end())
+    {
+        mUsage.erase(it->second.mUsage);
+        mEntries.erase(it);
+    }
+    mUsage.push_front(key);
+    mEntries.emplace(key, Entry{std::move(result), mUsage.begin()});
+
+    while (mEntries.size() > mCapacity)
+    {
+        mEntries.erase(mUsage.back());
+        mUsage.pop_back();
+    }
+}
+
+void SolutionCountCache::EncodeRecord(const std::string &key, const Result &result, std::string &outBuffer)
+{
+    WriteVarint(outBuffer, key.size());
+    outBuffer += key;
+    WriteVarint(outBuffer, result.mCount);
+    WriteVarint(outBuffer, result.mStopped ? 1 : 0);
+    WriteVarint(outBuffer, result.mSolutions.size());
+    for (const auto& solution : result.mSolutions)
+    {
+        WriteVarint(outBuffer, solution.size());
+        for (const auto& digit : solution)
+        {
+            WriteVarint(outBuffer, digit);
+        }
+    }
+}
+
+void SolutionCountCache::AppendRecords(const std::string &buffer) const
+{
+    // the record is lost, not the cache, if another instance holds the file
+    QLockFile lock(QString::fromStdString(mFilepath + ".lock"));
+    if (!lock.tryLock(kLockTimeoutMs))
+    {
+        return;
+    }
+    std::ofstream file(mFilepath, std::ios::binary | std::ios::app);
+    file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
+
+bool SolutionCountCache::Open(const std::string &filepath)
+{
+    Close();
+
+    // the other instances only touch the file while holding the lock,
+    // so it can be compacted without losing their records
+    QLockFile lock(QString::fromStdString(filepath + ".lock"));
+    if (!lock.tryLock(kLockTimeoutMs))
+    {
+        return false;
+    }
+
+    // load the records saved so far, a truncated record ends the file
+    {
+        std::ifstream input(filepath, std::ios::binary);
+        if (input)
+        {
+            const std::string data((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+            const unsigned char* p = reinterpret_cast<const unsigned char*>(data.data());
+            const unsigned char* end = p + data.size();
+            std::string key;
+            Result result;
+            while (p != end && ReadRecord(p, end, key, result))
+            {
+                Insert(key, std::move(result));
+            }
+        }
+    }
+
+    // rewrite the entries that are still cached, least recently used first
+    std::string buffer;
+    for (auto it = mUsage.rbegin(); it != mUsage.rend(); ++it)
+    {
+        EncodeRecord(*it, mEntries.at(*it).mResult, buffer);
+    }
+    std::ofstream file(filepath, std::ios::binary | std::ios::trunc);
+    file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    if (!file)
+    {
+        return false;
+    }
+    mFilepath = filepath;
+    return true;
+}
+
+void SolutionCountCache::Close()
+{
+    mFilepath.clear();
+}
@@ -0,0 +1,92 @@
+#ifndef SOLUTION_COUNT_CACHE_H
+#define SOLUTION_COUNT_CACHE_H
+
+#include "puzzledata.h"
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * Cache file layout: a sequence of records, each made of varints
+ *   key length, key bytes, solutions count, stopped flag,
+ *   number of stored solutions, then for each of them its length and digits.
+ * Records are appended as results are stored; a later record for the same key
+ * replaces the earlier ones. The file is compacted every time it is opened.
+ * Several grids, or instances of the application, can share the file: it is only
+ * read or written while holding the lock file "<file>.lock", and never kept open.
+ */
+
+/// <summary>
+/// Remembers the outcome of the brute force searches, so that going back to a puzzle
+/// state seen before (e.g. toggling a given off and on again) does not search again.
+/// Entries are keyed by a canonical encoding of the constraints of the puzzle and
+/// evicted least recently used first. They can optionally be persisted to a file.
+/// </summary>
+class SolutionCountCache
+{
+public:
+    typedef std::vector<unsigned short> Solution;   // digit of each cell
+
+    struct Result
+    {
+        size_t mCount;                      // solutions found
+        bool mStopped;                      // the search stopped at the maximum count
+        std::vector<Solution> mSolutions;   // the first solutions found, at most kMaxStoredSolutions
+    };
+
+    static const size_t kDefaultCapacity;
+    static const size_t kMaxStoredSolutions;
+    static const int kLockTimeoutMs;
+
+private:
+    typedef std::list<std::string> UsageList;
+    struct Entry
+    {
+        Result mResult;
+        UsageList::iterator mUsage;
+    };
+
+    const size_t mCapacity;
+    std::unordered_map<std::string, Entry> mEntries;
+    UsageList mUsage;                       // keys from the most to the least recently used
+    std::string mFilepath;                  // empty if the cache is in memory only
+
+    void Insert(const std::string& key, Result&& result);
+    static void EncodeRecord(const std::string& key, const Result& result, std::string& outBuffer);
+    /// <summary>
+    /// Append records to the file, unless another instance keeps it locked for too long
+    /// </summary>
+    void AppendRecords(const std::string& buffer) const;
+
+public:
+    explicit SolutionCountCache(size_t capacity = kDefaultCapacity);
+    SolutionCountCache(const SolutionCountCache&) = delete;
+    SolutionCountCache& operator=(const SolutionCountCache&) = delete;
+
+    /// <summary>
+    /// Canonical key of the constraints of a puzzle: regions are sorted and
+    /// the hints are only included when they are used as constraints
+    /// </summary>
+    static std::string KeyGet(const PuzzleData& puzzleData, bool useHints);
+
+    /// <summary>
+    /// Result stored for a puzzle, as it was stored. mSolutions may hold fewer solutions than mCount.
+    /// </summary>
+    bool Get(const std::string& key, Result& outResult);
+
+    /// <summary>
+    /// Store the result of a search that has not been aborted. The count and the solutions
+    /// already cached are kept if they are more informative than the new ones.
+    /// </summary>
+    void Store(const std::string& key, Result result);
+
+    /// <summary>
+    /// Load the entries saved in a cache file and append the new ones to it.
+    /// Returns false if the file cannot be locked or written, in which case the cache stays in memory only.
+    /// </summary>
+    bool Open(const std::string& filepath);
+    void Close();
+};
+
+#endif // SOLUTION_COUNT_CACHE_H
@@ -4,12 +4,22 @@ greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
 CONFIG += c++17
 
+# Build with "qmake CONFIG+=trace" to record scoped trace events of the solver
+# and write them as Chrome trace JSON at exit (see solver/Trace.h)
+CONFIG(trace) {
+    DEFINES += SUDOKU_TRACE
+}
+
 # You can make your code fail to compile if it uses deprecated APIs.
 # In order to do so, uncomment the following line.
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
 SOURCES += \
+    IO/BulkPuzzleImporter.cpp \
+    IO/PuzzleCollection.cpp \
     IO/SaveLoadManager.cpp \
+    IO/SessionLog.cpp \
+    IO/SolutionCountCache.cpp \
     adddigitscontextmenu.cpp \
     bruteforcesolverthread.cpp \
     cellcontentbutton.cpp \
@@ -18,12 +28,18 @@ SOURCES += \
     drawregionscontextmenu.cpp \
     editgridcontrols.cpp \
     killercagewidget.cpp \
+    largegridwidget.cpp \
     main.cpp \
     mainwindow.cpp \
     mainwindowcontent.cpp \
     puzzledata.cpp \
+    puzzlegeneratorthread.cpp \
+    solvercommand.cpp \
     savepuzzlethread.cpp \
+    sessionreplayer.cpp \
     solver/BruteForceSolver.cpp \
+    solver/CnfFormula.cpp \
+    solver/ConflictDrivenSolver.cpp \
     solver/FishTechniques.cpp \
     solver/GhostCagesManager.cpp \
     solver/GridProgressManager.cpp \
@@ -31,16 +47,28 @@ SOURCES += \
     solver/LockedCandidates.cpp \
     solver/NakedSubsets.cpp \
     solver/Progress.cpp \
+    solver/ProgressPool.cpp \
+    solver/PuzzleGenerator.cpp \
+    solver/PuzzleGrader.cpp \
+    solver/PuzzleLoader.cpp \
+    solver/PuzzleSolutionCounter.cpp \
+    solver/ReversibleSparseBitSet.cpp \
     solver/RandomGuessTreeNode.cpp \
     solver/Region.cpp \
+    solver/RegionArena.cpp \
     solver/RegionUpdatesManager.cpp \
     solver/RegionsManager.cpp \
     solver/Scanning.cpp \
+    solver/SolverKernels.cpp \
     solver/SolvingTechnique.cpp \
     solver/SudokuCell.cpp \
     solver/SudokuGrid.cpp \
     solver/SudokuParser.cpp \
+    solver/Trace.cpp \
+    solver/TranspositionTable.cpp \
+    solver/TrueCandidatesFinder.cpp \
     solver/VariantConstraints.cpp \
+    solver/WorkerPool.cpp \
     solvercontextmenu.cpp \
     solvercontrols.cpp \
     startmenu.cpp \
@@ -49,11 +77,17 @@ SOURCES += \
     sudokusolverthread.cpp \
     thirdparty/dancing_links.cpp \
     thirdparty/linked_matrix.cpp \
+    truecandidatesthread.cpp \
+    uniquenessmonitorthread.cpp \
     variantclueslayer.cpp \
     variantcluewidget.cpp
 
 HEADERS += \
+    IO/BulkPuzzleImporter.h \
+    IO/PuzzleCollection.h \
     IO/SaveLoadManager.h \
+    IO/SessionLog.h \
+    IO/SolutionCountCache.h \
     adddigitscontextmenu.h \
     bruteforcesolverthread.h \
     cellcontentbutton.h \
@@ -62,26 +96,49 @@ HEADERS += \
     drawregionscontextmenu.h \
     editgridcontrols.h \
     killercagewidget.h \
+    largegridwidget.h \
     mainwindow.h \
     mainwindowcontent.h \
     puzzledata.h \
+    puzzlegeneratorthread.h \
+    solvercommand.h \
+    spscqueue.h \
     savepuzzlethread.h \
+    sessionreplayer.h \
     solver/BruteForceSolver.h \
+    solver/CandidateMask.h \
+    solver/CellMask.h \
+    solver/CnfFormula.h \
+    solver/ConflictDrivenSolver.h \
     solver/GhostCagesManager.h \
     solver/GridProgressManager.h \
+    solver/IdSpan.h \
     solver/Progress.h \
+    solver/ProgressPool.h \
     solver/ProgressTypes.h \
+    solver/PuzzleGenerator.h \
+    solver/PuzzleGrader.h \
+    solver/PuzzleLoader.h \
+    solver/PuzzleSolutionCounter.h \
+    solver/ReversibleSparseBitSet.h \
     solver/RandomGuessTreeNode.h \
     solver/Region.h \
+    solver/RegionArena.h \
     solver/RegionUpdatesManager.h \
     solver/RegionsManager.h \
     solver/Scanning.h \
+    solver/SolverKernels.h \
+    solver/SolverObserver.h \
     solver/SolvingTechnique.h \
     solver/SudokuCell.h \
     solver/SudokuGrid.h \
     solver/SudokuParser.h \
+    solver/Trace.h \
+    solver/TranspositionTable.h \
+    solver/TrueCandidatesFinder.h \
     solver/Types.h \
     solver/VariantConstraints.h \
+    solver/WorkerPool.h \
     solvercontextmenu.h \
     solvercontrols.h \
     startmenu.h \
@@ -90,6 +147,8 @@ HEADERS += \
     sudokusolverthread.h \
     thirdparty/dancing_links.h \
     thirdparty/linked_matrix.h \
+    truecandidatesthread.h \
+    uniquenessmonitorthread.h \
     variantclueslayer.h \
     variantcluewidget.h
 
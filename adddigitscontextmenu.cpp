@@ -145,10 +145,8 @@ void AddDigitsContextMenu::CellClicked(SudokuCellWidget *cell)
 
 void AddDigitsContextMenu::KeyboardInput(SudokuCellWidget *cell, QKeyEvent *event)
 {
-    bool ok;
-    int num = event->text().toInt(&ok);
-
-    if(ok && num > 0 && num <= mGrid->SizeGet())
+    int num;
+    if(TypedNumberGet(cell, event, mGrid->SizeGet(), num) && num > 0)
     {
         cell->SetGivenDigit(static_cast<unsigned short>(num));
     }
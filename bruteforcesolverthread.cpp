@@ -1,16 +1,25 @@
 #include "bruteforcesolverthread.h"
 #include "solver/BruteForceSolver.h"
+#include "solver/PuzzleLoader.h"
+#include "solver/SolverKernels.h"
 #include <QDebug>
+#include <QDir>
+#include <QStandardPaths>
+#include <fstream>
 
 BruteForceSolverThread::BruteForceSolverThread(QObject *parent)
     : QThread{parent}
     , mGrid(nullptr)
     , mMaxSolutionsCount(0)
     , mUseHints(false)
+    , mSearchEngine(BruteForceSolver::SearchEngine::DancingLinks)
     , mDisplaySolution(false)
     , mAbort(false)
     , mInputMutex()
     , mSolverMutex(nullptr)
+    , mSolutionsCache()
+    , mPuzzleData(nullptr)
+    , mSessionLog(nullptr)
 {
 }
 
@@ -22,11 +31,18 @@ BruteForceSolverThread::~BruteForceSolverThread()
     wait();
 }
 
-void BruteForceSolverThread::Init(SudokuGrid* grid, QMutex* solverMutex)
+void BruteForceSolverThread::Init(SudokuGrid* grid, QMutex* solverMutex, bool persistentCache /* = true */)
 {
     mBruteForceSolver = std::make_unique<BruteForceSolver>(this, grid, &mAbort);
     mSolverMutex = solverMutex;
     mGrid = grid;
+
+    // keep the counts across sessions, if there is somewhere to save them
+    const QString cacheDir = persistentCache ? QStandardPaths::writableLocation(QStandardPaths::CacheLocation) : QString();
+    if(!cacheDir.isEmpty() && QDir().mkpath(cacheDir))
+    {
+        mSolutionsCache.Open(QDir(cacheDir).filePath("solutions.cache").toStdString());
+    }
 }
 
 void BruteForceSolverThread::run()
@@ -34,10 +50,13 @@ void BruteForceSolverThread::run()
     mInputMutex.lock();
     size_t maxSolutionCount = mMaxSolutionsCount;
     bool useHints = mUseHints;
+    BruteForceSolver::SearchEngine searchEngine = mSearchEngine;
     bool displaySolution = mDisplaySolution;
     mInputMutex.unlock();
 
     mSolverMutex->lock();
+    mBruteForceSolver->SearchEngineSet(searchEngine);
+    mBruteForceSolver->SolutionsCacheSet(&mSolutionsCache, mPuzzleData ? SolutionCountCache::KeyGet(*mPuzzleData, useHints) : "");
     mBruteForceSolver->GenerateIncidenceMatrix(useHints);
     mSolverMutex->unlock();
     emit CalculationStarted();
@@ -50,11 +69,6 @@ void BruteForceSolverThread::run()
         mBruteForceSolver->CountSolutions(maxSolutionCount);
     }
     emit CalculationFinished();
-
-    if(mAbort)
-    {
-        NotifyGridChanged();
-    }
 }
 
 void BruteForceSolverThread::CountSolutions(size_t maxSolutionCount, bool useHints)
@@ -62,6 +76,10 @@ void BruteForceSolverThread::CountSolutions(size_t maxSolutionCount, bool useHin
     if(!isRunning())
     {
         QMutexLocker locker(&mInputMutex);
+        if(mSessionLog)
+        {
+            mSessionLog->RecordCountSolutions(maxSolutionCount, useHints);
+        }
         mAbort = false;
         mDisplaySolution = false;
         mMaxSolutionsCount = maxSolutionCount;
@@ -75,6 +93,10 @@ void BruteForceSolverThread::DisplaySolution(size_t maxSolutionCount, bool useHi
     if(!isRunning())
     {
         QMutexLocker locker(&mInputMutex);
+        if(mSessionLog)
+        {
+            mSessionLog->RecordDisplaySolution(maxSolutionCount, useHints);
+        }
         mAbort = false;
         mDisplaySolution = true;
         mMaxSolutionsCount = maxSolutionCount;
@@ -88,15 +110,57 @@ void BruteForceSolverThread::AbortCalculation()
     if(isRunning())
     {
         QMutexLocker locker(&mInputMutex);
+        if(mSessionLog && !mAbort)
+        {
+            mSessionLog->RecordAbortBruteForce();
+        }
         mAbort = true;
     }
 }
 
+void BruteForceSolverThread::SearchEngineSet(BruteForceSolver::SearchEngine engine)
+{
+    QMutexLocker locker(&mInputMutex);
+    if(mSessionLog && engine != mSearchEngine)
+    {
+        mSessionLog->RecordSearchEngine(static_cast<unsigned int>(engine));
+    }
+    mSearchEngine = engine;
+}
+
+void BruteForceSolverThread::SessionLogSet(SessionLog* sessionLog)
+{
+    QMutexLocker locker(&mInputMutex);
+    mSessionLog = sessionLog;
+}
+
+bool BruteForceSolverThread::ExportDimacs(const PuzzleData& puzzleData, const QString& path, bool useHints)
+{
+    std::ofstream file(path.toStdString(), std::ios::trunc);
+    if(!file.is_open())
+    {
+        return false;
+    }
+
+    // loaded on a grid of its own: the one of the logical solver can only be read under the solver mutex
+    SudokuGrid grid(puzzleData.mSize, nullptr, SolverKernelsGet(puzzleData.mSize));
+    PuzzleLoader(grid, puzzleData).LoadAll();
+    std::atomic<bool> abort(false);
+    BruteForceSolver(this, &grid, &abort).WriteDimacs(file, useHints);
+    return file.good();
+}
+
 void BruteForceSolverThread::NotifyGridChanged()
 {
     mBruteForceSolver->DirtySolutions();
 }
 
+void BruteForceSolverThread::NotifyGridChanged(const PuzzleData &puzzleData)
+{
+    mPuzzleData = std::make_unique<PuzzleData>(puzzleData);
+    NotifyGridChanged();
+}
+
 void BruteForceSolverThread::NotifySolutionsCountReady(size_t count, bool stopped)
 {
     emit NumberOfSolutionsComputed(count, stopped);
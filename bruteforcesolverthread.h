@@ -3,8 +3,12 @@
 
 #include <QThread>
 #include <QMutex>
+#include <atomic>
 #include "solver/SudokuGrid.h"
 #include "solver/BruteForceSolver.h"
+#include "IO/SessionLog.h"
+#include "IO/SolutionCountCache.h"
+#include "puzzledata.h"
 
 class BruteForceSolverThread : public QThread
 {
@@ -13,7 +17,10 @@ public:
     explicit BruteForceSolverThread(QObject *parent = nullptr);
     ~BruteForceSolverThread();
 
-    void Init(SudokuGrid* grid, QMutex* solverMutex);
+    /// <summary>
+    /// With persistentCache, the solution counts are also kept in a file across sessions
+    /// </summary>
+    void Init(SudokuGrid* grid, QMutex* solverMutex, bool persistentCache = true);
 
 signals:
     void CalculationStarted();
@@ -30,16 +37,35 @@ private:
 
     size_t mMaxSolutionsCount;
     bool mUseHints;
+    BruteForceSolver::SearchEngine mSearchEngine;
     bool mDisplaySolution;
-    bool mAbort;
+    std::atomic<bool> mAbort;
     QMutex mInputMutex;
     QMutex* mSolverMutex;
 
+    SolutionCountCache mSolutionsCache;
+    std::unique_ptr<PuzzleData> mPuzzleData;    // constraints of the grid, guarded by mSolverMutex
+    SessionLog* mSessionLog;                    // records the requests, if not null
+
 public:
     void CountSolutions(size_t maxSolutionCount, bool useHints);
     void DisplaySolution(size_t maxSolutionCount, bool useHints);
     void AbortCalculation();
+    /// <summary>
+    /// Engine used by the next calculations
+    /// </summary>
+    void SearchEngineSet(BruteForceSolver::SearchEngine engine);
+    void SessionLogSet(SessionLog* sessionLog);
+    /// <summary>
+    /// Save the constraints of the puzzle as a DIMACS formula. Returns false if the file could not be written.
+    /// The formula is built on a grid of its own, so the solvers keep running meanwhile
+    /// </summary>
+    bool ExportDimacs(const PuzzleData& puzzleData, const QString& path, bool useHints);
     void NotifyGridChanged();
+    /// <summary>
+    /// Must be called with the solver mutex locked, together with the changes to the grid
+    /// </summary>
+    void NotifyGridChanged(const PuzzleData& puzzleData);
 
     void NotifySolutionsCountReady(size_t count, bool stopped);
     void NotifySolutionReady(const std::vector<unsigned short>& solution);
@@ -1,11 +1,43 @@
 #include "contextmenuwindow.h"
 #include "qglobal.h"
+#include <QApplication>
+#include <QKeyEvent>
 
 ContextMenuWindow::ContextMenuWindow(MainWindowContent* mainWindowContent):
-    mMainWindowContent(mainWindowContent)
+    mMainWindowContent(mainWindowContent),
+    mTypingCell(nullptr),
+    mTypedNumber(0),
+    mTypingTimer()
 {
 }
 
+bool ContextMenuWindow::TypedNumberGet(const SudokuCellWidget *cell, const QKeyEvent *event, int maxNumber, int &outNumber)
+{
+    bool ok;
+    const int digit = event->text().toInt(&ok);
+    if(!ok || digit < 0 || digit > 9)
+    {
+        mTypingCell = nullptr;
+        return false;
+    }
+
+    // same delay as the keyboard search of the item views
+    const bool continued = cell == mTypingCell && mTypingTimer.isValid() &&
+                           mTypingTimer.elapsed() < QApplication::keyboardInputInterval();
+    if(continued && mTypedNumber * 10 + digit <= maxNumber)
+    {
+        mTypedNumber = mTypedNumber * 10 + digit;
+    }
+    else
+    {
+        mTypedNumber = digit;
+    }
+    mTypingCell = cell;
+    mTypingTimer.start();
+    outNumber = mTypedNumber;
+    return true;
+}
+
 void ContextMenuWindow::ClueAdded(QWidget *clue)
 {
     Q_UNUSED(clue)
@@ -1,6 +1,8 @@
 #ifndef CONTEXTMENUWINDOW_H
 #define CONTEXTMENUWINDOW_H
 
+#include <QElapsedTimer>
+
 class SudokuCellWidget;
 class MainWindowContent;
 class QKeyEvent;
@@ -11,6 +13,18 @@ class ContextMenuWindow
 protected:
     MainWindowContent* mMainWindowContent;
 
+    /// <summary>
+    /// Read the number typed on a cell. Digits typed in quick succession on the same cell
+    /// make up a single number, as long as it does not exceed maxNumber, so that values
+    /// above 9 can be entered. Returns false if the key is not a digit.
+    /// </summary>
+    bool TypedNumberGet(const SudokuCellWidget* cell, const QKeyEvent* event, int maxNumber, int& outNumber);
+
+private:
+    const SudokuCellWidget* mTypingCell;    // cell of the last digit typed
+    int mTypedNumber;
+    QElapsedTimer mTypingTimer;             // since the last digit typed
+
 public:
     ContextMenuWindow(MainWindowContent* mainWindowContent);
 
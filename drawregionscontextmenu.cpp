@@ -232,10 +232,8 @@ void DrawRegionsContextMenu::CellClicked(SudokuCellWidget *cell)
 
 void DrawRegionsContextMenu::KeyboardInput(SudokuCellWidget *cell, QKeyEvent *event)
 {
-    bool ok;
-    int num = event->text().toInt(&ok);
-
-    if(ok && num >= 0 && num <= mGrid->SizeGet())
+    int num;
+    if(TypedNumberGet(cell, event, mGrid->SizeGet(), num))
     {
         if(cell->RegionIdGet() == num)
         {
@@ -2,6 +2,8 @@
 #include "sudokugridwidget.h"
 #include "mainwindowcontent.h"
 #include "sudokusolverthread.h"
+#include "sudokucellwidget.h"
+#include "puzzlegeneratorthread.h"
 #include <QVBoxLayout>
 #include <QFormLayout>
 #include <QFrame>
@@ -15,7 +17,11 @@ EditGridControls::EditGridControls(MainWindowContent* mainWindowContent, const P
       mDrawRegionsBtn(new QPushButton("Regions")),
       mDrawKillersBtn(new QPushButton("Killer Cages")),
       mPositiveDiagonalCheckbox(new QCheckBox("Positive diagonal constraint")),
-      mNegativeDiagonalCheckbox(new QCheckBox("Negative diagonal constraint"))
+      mNegativeDiagonalCheckbox(new QCheckBox("Negative diagonal constraint")),
+      mGeneratePuzzleBtn(new QPushButton("Generate Givens")),
+      mMinimisePuzzleBtn(new QPushButton("Minimise Givens")),
+      mAbortGenerationBtn(new QPushButton("Abort Generation")),
+      mGenerator(new PuzzleGeneratorThread(this))
 {
     // build the layout
     QVBoxLayout* verticalLayout = new QVBoxLayout(this);
@@ -36,6 +42,12 @@ EditGridControls::EditGridControls(MainWindowContent* mainWindowContent, const P
     verticalLayout->addWidget(line);
     verticalLayout->addWidget(mPositiveDiagonalCheckbox);
     verticalLayout->addWidget(mNegativeDiagonalCheckbox);
+    line = new QFrame();
+    line->setFrameStyle(QFrame::HLine | QFrame::Sunken);
+    verticalLayout->addWidget(line);
+    verticalLayout->addWidget(mGeneratePuzzleBtn);
+    verticalLayout->addWidget(mMinimisePuzzleBtn);
+    verticalLayout->addWidget(mAbortGenerationBtn);
     verticalLayout->addStretch();
 
     // buttons mode
@@ -43,11 +55,17 @@ EditGridControls::EditGridControls(MainWindowContent* mainWindowContent, const P
     mAddDigitsBtn->setChecked(true);
     mDrawRegionsBtn->setCheckable(true);
     mDrawKillersBtn->setCheckable(true);
+    mAbortGenerationBtn->setEnabled(false);
 
     // events
     connect(mButtonsGroup, SIGNAL(idClicked(int)), this, SLOT(ViewButtonClicked(int)));
     connect(mPositiveDiagonalCheckbox, SIGNAL(stateChanged(int)), this, SLOT(PositiveDiagonalCheckbox_OnChange(int)));
     connect(mNegativeDiagonalCheckbox, SIGNAL(stateChanged(int)), this, SLOT(NegativeDiagonalCheckbox_OnChange(int)));
+    connect(mGeneratePuzzleBtn, SIGNAL(clicked(bool)), this, SLOT(GeneratePuzzleBtn_Clicked()));
+    connect(mMinimisePuzzleBtn, SIGNAL(clicked(bool)), this, SLOT(MinimisePuzzleBtn_Clicked()));
+    connect(mAbortGenerationBtn, SIGNAL(clicked(bool)), this, SLOT(AbortGenerationBtn_Clicked()));
+    connect(mGenerator, SIGNAL(GenerationStarted()), this, SLOT(OnGenerationStarted()));
+    connect(mGenerator, SIGNAL(GenerationFinished(bool)), this, SLOT(OnGenerationFinished(bool)));
 
     // loaded puzzle
     if(loadedGrid)
@@ -76,6 +94,59 @@ void EditGridControls::NegativeDiagonalCheckbox_OnChange(int checked)
     mMainWindowContent->GridGet()->update();
 }
 
+void EditGridControls::GeneratePuzzleBtn_Clicked()
+{
+    mGenerator->GeneratePuzzle(mMainWindowContent->GridGet()->SolverGet()->PuzzleDataGet());
+}
+
+void EditGridControls::MinimisePuzzleBtn_Clicked()
+{
+    mGenerator->MinimisePuzzle(mMainWindowContent->GridGet()->SolverGet()->PuzzleDataGet());
+}
+
+void EditGridControls::AbortGenerationBtn_Clicked()
+{
+    mGenerator->AbortGeneration();
+}
+
+void EditGridControls::OnGenerationStarted()
+{
+    mGeneratePuzzleBtn->setEnabled(false);
+    mMinimisePuzzleBtn->setEnabled(false);
+    mAbortGenerationBtn->setEnabled(true);
+}
+
+void EditGridControls::OnGenerationFinished(bool success)
+{
+    mGeneratePuzzleBtn->setEnabled(true);
+    mMinimisePuzzleBtn->setEnabled(true);
+    mAbortGenerationBtn->setEnabled(false);
+    if(!success)
+    {
+        return;
+    }
+
+    // replace the givens in the grid with the generated ones
+    SudokuGridWidget* grid = mMainWindowContent->GridGet();
+    const PuzzleData puzzleData = grid->SolverGet()->PuzzleDataGet();
+    const PuzzleGenerator::Givens givens = mGenerator->GivensGet();
+    for (const auto& g : puzzleData.mGivens)
+    {
+        if(givens.count(g.first) == 0)
+        {
+            grid->CellGet(g.first)->RemoveGivenDigit();
+        }
+    }
+    for (const auto& g : givens)
+    {
+        auto it = puzzleData.mGivens.find(g.first);
+        if(it == puzzleData.mGivens.end() || it->second != g.second)
+        {
+            grid->CellGet(g.first)->SetGivenDigit(g.second);
+        }
+    }
+}
+
 int EditGridControls::SelectedButtonIdGet() const
 {
     return mButtonsGroup->checkedId();
@@ -7,6 +7,7 @@
 
 class MainWindowContent;
 class PuzzleData;
+class PuzzleGeneratorThread;
 
 class EditGridControls : public QWidget
 {
@@ -24,6 +25,10 @@ private:
     QPushButton* mDrawKillersBtn;
     QCheckBox* mPositiveDiagonalCheckbox;
     QCheckBox* mNegativeDiagonalCheckbox;
+    QPushButton* mGeneratePuzzleBtn;
+    QPushButton* mMinimisePuzzleBtn;
+    QPushButton* mAbortGenerationBtn;
+    PuzzleGeneratorThread* mGenerator;
 
     void OnViewButtonChecked(QPushButton* btn);
 
@@ -31,6 +36,11 @@ private slots:
     void ViewButtonClicked(int btnId);
     void PositiveDiagonalCheckbox_OnChange(int checked);
     void NegativeDiagonalCheckbox_OnChange(int checked);
+    void GeneratePuzzleBtn_Clicked();
+    void MinimisePuzzleBtn_Clicked();
+    void AbortGenerationBtn_Clicked();
+    void OnGenerationStarted();
+    void OnGenerationFinished(bool success);
 
 public:
     int SelectedButtonIdGet() const;
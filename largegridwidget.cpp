@@ -0,0 +1,132 @@
+#include "largegridwidget.h"
+#include "sudokugridwidget.h"
+#include "sudokucellwidget.h"
+#include "contextmenuwindow.h"
+#include "mainwindowcontent.h"
+#include <QPainter>
+#include <QPaintEvent>
+#include <QMouseEvent>
+#include <QKeyEvent>
+
+LargeGridWidget::LargeGridWidget(SudokuGridWidget* grid, MainWindowContent* mainWindowContent, QWidget *parent)
+    : QWidget{parent},
+      mGrid(grid),
+      mMainWindowContent(mainWindowContent),
+      mFocusedCell(nullptr)
+{
+    this->setFocusPolicy(Qt::FocusPolicy::ClickFocus);
+    this->setSizePolicy(QSizePolicy(QSizePolicy::Policy::Fixed,QSizePolicy::Policy::Fixed));
+}
+
+QSize LargeGridWidget::sizeHint() const
+{
+    const int length = mGrid->SizeGet() * mGrid->CellLengthGet();
+    return QSize(length, length);
+}
+
+QSize LargeGridWidget::minimumSizeHint() const
+{
+    return sizeHint();
+}
+
+void LargeGridWidget::paintEvent(QPaintEvent *event)
+{
+    QPainter painter(this);
+    const QRect& dirty = event->rect();
+    const int length = mGrid->CellLengthGet();
+    const int size = mGrid->SizeGet();
+
+    // only the cells in the updated area, with a margin for the bold edges of their neighbours
+    const int firstRow = qMax(0, (dirty.top() - 2) / length);
+    const int lastRow = qMin(size - 1, (dirty.bottom() + 2) / length);
+    const int firstCol = qMax(0, (dirty.left() - 2) / length);
+    const int lastCol = qMin(size - 1, (dirty.right() + 2) / length);
+
+    // content first, so that the edges are drawn over the backgrounds of both cells they separate
+    const auto& cells = mGrid->CellsGet();
+    for(int row = firstRow; row <= lastRow; ++row)
+    {
+        for(int col = firstCol; col <= lastCol; ++col)
+        {
+            cells[row][col]->PaintContent(painter, cells[row][col] == mFocusedCell);
+        }
+    }
+    for(int row = firstRow; row <= lastRow; ++row)
+    {
+        for(int col = firstCol; col <= lastCol; ++col)
+        {
+            cells[row][col]->PaintEdges(painter);
+        }
+    }
+}
+
+void LargeGridWidget::mousePressEvent(QMouseEvent *event)
+{
+    QWidget::mousePressEvent(event);
+    FocusedCellSet(CellAtGet(event->pos()));
+}
+
+void LargeGridWidget::mouseReleaseEvent(QMouseEvent *event)
+{
+    QWidget::mouseReleaseEvent(event);
+
+    SudokuCellWidget* cell = CellAtGet(event->pos());
+    if(this->hasFocus() && cell && cell == mFocusedCell)
+    {
+        mMainWindowContent->ActiveContextMenuGet()->CellClicked(cell);
+    }
+}
+
+void LargeGridWidget::keyReleaseEvent(QKeyEvent *event)
+{
+    QWidget::keyReleaseEvent(event);
+    if(mFocusedCell)
+    {
+        mMainWindowContent->ActiveContextMenuGet()->KeyboardInput(mFocusedCell, event);
+    }
+}
+
+void LargeGridWidget::focusOutEvent(QFocusEvent *event)
+{
+    QWidget::focusOutEvent(event);
+    FocusedCellSet(nullptr);
+}
+
+SudokuCellWidget *LargeGridWidget::CellAtGet(const QPoint &pos) const
+{
+    const int length = mGrid->CellLengthGet();
+    if(pos.x() < 0 || pos.y() < 0)
+    {
+        return nullptr;
+    }
+    const int row = pos.y() / length;
+    const int col = pos.x() / length;
+    if(row >= mGrid->SizeGet() || col >= mGrid->SizeGet())
+    {
+        return nullptr;
+    }
+    return mGrid->CellsGet()[row][col];
+}
+
+void LargeGridWidget::FocusedCellSet(SudokuCellWidget *cell)
+{
+    if(cell == mFocusedCell)
+    {
+        return;
+    }
+
+    // same sequence as the labels of separate cell widgets: the old cell loses the focus, then the new one gains it
+    const int length = mGrid->CellLengthGet();
+    if(SudokuCellWidget* previous = mFocusedCell; previous)
+    {
+        mFocusedCell = nullptr;
+        update(previous->ColGet() * length, previous->RowGet() * length, length, length);
+        mMainWindowContent->ActiveContextMenuGet()->CellLostFocus(previous);
+    }
+    if(cell)
+    {
+        mFocusedCell = cell;
+        update(cell->ColGet() * length, cell->RowGet() * length, length, length);
+        mMainWindowContent->ActiveContextMenuGet()->CellGainedFocus(cell);
+    }
+}
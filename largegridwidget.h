@@ -0,0 +1,40 @@
+#ifndef LARGEGRIDWIDGET_H
+#define LARGEGRIDWIDGET_H
+
+#include <QWidget>
+
+class SudokuGridWidget;
+class SudokuCellWidget;
+class MainWindowContent;
+
+/// Paints all the cells of a large grid, instead of giving each cell its own child widgets.
+/// The cells are painted SudokuCellWidget instances that only keep their state;
+/// clicks, keys and focus are passed on to the active context menu with the cell they are about.
+class LargeGridWidget : public QWidget
+{
+    Q_OBJECT
+public:
+    explicit LargeGridWidget(SudokuGridWidget* grid, MainWindowContent* mainWindowContent, QWidget *parent = nullptr);
+
+private:
+    SudokuGridWidget* mGrid;
+    MainWindowContent* mMainWindowContent;
+    SudokuCellWidget* mFocusedCell;
+
+    // base class overrides
+    QSize sizeHint() const override;
+    QSize minimumSizeHint() const override;
+    void paintEvent(QPaintEvent* event) override;
+    void mousePressEvent(QMouseEvent* event) override;
+    void mouseReleaseEvent(QMouseEvent* event) override;
+    void keyReleaseEvent(QKeyEvent* event) override;
+    void focusOutEvent(QFocusEvent* event) override;
+
+    // private const functions
+    SudokuCellWidget* CellAtGet(const QPoint& pos) const;
+
+    // private non-const functions
+    void FocusedCellSet(SudokuCellWidget* cell);
+};
+
+#endif // LARGEGRIDWIDGET_H
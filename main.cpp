@@ -1,10 +1,130 @@
 //#include "mainwindow.h"
 #include "startmenu.h"
+#include "sessionreplayer.h"
+#include "IO/BulkPuzzleImporter.h"
+#include "IO/PuzzleCollection.h"
+#include "solver/PuzzleGrader.h"
 
 #include <QApplication>
+#include <QFileInfo>
+#include <iostream>
+
+namespace
+{
+    // puzzles decoded and graded at a time, so that large collections are not loaded whole
+    const size_t kGradeBatchSize = 1024;
+
+    const char* TechniqueNameGet(TechniqueType type)
+    {
+        switch (type)
+        {
+        case TechniqueType::LockedCandidates:   return "LockedCandidates";
+        case TechniqueType::NakedSubset:        return "NakedSubset";
+        case TechniqueType::HiddenSubset:       return "HiddenSubset";
+        case TechniqueType::Fish:               return "Fish";
+        case TechniqueType::InniesOuties:       return "InniesOuties";
+        case TechniqueType::Bifurcation:        return "Bifurcation";
+        default:                                return "Singles";
+        }
+    }
+
+    // one line per puzzle: number in the collection, score, hardest technique and outcome
+    void WriteGrades(std::ostream& stream, const std::vector<size_t>& numbers, const std::vector<GradeResult>& results)
+    {
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            const GradeResult& r = results[i];
+            stream << numbers[i] << '\t' << r.mScore << '\t' << TechniqueNameGet(r.mHardestTechnique) << '\t'
+                   << (r.mImpossible ? "impossible" : (r.mSolved ? "solved" : "unsolved")) << '\n';
+        }
+        stream.flush();
+    }
+
+    // grade a binary puzzle collection, or a one-line text collection
+    int GradeCollection(const std::string& filepath)
+    {
+        PuzzleGrader grader;
+        std::vector<PuzzleData> puzzles;
+        std::vector<size_t> numbers;
+        auto gradeBatch = [&]()
+        {
+            WriteGrades(std::cout, numbers, grader.Grade(puzzles));
+            puzzles.clear();
+            numbers.clear();
+        };
+
+        if (QFileInfo(QString::fromStdString(filepath)).suffix() == PuzzleCollection::kFileExtension)
+        {
+            PuzzleCollection collection;
+            if (!collection.Open(filepath))
+            {
+                std::cerr << "Cannot open the puzzle collection " << filepath << std::endl;
+                return 1;
+            }
+            for (size_t i = 0; i < collection.CountGet(); ++i)
+            {
+                std::unique_ptr<PuzzleData> puzzleData;
+                if (!collection.LoadPuzzle(i, puzzleData))
+                {
+                    std::cerr << "Cannot read puzzle " << i + 1 << std::endl;
+                    continue;
+                }
+                puzzles.push_back(std::move(*puzzleData));
+                numbers.push_back(i + 1);
+                if (puzzles.size() == kGradeBatchSize)
+                {
+                    gradeBatch();
+                }
+            }
+        }
+        else
+        {
+            BulkPuzzleImporter importer;
+            bool imported = importer.Import(filepath, [&](std::unique_ptr<PuzzleData> puzzleData, const std::string&, size_t lineNumber)
+            {
+                puzzles.push_back(std::move(*puzzleData));
+                numbers.push_back(lineNumber);
+                if (puzzles.size() == kGradeBatchSize)
+                {
+                    gradeBatch();
+                }
+                return true;
+            });
+            if (!imported)
+            {
+                std::cerr << "Cannot read the puzzles in " << filepath << std::endl;
+                return 1;
+            }
+        }
+        gradeBatch();
+        return 0;
+    }
+}
 
 int main(int argc, char *argv[])
 {
+    // "--replay <session log>" replays a recorded session without opening any window
+    if(argc == 3 && QString(argv[1]) == "--replay")
+    {
+        QCoreApplication a(argc, argv);
+        SessionLog log(0);
+        if(!log.Load(argv[2]))
+        {
+            std::cerr << "Cannot read the session log " << argv[2] << std::endl;
+            return 1;
+        }
+        SessionReplayer replayer(log);
+        replayer.Replay();
+        replayer.WriteReport(std::cout);
+        return 0;
+    }
+    // "--grade <puzzle collection>" rates every puzzle of a binary or one-line collection
+    if(argc == 3 && QString(argv[1]) == "--grade")
+    {
+        QCoreApplication a(argc, argv);
+        return GradeCollection(argv[2]);
+    }
+
     QApplication a(argc, argv);
     //MainWindow w(9);
     //w.show();
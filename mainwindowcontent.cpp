@@ -7,12 +7,17 @@
 #include "drawregionscontextmenu.h"
 #include "solvercontrols.h"
 #include "solvercontextmenu.h"
+#include "sudokusolverthread.h"
 #include <QFrame>
 #include <QHBoxLayout>
 #include <QTabWidget>
 #include <QStackedLayout>
 
 constexpr char kNoSolutionMessage[] = "NO SOLUTION!";
+constexpr char kUniquenessCheckingStr[] = "Checking uniqueness...";
+constexpr char kUniqueSolutionStr[] = "Unique solution";
+constexpr char kMultipleSolutionsStr[] = "Multiple solutions";
+constexpr char kNoSolutionsStr[] = "No solution";
 
 MainWindowContent::MainWindowContent(unsigned short size, MainWindow *parent, std::unique_ptr<PuzzleData> loadedGrid)
     : QWidget{parent},
@@ -20,6 +25,7 @@ MainWindowContent::MainWindowContent(unsigned short size, MainWindow *parent, st
       mControlsMenu(new QTabWidget()),
       mContextMenu(new QStackedLayout()),
       mImpossiblePuzzleLabel(new QLabel()),
+      mUniquenessLabel(new QLabel()),
       mGrid(new SudokuGridWidget(size, this)),
       mCurrentView(ContextMenuType::EnterDigits_Context)
 {
@@ -33,6 +39,7 @@ MainWindowContent::MainWindowContent(unsigned short size, MainWindow *parent, st
     gridContainerLayout->addStretch();
     gridContainerLayout->addWidget(mImpossiblePuzzleLabel);
     gridContainerLayout->addWidget(mGrid);
+    gridContainerLayout->addWidget(mUniquenessLabel);
     gridContainerLayout->addStretch();
     horizontalLayout->addWidget(mControlsMenu);
     horizontalLayout->addWidget(gridContainer);
@@ -66,6 +73,7 @@ MainWindowContent::MainWindowContent(unsigned short size, MainWindow *parent, st
     mImpossiblePuzzleLabel->setFont(QFont("Segoe UI", 20, 500));
     mImpossiblePuzzleLabel->setAlignment(Qt::AlignCenter);
     mImpossiblePuzzleLabel->setStyleSheet("QLabel{color: red;}");
+    mUniquenessLabel->setAlignment(Qt::AlignCenter);
 
     // focus policy
     this->setFocusPolicy(Qt::FocusPolicy::ClickFocus);
@@ -74,6 +82,7 @@ MainWindowContent::MainWindowContent(unsigned short size, MainWindow *parent, st
     connect(mControlsMenu, SIGNAL(currentChanged(int)), this, SLOT(OnTabChanged_ControlsMenu(int)));
     connect(mGrid->SolverGet(), SIGNAL(SolverHasBeenReset()), this, SLOT(OnLogicalSolverReset()));
     connect(mGrid->SolverGet(), SIGNAL(PuzzleHasNoSolution(QString)), this, SLOT(OnPuzzleBroken()));
+    connect(mGrid->SolverGet()->UniquenessMonitorGet(), SIGNAL(UniquenessChecked(int)), this, SLOT(OnUniquenessChecked(int)));
 }
 
 void MainWindowContent::OnTabChanged_ControlsMenu(int tab)
@@ -99,6 +108,28 @@ void MainWindowContent::OnLogicalSolverReset()
     mImpossiblePuzzleLabel->setText(QString());
 }
 
+void MainWindowContent::OnUniquenessChecked(int status)
+{
+    switch (status)
+    {
+    case UniquenessMonitorThread::Status_Checking:
+        mUniquenessLabel->setText(kUniquenessCheckingStr);
+        break;
+    case UniquenessMonitorThread::Status_Unique:
+        mUniquenessLabel->setText(kUniqueSolutionStr);
+        break;
+    case UniquenessMonitorThread::Status_Multiple:
+        mUniquenessLabel->setText(kMultipleSolutionsStr);
+        break;
+    case UniquenessMonitorThread::Status_NoSolution:
+        mUniquenessLabel->setText(kNoSolutionsStr);
+        break;
+    default:
+        mUniquenessLabel->setText(QString());
+        break;
+    }
+}
+
 MainWindow *MainWindowContent::MainWindowGet() const
 {
     return mMainWindow;
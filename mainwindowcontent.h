@@ -38,6 +38,7 @@ private:
     QTabWidget* mControlsMenu;
     QStackedLayout* mContextMenu;
     QLabel* mImpossiblePuzzleLabel;
+    QLabel* mUniquenessLabel;
     SudokuGridWidget* mGrid;
     ContextMenuType mCurrentView;
 
@@ -45,6 +46,7 @@ private slots:
     void OnTabChanged_ControlsMenu(int tab);
     void OnPuzzleBroken();
     void OnLogicalSolverReset();
+    void OnUniquenessChecked(int status);
 
 public:
     MainWindow* MainWindowGet() const;
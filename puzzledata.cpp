@@ -56,152 +56,50 @@ std::set<unsigned short> SudokuSolverThread::HintsGet(CellCoord id) const
 
 void SudokuSolverThread::SetRegion(unsigned short regionId, const std::set<CellCoord> &cells)
 {
-    QMutexLocker locker(&mInputMutex);
-
-    unsigned short index = regionId - 1;
-    if(index < mPuzzleData.mSize && mPuzzleData.mRegions.at(index) != cells)
-    {
-        if(mPuzzleData.mRegions.at(index).empty())
-        {
-            AddRegionToSubmissionQueue(index);
-        }
-        else
-        {
-            ReloadGrid();
-        }
-        mPuzzleData.mRegions.at(index) = cells;
-    }
+    PostCommand(SolverCommand(SolverCommand::Command_SetRegion, regionId - 1, 0, cells));
 }
 
 void SudokuSolverThread::PositiveDiagonalConstraintSet(bool set)
 {
-    QMutexLocker locker(&mInputMutex);
-
-    mPuzzleData.mPositiveDiagonal = set;
-    if(set)
-    {
-        AddDiagonalToSubmissionQueue(PuzzleData::Diagonal_Positive);
-    }
-    else
-    {
-        ReloadGrid();
-    }
+    PostCommand(SolverCommand(SolverCommand::Command_SetDiagonal, PuzzleData::Diagonal_Positive, set));
 }
 
 void SudokuSolverThread::NegativeDiagonalConstraintSet(bool set)
 {
-    QMutexLocker locker(&mInputMutex);
-
-    mPuzzleData.mNegativeDiagonal = set;
-    if(set)
-    {
-        AddDiagonalToSubmissionQueue(PuzzleData::Diagonal_Negative);
-    }
-    else
-    {
-        ReloadGrid();
-    }
+    PostCommand(SolverCommand(SolverCommand::Command_SetDiagonal, PuzzleData::Diagonal_Negative, set));
 }
 
 void SudokuSolverThread::AddGiven(unsigned short value, CellCoord  cellId)
 {
-    QMutexLocker locker(&mInputMutex);
-
-    if(value > 0 && value <= mPuzzleData.mSize)
-    {
-        if(mPuzzleData.mGivens.count(cellId) == 0)
-        {
-            AddGivenValueToSubmissionQueue(cellId);
-        }
-        else if(mPuzzleData.mGivens[cellId] != value)
-        {
-            ReloadCells();
-        }
-        mPuzzleData.mGivens[cellId] = value;
-    }
+    PostCommand(SolverCommand(SolverCommand::Command_AddGiven, cellId, value));
 }
 
 void SudokuSolverThread::RemoveGiven(CellCoord  cellId)
 {
-    QMutexLocker locker(&mInputMutex);
-
-    auto it = mPuzzleData.mGivens.find(cellId);
-    if(it != mPuzzleData.mGivens.end())
-    {
-        mPuzzleData.mGivens.erase(it);
-        ReloadCells();
-    }
+    PostCommand(SolverCommand(SolverCommand::Command_RemoveGiven, cellId));
 }
 
 void SudokuSolverThread::AddKillerCage(CellCoord cageId, unsigned int total, const CellsInRegion &cells)
 {
-    QMutexLocker locker(&mInputMutex);
-
-    auto it =  mPuzzleData.mKillerCages.find(cageId);
-    if(it == mPuzzleData.mKillerCages.end())
-    {
-        if(cells.size() > 0)
-        {
-            mPuzzleData.mKillerCages[cageId] = {total, cells};
-            AddKillerToSubmissionQueue(cageId);
-        }
-    }
+    PostCommand(SolverCommand(SolverCommand::Command_AddKillerCage, cageId, total, cells));
 }
 
 void SudokuSolverThread::RemoveKillerCage(CellCoord cageId)
 {
-    QMutexLocker locker(&mInputMutex);
-
-    auto it =  mPuzzleData.mKillerCages.find(cageId);
-    if(it !=  mPuzzleData.mKillerCages.end())
-    {
-        mPuzzleData.mKillerCages.erase(it);
-        ReloadGrid();
-    }
+    PostCommand(SolverCommand(SolverCommand::Command_RemoveKillerCage, cageId));
 }
 
 void SudokuSolverThread::AddHint(CellCoord cellId, unsigned short value)
 {
-    QMutexLocker locker(&mInputMutex);
-
-    auto it = mPuzzleData.mHints.find(cellId);
-    if(it != mPuzzleData.mHints.end())
-    {
-        if(it->second.insert(value).second)
-        {
-            AddHintToSubmissionQueue(cellId);
-        }
-    }
-    else
-    {
-        mPuzzleData.mHints[cellId] = {value};
-        AddHintToSubmissionQueue(cellId);
-    }
+    PostCommand(SolverCommand(SolverCommand::Command_AddHint, cellId, value));
 }
 
 void SudokuSolverThread::RemoveHint(CellCoord cageId, unsigned short value)
 {
-    QMutexLocker locker(&mInputMutex);
-
-    auto mapIt = mPuzzleData.mHints.find(cageId);
-    if(mapIt != mPuzzleData.mHints.end())
-    {
-        auto setIt = mapIt->second.find(value);
-        if(setIt != mapIt->second.end())
-        {
-            mapIt->second.erase(setIt);
-            ReloadCells();
-        }
-    }
+    PostCommand(SolverCommand(SolverCommand::Command_RemoveHint, cageId, value));
 }
 
 void SudokuSolverThread::RemoveAllHints()
 {
-    QMutexLocker locker(&mInputMutex);
-
-    if(!mPuzzleData.mHints.empty())
-    {
-        mPuzzleData.mHints.clear();
-        ReloadCells();
-    }
+    PostCommand(SolverCommand(SolverCommand::Command_RemoveAllHints));
 }
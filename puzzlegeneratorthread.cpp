@@ -0,0 +1,85 @@
+#include "puzzlegeneratorthread.h"
+
+PuzzleGeneratorThread::PuzzleGeneratorThread(QObject *parent)
+    : QThread{parent}
+    , mGenerator(nullptr)
+    , mPuzzleData(nullptr)
+    , mGivens()
+    , mMinimise(false)
+    , mAbort(false)
+    , mInputMutex()
+{
+}
+
+PuzzleGeneratorThread::~PuzzleGeneratorThread()
+{
+    mInputMutex.lock();
+    mAbort = true;
+    mInputMutex.unlock();
+    wait();
+}
+
+void PuzzleGeneratorThread::run()
+{
+    mInputMutex.lock();
+    std::unique_ptr<PuzzleData> puzzleData = std::move(mPuzzleData);
+    bool minimise = mMinimise;
+    mInputMutex.unlock();
+
+    emit GenerationStarted();
+
+    // the workers are started on first use and kept for the following requests
+    if (!mGenerator)
+    {
+        mGenerator = std::make_unique<PuzzleGenerator>();
+    }
+
+    PuzzleGenerator::Givens givens;
+    bool success = minimise ? mGenerator->Minimise(*puzzleData, givens, &mAbort)
+                            : mGenerator->Generate(*puzzleData, givens, &mAbort);
+
+    mInputMutex.lock();
+    mGivens = std::move(givens);
+    mInputMutex.unlock();
+
+    emit GenerationFinished(success);
+}
+
+void PuzzleGeneratorThread::GeneratePuzzle(const PuzzleData &layout)
+{
+    if(!isRunning())
+    {
+        QMutexLocker locker(&mInputMutex);
+        mAbort = false;
+        mMinimise = false;
+        mPuzzleData = std::make_unique<PuzzleData>(layout);
+        start(HighestPriority);
+    }
+}
+
+void PuzzleGeneratorThread::MinimisePuzzle(const PuzzleData &puzzleData)
+{
+    if(!isRunning())
+    {
+        QMutexLocker locker(&mInputMutex);
+        mAbort = false;
+        mMinimise = true;
+        mPuzzleData = std::make_unique<PuzzleData>(puzzleData);
+        start(HighestPriority);
+    }
+}
+
+void PuzzleGeneratorThread::AbortGeneration()
+{
+    if(isRunning())
+    {
+        QMutexLocker locker(&mInputMutex);
+        mAbort = true;
+    }
+}
+
+PuzzleGenerator::Givens PuzzleGeneratorThread::GivensGet()
+{
+    QMutexLocker locker(&mInputMutex);
+    return mGivens;
+}
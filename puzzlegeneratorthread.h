@@ -0,0 +1,39 @@
+#ifndef PUZZLEGENERATORTHREAD_H
+#define PUZZLEGENERATORTHREAD_H
+
+#include <QThread>
+#include <QMutex>
+#include <atomic>
+#include "puzzledata.h"
+#include "solver/PuzzleGenerator.h"
+
+class PuzzleGeneratorThread : public QThread
+{
+    Q_OBJECT
+public:
+    explicit PuzzleGeneratorThread(QObject *parent = nullptr);
+    ~PuzzleGeneratorThread();
+
+signals:
+    void GenerationStarted();
+    void GenerationFinished(bool success);
+
+protected:
+    void run() override;
+
+private:
+    std::unique_ptr<PuzzleGenerator> mGenerator;
+    std::unique_ptr<PuzzleData> mPuzzleData;
+    PuzzleGenerator::Givens mGivens;
+    bool mMinimise;     // keep the current solution and only remove givens
+    std::atomic<bool> mAbort;
+    QMutex mInputMutex;
+
+public:
+    void GeneratePuzzle(const PuzzleData& layout);
+    void MinimisePuzzle(const PuzzleData& puzzleData);
+    void AbortGeneration();
+    PuzzleGenerator::Givens GivensGet();
+};
+
+#endif // PUZZLEGENERATORTHREAD_H
@@ -0,0 +1,229 @@
+#include "sessionreplayer.h"
+#include "sudokusolverthread.h"
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <iomanip>
+#include <map>
+
+namespace
+{
+    double MillisecondsSince(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+SessionReplayer::SessionReplayer(const SessionLog &log):
+    mLog(log),
+    mEntries(log.EntriesGet()),
+    mTimings()
+{
+}
+
+unsigned long SessionReplayer::TimeToInterruptionGet(size_t index, bool bruteForce) const
+{
+    for (size_t i = index + 1; i < mEntries.size(); ++i)
+    {
+        const SessionLog::Entry& entry = mEntries[i];
+        // new input interrupts both solvers, and so does closing the grid
+        bool interrupts = entry.mType == SessionLog::Entry_Submit ||
+                          entry.mType == SessionLog::Entry_End ||
+                          (entry.mType == SessionLog::Entry_Command && entry.mCommand.mType == SolverCommand::Command_ResetSolver);
+        if (bruteForce)
+        {
+            if (entry.mType == SessionLog::Entry_CountSolutions || entry.mType == SessionLog::Entry_DisplaySolution)
+            {
+                break;
+            }
+            interrupts |= entry.mType == SessionLog::Entry_AbortBruteForce;
+        }
+        else
+        {
+            interrupts |= entry.mType == SessionLog::Entry_SetPaused && entry.mValue != 0;
+        }
+        if (interrupts)
+        {
+            return static_cast<unsigned long>(std::max(0LL, entry.mTime - mEntries[index].mTime));
+        }
+    }
+    return ULONG_MAX;
+}
+
+std::string SessionReplayer::EntryNameGet(const SessionLog::Entry &entry)
+{
+    switch (entry.mType)
+    {
+    case SessionLog::Entry_Command:
+        switch (entry.mCommand.mType)
+        {
+        case SolverCommand::Command_AddGiven:           return "AddGiven";
+        case SolverCommand::Command_RemoveGiven:        return "RemoveGiven";
+        case SolverCommand::Command_AddHint:            return "AddHint";
+        case SolverCommand::Command_RemoveHint:         return "RemoveHint";
+        case SolverCommand::Command_RemoveAllHints:     return "RemoveAllHints";
+        case SolverCommand::Command_SetRegion:          return "SetRegion";
+        case SolverCommand::Command_SetDiagonal:        return "SetDiagonal";
+        case SolverCommand::Command_AddKillerCage:      return "AddKillerCage";
+        case SolverCommand::Command_RemoveKillerCage:   return "RemoveKillerCage";
+        case SolverCommand::Command_ResetSolver:        return "ResetSolver";
+        default:                                        return "Command";
+        }
+    case SessionLog::Entry_Submit:          return "Submit";
+    case SessionLog::Entry_SetPaused:       return entry.mValue ? "Pause" : "Resume";
+    case SessionLog::Entry_TakeStep:        return "TakeStep";
+    case SessionLog::Entry_SearchEngine:    return "SearchEngine";
+    case SessionLog::Entry_SchedulingMode:  return "SchedulingMode";
+    case SessionLog::Entry_CountSolutions:  return "CountSolutions";
+    case SessionLog::Entry_DisplaySolution: return "DisplaySolution";
+    case SessionLog::Entry_AbortBruteForce: return "AbortBruteForce";
+    case SessionLog::Entry_End:             return "End";
+    }
+    return "Unknown";
+}
+
+void SessionReplayer::Replay()
+{
+    mTimings.clear();
+
+    // counts cached by earlier sessions would hide the cost of the searches
+    SudokuSolverThread solver(mLog.GridSizeGet());
+    solver.Init(false);
+    BruteForceSolverThread* bruteForce = solver.BruteSolverGet();
+
+    for (size_t i = 0; i < mEntries.size(); ++i)
+    {
+        const SessionLog::Entry& entry = mEntries[i];
+        const bool bruteForceRequest = entry.mType == SessionLog::Entry_CountSolutions ||
+                                       entry.mType == SessionLog::Entry_DisplaySolution;
+        if (bruteForceRequest)
+        {
+            // the previous search has been aborted, let it wind down
+            bruteForce->wait();
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        switch (entry.mType)
+        {
+        case SessionLog::Entry_Command:
+            solver.ReplayCommand(entry.mCommand);
+            break;
+        case SessionLog::Entry_Submit:
+            solver.SubmitChangesToSolver();
+            break;
+        case SessionLog::Entry_SetPaused:
+            solver.SetLogicalSolverPaused(entry.mValue != 0);
+            break;
+        case SessionLog::Entry_TakeStep:
+            solver.TakeStep();
+            break;
+        case SessionLog::Entry_SearchEngine:
+            bruteForce->SearchEngineSet(static_cast<BruteForceSolver::SearchEngine>(entry.mValue));
+            break;
+        case SessionLog::Entry_SchedulingMode:
+            solver.SchedulingModeSet(static_cast<SchedulingMode>(entry.mValue));
+            break;
+        case SessionLog::Entry_CountSolutions:
+            bruteForce->CountSolutions(entry.mValue, entry.mUseHints);
+            break;
+        case SessionLog::Entry_DisplaySolution:
+            bruteForce->DisplaySolution(entry.mValue, entry.mUseHints);
+            break;
+        case SessionLog::Entry_AbortBruteForce:
+            bruteForce->AbortCalculation();
+            break;
+        case SessionLog::Entry_End:
+            break;
+        }
+
+        // the other entries only queue edits or change settings
+        bool settled = true;
+        const bool logicalWork = entry.mType == SessionLog::Entry_Submit ||
+                                 entry.mType == SessionLog::Entry_TakeStep ||
+                                 (entry.mType == SessionLog::Entry_SetPaused && entry.mValue == 0) ||
+                                 (entry.mType == SessionLog::Entry_Command && entry.mCommand.mType == SolverCommand::Command_ResetSolver);
+        if (logicalWork)
+        {
+            settled = solver.WaitUntilIdle(TimeToInterruptionGet(i, false));
+        }
+        const double logicalMs = MillisecondsSince(start);
+
+        if (bruteForceRequest)
+        {
+            const unsigned long timeout = TimeToInterruptionGet(i, true);
+            settled = timeout == ULONG_MAX ? bruteForce->wait() : bruteForce->wait(timeout);
+        }
+        else if (entry.mType == SessionLog::Entry_AbortBruteForce)
+        {
+            bruteForce->wait();
+        }
+
+        mTimings.push_back(EntryTiming{i, logicalMs, MillisecondsSince(start) - logicalMs, !settled});
+    }
+}
+
+const std::vector<SessionReplayer::EntryTiming> &SessionReplayer::TimingsGet() const
+{
+    return mTimings;
+}
+
+void SessionReplayer::WriteReport(std::ostream &stream) const
+{
+    struct Total
+    {
+        size_t mCount = 0;
+        double mLogicalMs = 0;
+        double mBruteForceMs = 0;
+        double mMaxMs = 0;
+        size_t mInterrupted = 0;
+    };
+    std::map<std::string, Total> totals;
+    Total overall;
+    for (const auto& timing : mTimings)
+    {
+        const double ms = timing.mLogicalMs + timing.mBruteForceMs;
+        for (Total* total : {&totals[EntryNameGet(mEntries[timing.mIndex])], &overall})
+        {
+            ++total->mCount;
+            total->mLogicalMs += timing.mLogicalMs;
+            total->mBruteForceMs += timing.mBruteForceMs;
+            total->mMaxMs = std::max(total->mMaxMs, ms);
+            total->mInterrupted += timing.mInterrupted ? 1 : 0;
+        }
+    }
+
+    const long long recordedMs = mEntries.empty() ? 0 : mEntries.back().mTime;
+    stream << std::fixed << std::setprecision(1);
+    stream << "Replayed " << mTimings.size() << " entries on a " << mLog.GridSizeGet() << "x" << mLog.GridSizeGet()
+           << " grid, recorded over " << recordedMs / 1000.0 << " s\n";
+    stream << "Total " << overall.mLogicalMs + overall.mBruteForceMs << " ms: logical solver "
+           << overall.mLogicalMs << " ms, brute force " << overall.mBruteForceMs << " ms\n";
+    stream << overall.mInterrupted << " entries left a solver busy until the next input interrupted it\n\n";
+
+    stream << std::left << std::setw(18) << "Entry" << std::right << std::setw(8) << "Count"
+           << std::setw(14) << "Logical ms" << std::setw(16) << "Brute force ms" << std::setw(12) << "Max ms" << std::setw(13) << "Interrupted" << "\n";
+    for (const auto& total : totals)
+    {
+        stream << std::left << std::setw(18) << total.first << std::right << std::setw(8) << total.second.mCount
+               << std::setw(14) << total.second.mLogicalMs << std::setw(16) << total.second.mBruteForceMs
+               << std::setw(12) << total.second.mMaxMs << std::setw(13) << total.second.mInterrupted << "\n";
+    }
+
+    // slowest entries, with the time they were recorded at to find them in the log
+    const size_t kSlowestCount = 10;
+    std::vector<EntryTiming> slowest = mTimings;
+    const auto slower = [](const EntryTiming& a, const EntryTiming& b)
+    {
+        return a.mLogicalMs + a.mBruteForceMs > b.mLogicalMs + b.mBruteForceMs;
+    };
+    const size_t count = std::min(kSlowestCount, slowest.size());
+    std::partial_sort(slowest.begin(), slowest.begin() + count, slowest.end(), slower);
+    stream << "\nSlowest entries:\n";
+    for (size_t i = 0; i < count; ++i)
+    {
+        const SessionLog::Entry& entry = mEntries[slowest[i].mIndex];
+        stream << "  #" << slowest[i].mIndex << " at " << entry.mTime / 1000.0 << " s  " << EntryNameGet(entry)
+               << "  " << slowest[i].mLogicalMs + slowest[i].mBruteForceMs << " ms"
+               << (slowest[i].mInterrupted ? " (interrupted)" : "") << "\n";
+    }
+}
@@ -0,0 +1,48 @@
+#ifndef SESSIONREPLAYER_H
+#define SESSIONREPLAYER_H
+
+#include "IO/SessionLog.h"
+#include <ostream>
+#include <vector>
+
+/// <summary>
+/// Replays a session log on a new solver, without any window. After each entry that gives the
+/// solvers some work, the replayer waits for them to settle, so that the time spent on each input
+/// can be measured and compared between builds. As in the recorded session, a solver still busy
+/// when the next entry that interrupts it is due (e.g. new edits submitted) is interrupted by it.
+/// </summary>
+class SessionReplayer
+{
+public:
+    struct EntryTiming
+    {
+        size_t mIndex;              // position of the entry in the log
+        double mLogicalMs;          // until the logical solver was waiting for input again
+        double mBruteForceMs;       // then until the brute force search was over
+        bool mInterrupted;          // a solver was still busy when the next entry was due
+    };
+
+private:
+    const SessionLog& mLog;
+    std::vector<SessionLog::Entry> mEntries;
+    std::vector<EntryTiming> mTimings;
+
+    /// <summary>
+    /// Milliseconds between the entry at index and the first later entry that interrupts
+    /// the logical solver or the brute force search, or ULONG_MAX if there is none
+    /// </summary>
+    unsigned long TimeToInterruptionGet(size_t index, bool bruteForce) const;
+    static std::string EntryNameGet(const SessionLog::Entry& entry);
+
+public:
+    explicit SessionReplayer(const SessionLog& log);
+
+    void Replay();
+    const std::vector<EntryTiming>& TimingsGet() const;
+    /// <summary>
+    /// Write the time spent per type of entry and the slowest entries
+    /// </summary>
+    void WriteReport(std::ostream& stream) const;
+};
+
+#endif // SESSIONREPLAYER_H
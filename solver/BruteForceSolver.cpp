@@ -2,26 +2,42 @@
 #include "SudokuGrid.h"
 #include "SudokuCell.h"
 #include "RegionsManager.h"
+#include "ConflictDrivenSolver.h"
+#include "Trace.h"
 #include "thirdparty/dancing_links.h"
 #include "bruteforcesolverthread.h"
+#include "IO/SolutionCountCache.h"
+#include <algorithm>
 #include <cassert>
 #include <QDebug>
 
-BruteForceSolver::BruteForceSolver(BruteForceSolverThread* bruteForceThread, SudokuGrid* grid, bool* abortFlag):
+BruteForceSolver::BruteForceSolver(BruteForceSolverThread* bruteForceThread, SudokuGrid* grid, std::atomic<bool>* abortFlag):
     mGrid(grid)
   , mBruteForceThread(bruteForceThread)
   , mUseHintsAsConstraints(false)
   , mIncidenceMatrixDirty(true)
-  , mSolutionsDirty(true)
-  , mMaxSolutionCount(0)
   , mAbort(abortFlag)
+  , mSearchEngine(SearchEngine::DancingLinks)
   , mDLXMatrix(nullptr)
-  , mSolutions()
-  , mSolutionIt(mSolutions.end())
+  , mFormula(nullptr)
+  , mDLXSearch(nullptr)
+  , mConflictDrivenSolver(nullptr)
+  , mSolutionsCount(0)
+  , mSearchFinished(false)
+  , mKnownSolutionsCount(0)
+  , mSolutionsCountExact(false)
+  , mFirstSolutions()
+  , mDisplayedSolutionsCount(0)
+  , mSolutionsCache(nullptr)
+  , mPuzzleKey()
 {
 }
 
-Possibility BruteForceSolver::PossibilityFromRowIndex(size_t row)
+BruteForceSolver::~BruteForceSolver()
+{
+}
+
+Possibility BruteForceSolver::PossibilityFromRowIndex(size_t row) const
 {
     size_t size = mGrid->SizeGet();
     assert(row < size * size * size);
@@ -31,7 +47,7 @@ Possibility BruteForceSolver::PossibilityFromRowIndex(size_t row)
     return {id, value};
 }
 
-size_t BruteForceSolver::IndexFromPossibility(CellId id, unsigned short value)
+size_t BruteForceSolver::IndexFromPossibility(CellId id, unsigned short value) const
 {
     assert(value > 0);
 
@@ -41,6 +57,7 @@ size_t BruteForceSolver::IndexFromPossibility(CellId id, unsigned short value)
 
 void BruteForceSolver::GenerateIncidenceMatrix(bool useHints)
 {
+    SUDOKU_TRACE_SCOPE("BruteForceSolver::GenerateIncidenceMatrix");
     if(useHints != mUseHintsAsConstraints)
     {
         mUseHintsAsConstraints = useHints;
@@ -51,7 +68,22 @@ void BruteForceSolver::GenerateIncidenceMatrix(bool useHints)
         return;
     }
     mIncidenceMatrixDirty = false;
-    mSolutionsDirty = true;
+
+    // the search must let go of the matrix before it is replaced
+    RestartSearch();
+    mKnownSolutionsCount = 0;
+    mSolutionsCountExact = false;
+    mFirstSolutions.clear();
+    mDisplayedSolutionsCount = 0;
+    mDLXMatrix.reset();
+    mFormula.reset();
+    if(mSearchEngine == SearchEngine::ConflictDriven)
+    {
+        // a new solver is built for every search
+        mFormula = std::make_unique<CnfFormula>();
+        FillFormula(*mFormula, mUseHintsAsConstraints);
+        return;
+    }
 
     size_t size = mGrid->SizeGet();
     const size_t primary_columns = size * size * size;
@@ -59,70 +91,191 @@ void BruteForceSolver::GenerateIncidenceMatrix(bool useHints)
     size_t im_rows = primary_columns; // num of all possibilities
     size_t im_cols = 3 * size * size;    // row-col, row-num, col-num constraints
 
-    const auto regions = mGrid->RegionsManagerGet()->StartingRegionsGet();
+    const auto& regions = mGrid->RegionsManagerGet()->StartingRegionsGet();
     // primary constraints
     im_cols += regions[(int)RegionType::House_Region].size() * size; // box-num constraint
+    const size_t houseColumns = im_cols;
     //secondary constraints
     im_cols += regions[(int)RegionType::Generic_region].size() * size;
     im_rows += regions[(int)RegionType::Generic_region].size() * size;
     for(const auto& reg: regions[(int)RegionType::KillerCage])
     {
-        const KillerConstraint* kc = static_cast<const KillerConstraint*>(reg.get()->GetConstraintByType(RegionType::KillerCage));
+        const KillerConstraint* kc = static_cast<const KillerConstraint*>(reg->GetConstraintByType(RegionType::KillerCage));
         im_cols += size;;
         im_rows += kc->CombinationsGet().size();
     }
 
-    // create the temp incidence matrix
-    bool** M = new bool*[im_rows];
-    for(size_t i = 0; i < im_rows; i++)
+    // only the non-zero entries are stored, so memory grows linearly with the number of possibilities
+    std::vector<std::vector<int>> M(im_rows);
+    FillIncidenceMatrix(M);
+
+    // convert matrix to 2d doubly linked list
+    // on ties the cell and house columns are chosen first, the others can also be covered by slack rows
+    std::vector<bool> primaryColumns(im_cols, false);
+    std::fill(primaryColumns.begin(), primaryColumns.begin() + houseColumns, true);
+    mDLXMatrix = std::make_unique<linked_matrix_GJK::LMatrix>(M, static_cast<int>(im_cols), primaryColumns);
+}
+
+void BruteForceSolver::RestartSearch()
+{
+    mDLXSearch.reset();
+    mConflictDrivenSolver.reset();
+    mSolutionsCount = 0;
+    mSearchFinished = false;
+}
+
+bool BruteForceSolver::NextSolution(std::vector<unsigned short>* outSolution)
+{
+    if(mSearchFinished)
+    {
+        return false;
+    }
+
+    std::vector<size_t> rows;
+    bool found = false;
+    bool finished = false;
+    if(mSearchEngine == SearchEngine::ConflictDriven)
+    {
+        if(!mConflictDrivenSolver)
+        {
+            mConflictDrivenSolver = std::make_unique<ConflictDrivenSolver>(*mFormula);
+        }
+        // the variables of the cell-candidate pairs come first, numbered as the rows of the incidence matrix
+        std::list<ConflictDrivenSolver::Solution> solutions;
+        {
+            SUDOKU_TRACE_SCOPE("ConflictDrivenSolver::FindSolutions");
+            mConflictDrivenSolver->FindSolutions(solutions, 1, mAbort);
+        }
+        found = !solutions.empty();
+        finished = !found && !*mAbort;
+        if(found)
+        {
+            rows = std::move(solutions.front());
+        }
+    }
+    else
     {
-        M[i] = new bool[im_cols];
+        if(!mDLXSearch)
+        {
+            mDLXSearch = std::make_unique<dancing_links_GJK::Exact_Cover_Search>(*mDLXMatrix);
+        }
+        {
+            SUDOKU_TRACE_SCOPE("dancing_links::Exact_Cover_Search::next");
+            found = mDLXSearch->next(rows, mAbort);
+        }
+        finished = mDLXSearch->is_finished();
     }
 
-    // fill the incidence matrix
-    FillIncidenceMatrix(M, im_rows);
+    // an aborted search stays suspended, and is resumed by the next call
+    if(!found)
+    {
+        if(finished)
+        {
+            mSearchFinished = true;
+            mKnownSolutionsCount = mSolutionsCount;
+            mSolutionsCountExact = true;
+        }
+        return false;
+    }
+    ++mSolutionsCount;
+    mKnownSolutionsCount = std::max(mKnownSolutionsCount, mSolutionsCount);
 
-    // convert matrix to 2d doubly linked list
-    mDLXMatrix.reset();
-    mDLXMatrix = std::make_unique<linked_matrix_GJK::LMatrix>(M,im_rows,im_cols);
+    // a restarted search finds the solutions it has already found in the same order
+    const bool storeSolution = mSolutionsCount > mFirstSolutions.size() &&
+                               mFirstSolutions.size() < SolutionCountCache::kMaxStoredSolutions;
+    if(outSolution || storeSolution)
+    {
+        std::vector<unsigned short> solution;
+        size_t size = mGrid->SizeGet();
+        const size_t primary_columns = size * size * size;
+        solution.assign(size * size, 0);
+        for (const auto& r : rows)
+        {
+            if(r >= primary_columns)
+            {
+                continue;
+            }
+            Possibility p = PossibilityFromRowIndex(r);
+            solution[p.first] = p.second;
+        }
+        if(storeSolution)
+        {
+            mFirstSolutions.push_back(solution);
+        }
+        if(outSolution)
+        {
+            *outSolution = std::move(solution);
+        }
+    }
+    return true;
+}
+
+void BruteForceSolver::SyncSolutionsCache()
+{
+    if(!mSolutionsCache || mPuzzleKey.empty())
+    {
+        return;
+    }
 
-    // delete the temp incidence matrix
-    for(size_t i = 0; i < im_rows; i++)
+    SolutionCountCache::Result cached{0, true, {}};
+    const bool found = mSolutionsCache->Get(mPuzzleKey, cached);
+    if(found && !mSolutionsCountExact)
     {
-        delete[] M[i];
+        if(!cached.mStopped)
+        {
+            mKnownSolutionsCount = cached.mCount;
+            mSolutionsCountExact = true;
+        }
+        else
+        {
+            mKnownSolutionsCount = std::max(mKnownSolutionsCount, cached.mCount);
+        }
+    }
+    // solutions from another search may come in a different order, so they are only
+    // taken when they are all the solutions of the puzzle and no search has to run again
+    if(found && !cached.mStopped && cached.mSolutions.size() == cached.mCount && mFirstSolutions.size() < cached.mCount)
+    {
+        mFirstSolutions = cached.mSolutions;
+    }
+
+    const bool betterCount = cached.mStopped && (mSolutionsCountExact || mKnownSolutionsCount > cached.mCount);
+    if(!found || betterCount || mFirstSolutions.size() > cached.mSolutions.size())
+    {
+        mSolutionsCache->Store(mPuzzleKey, {mKnownSolutionsCount, !mSolutionsCountExact, mFirstSolutions});
     }
-    delete[] M;
 }
 
-void BruteForceSolver::SolveExactCoverProblem()
+bool BruteForceSolver::IsPossibilityViable(const SudokuCell* cell, unsigned short value, bool useHints) const
 {
-    if(mSolutionsDirty)
+    if(cell->IsGiven())
+    {
+        return value == cell->ValueGet();
+    }
+    else if(useHints)
     {
-        mSolutions.clear();
-        mSolutionIt = mSolutions.end();
-        mSolutionsDirty = false;
-        std::list<std::vector<size_t>> solutions;
-        dancing_links_GJK::Exact_Cover_Solver(*mDLXMatrix, solutions, mMaxSolutionCount, mAbort);
+        return cell->HintedEliminationsGet().count(value) == 0;
+    }
+    return true;
+}
 
-        size_t size = mGrid->SizeGet();
-        const size_t primary_columns = size * size * size;
-        for(const auto& sol : solutions)
+void BruteForceSolver::FillRegionColumns(std::vector<std::vector<int>>& M, const Region* region, size_t firstColumn)
+{
+    // columns are visited in increasing order, so the entries of each row stay sorted
+    const size_t size = mGrid->SizeGet();
+    for(const SudokuCell* cell : region->CellsGet())
+    {
+        for(unsigned short value = 1; value <= size; ++value)
         {
-            mSolutions.push_back(std::vector<unsigned short>(size * size));
-            for (const auto& r : sol)
+            std::vector<int>& row = M[IndexFromPossibility(cell->IdGet(), value)];
+            if(!row.empty())
             {
-                if(r >= primary_columns)
-                {
-                    continue;
-                }
-                Possibility p = PossibilityFromRowIndex(r);
-                mSolutions.back()[p.first] = p.second;
+                row.push_back(static_cast<int>(firstColumn + value - 1));
             }
         }
     }
 }
 
-void BruteForceSolver::FillIncidenceMatrix(bool** M, const size_t rows)
+void BruteForceSolver::FillIncidenceMatrix(std::vector<std::vector<int>>& M)
 {
     size_t c = 0;
     size_t size = mGrid->SizeGet();
@@ -130,33 +283,16 @@ void BruteForceSolver::FillIncidenceMatrix(bool** M, const size_t rows)
     size_t sec_r = primaryRows;
     // row-col constraint
     // |r1c1 r1c2 r1c3 ... r2c1 r2c2 ... r9c8 r9c9|
-    for(size_t i = 0; i < size * size; ++i)
+    // possibilities ruled out by givens or hints are left as empty rows
+    for(size_t r = 0; r < primaryRows; ++r)
     {
-        for(size_t r = 0; r < rows; ++r)
+        const Possibility p = PossibilityFromRowIndex(r);
+        if(IsPossibilityViable(mGrid->CellGet(p.first), p.second, mUseHintsAsConstraints))
         {
-            if(r >= primaryRows)
-            {
-                M[r][c] = 0;
-                continue;
-            }
-            const Possibility p = PossibilityFromRowIndex(r);
-            const SudokuCell* cell = mGrid->CellGet(p.first);
-            unsigned short value = p.second;
-            if(cell->IsGiven())
-            {
-                M[r][c] = (cell->IdGet() == i && value == cell->ValueGet());
-            }
-            else if(mUseHintsAsConstraints)
-            {
-                M[r][c] = (cell->IdGet() == i && cell->HintedEliminationsGet().count(value) == 0);
-            }
-            else
-            {
-                M[r][c] = (cell->IdGet() == i);
-            }
+            M[r].push_back(static_cast<int>(p.first));
         }
-        ++c;
     }
+    c += size * size;
 
     // houses
     // |Ha1 Ha2 Ha3 ... Hb1 Hb2 Hb3 ... |
@@ -169,26 +305,10 @@ void BruteForceSolver::FillIncidenceMatrix(bool** M, const size_t rows)
     for (int regionType = 0; regionType < housesTypes; ++regionType)
     {
         const auto& regions = mGrid->RegionsManagerGet()->StartingRegionsGet()[static_cast<int>(houses[regionType])];
-        auto it = regions.begin();
-        while(it != regions.end())
+        for(const auto& region : regions)
         {
-            for(size_t i = 1; i <= size; ++i)
-            {
-                for(size_t r = 0; r < rows; ++r)
-                {
-                    if(r >= primaryRows)
-                    {
-                        M[r][c] = 0;
-                        continue;
-                    }
-                    const Possibility p = PossibilityFromRowIndex(r);
-                    SudokuCell* cell = mGrid->CellGet(p.first);
-                    unsigned short value = p.second;
-                    M[r][c] = ((*it)->CellsGet().count(cell) && value == i);
-                }
-                ++c;
-            }
-            ++it;
+            FillRegionColumns(M, region, c);
+            c += size;
         }
     }
 
@@ -196,28 +316,16 @@ void BruteForceSolver::FillIncidenceMatrix(bool** M, const size_t rows)
     // |Ra1 Ra2 Ra3 ... Rb1 Rb2 Rb3 ... |
     {
         const auto& regions = mGrid->RegionsManagerGet()->StartingRegionsGet()[static_cast<int>(RegionType::Generic_region)];
-        auto it = regions.begin();
-        while(it != regions.end())
+        for(const auto& region : regions)
         {
-            for(size_t i = 1; i <= size; ++i)
+            FillRegionColumns(M, region, c);
+            // slack rows for the digits that are not in the region
+            for(size_t i = 0; i < size; ++i)
             {
-                for(size_t r = 0; r < rows; ++r)
-                {
-                    if(r >= primaryRows)
-                    {
-                        M[r][c] = 0;
-                        continue;
-                    }
-                    const Possibility p = PossibilityFromRowIndex(r);
-                    SudokuCell* cell = mGrid->CellGet(p.first);
-                    unsigned short value = p.second;
-                    M[r][c] = ((*it)->CellsGet().count(cell) && value == i);
-                }
-                M[sec_r][c] = 1;
+                M[sec_r].push_back(static_cast<int>(c + i));
                 ++sec_r;
-                ++c;
             }
-            ++it;
+            c += size;
         }
     }
 
@@ -225,74 +333,224 @@ void BruteForceSolver::FillIncidenceMatrix(bool** M, const size_t rows)
     // |Ka1 Ka2 Ka3 ... Kb1 Kb2 Kb3 ... |
     {
         const auto& regions = mGrid->RegionsManagerGet()->StartingRegionsGet()[static_cast<int>(RegionType::KillerCage)];
-        auto it = regions.begin();
-        while(it != regions.end())
+        for(const auto& region : regions)
         {
-            int start_c = c;
-            for(size_t i = 1; i <= size; ++i)
+            FillRegionColumns(M, region, c);
+            // one row per combination, covering the digits that are not in the combination
+            const KillerConstraint* kc = static_cast<const KillerConstraint*>(region->GetConstraintByType(RegionType::KillerCage));
+            for(const auto& combination: kc->CombinationsGet())
             {
-                for(size_t r = 0; r < rows; ++r)
+                for(size_t i = 1; i <= size; ++i)
                 {
-                    if(r >= primaryRows)
+                    if(combination.count(i) == 0)
                     {
-                        M[r][c] = 0;
-                        continue;
+                        M[sec_r].push_back(static_cast<int>(c + i - 1));
                     }
-                    const Possibility p = PossibilityFromRowIndex(r);
-                    SudokuCell* cell = mGrid->CellGet(p.first);
-                    unsigned short value = p.second;
-                    M[r][c] = ((*it)->CellsGet().count(cell) && value == i);
                 }
-                ++c;
+                ++sec_r;
             }
-            const KillerConstraint* kc = static_cast<const KillerConstraint*>((*it)->GetConstraintByType(RegionType::KillerCage));
-            for(const auto& combination: kc->CombinationsGet())
+            c += size;
+        }
+    }
+}
+
+int BruteForceSolver::VariableFromPossibility(CellId id, unsigned short value) const
+{
+    return static_cast<int>(IndexFromPossibility(id, value)) + 1;
+}
+
+std::vector<int> BruteForceSolver::RegionVariablesGet(const Region* region, unsigned short value) const
+{
+    std::vector<int> variables;
+    variables.reserve(region->SizeGet());
+    for(const SudokuCell* cell : region->CellsGet())
+    {
+        variables.push_back(VariableFromPossibility(cell->IdGet(), value));
+    }
+    return variables;
+}
+
+void BruteForceSolver::FillFormula(CnfFormula& formula, bool useHints) const
+{
+    const unsigned short size = mGrid->SizeGet();
+    const auto& startingRegions = mGrid->RegionsManagerGet()->StartingRegionsGet();
+    formula.VariablesAdd(size * size * size);
+
+    // each cell has one digit, the ones ruled out by givens or hints are false
+    for(CellId id = 0; id < static_cast<CellId>(size * size); ++id)
+    {
+        const SudokuCell* cell = mGrid->CellGet(id);
+        std::vector<int> variables;
+        for(unsigned short value = 1; value <= size; ++value)
+        {
+            variables.push_back(VariableFromPossibility(id, value));
+            if(!IsPossibilityViable(cell, value, useHints))
             {
-                for(size_t i = 1; i <= size; ++i)
+                formula.ClauseAdd({-variables.back()});
+            }
+        }
+        formula.ExactlyOneAdd(variables);
+    }
+
+    // houses (including the diagonals) have each digit once
+    constexpr int housesTypes = 3;
+    RegionType houses[housesTypes] = {
+        RegionType::House_Row,
+        RegionType::House_Column,
+        RegionType::House_Region
+    };
+    for (int regionType = 0; regionType < housesTypes; ++regionType)
+    {
+        for(const auto& region : startingRegions[static_cast<int>(houses[regionType])])
+        {
+            for(unsigned short value = 1; value <= size; ++value)
+            {
+                formula.ExactlyOneAdd(RegionVariablesGet(region, value));
+            }
+        }
+    }
+
+    // non-house regions have each digit at most once
+    for(const auto& region : startingRegions[static_cast<int>(RegionType::Generic_region)])
+    {
+        for(unsigned short value = 1; value <= size; ++value)
+        {
+            formula.AtMostOneAdd(RegionVariablesGet(region, value));
+        }
+    }
+
+    // killer cages: one variable per combination of digits adding up to the sum, exactly one of them is true.
+    // The digits of the chosen combination are in the cage and a digit in the cage needs a combination containing it.
+    for(const auto& region : startingRegions[static_cast<int>(RegionType::KillerCage)])
+    {
+        const KillerConstraint* kc = static_cast<const KillerConstraint*>(region->GetConstraintByType(RegionType::KillerCage));
+        const auto& combinations = kc->CombinationsGet();
+        std::vector<int> combinationVariables;
+        if(!combinations.empty())
+        {
+            const int first = formula.VariablesAdd(static_cast<int>(combinations.size()));
+            for(size_t i = 0; i < combinations.size(); ++i)
+            {
+                combinationVariables.push_back(first + static_cast<int>(i));
+            }
+        }
+        formula.ExactlyOneAdd(combinationVariables);
+
+        for(unsigned short value = 1; value <= size; ++value)
+        {
+            std::vector<int> cellVariables = RegionVariablesGet(region, value);
+            std::vector<int> containing;
+            size_t i = 0;
+            for(const auto& combination : combinations)
+            {
+                if(combination.count(value))
                 {
-                    M[sec_r][start_c + i - 1] = (combination.count(i) == 0);
+                    containing.push_back(combinationVariables[i]);
+                    std::vector<int> clause = cellVariables;
+                    clause.push_back(-combinationVariables[i]);
+                    formula.ClauseAdd(std::move(clause));
                 }
-                ++sec_r;
+                ++i;
+            }
+            for(const int v : cellVariables)
+            {
+                std::vector<int> clause = containing;
+                clause.push_back(-v);
+                formula.ClauseAdd(std::move(clause));
             }
-            ++it;
+            formula.AtMostOneAdd(std::move(cellVariables));
         }
     }
 }
 
+void BruteForceSolver::WriteDimacs(std::ostream& stream, bool useHints) const
+{
+    const unsigned short size = mGrid->SizeGet();
+    CnfFormula formula;
+    FillFormula(formula, useHints);
+    formula.WriteDimacs(stream, {
+        "sudoku " + std::to_string(size) + "x" + std::to_string(size),
+        "variable (row * " + std::to_string(size) + " + column) * " + std::to_string(size) + " + digit is true if the cell has the digit,",
+        "with rows and columns counted from 0 and digits from 1.",
+        "The variables after " + std::to_string(size * size * size) + " pick the combination of digits of each killer cage."
+    });
+}
+
 void BruteForceSolver::DirtySolutions()
 {
-    mSolutionsDirty = true;
+    // the search is restarted when the matrix is generated again
     mIncidenceMatrixDirty = true;
-    mMaxSolutionCount = 0;
+}
+
+void BruteForceSolver::SearchEngineSet(SearchEngine engine)
+{
+    if(engine != mSearchEngine)
+    {
+        mSearchEngine = engine;
+        mIncidenceMatrixDirty = true;
+    }
+}
+
+void BruteForceSolver::SolutionsCacheSet(SolutionCountCache *cache, std::string puzzleKey)
+{
+    mSolutionsCache = cache;
+    mPuzzleKey = std::move(puzzleKey);
 }
 
 void BruteForceSolver::CountSolutions(size_t maxSolutionsCount)
 {
     assert(!mIncidenceMatrixDirty);
-    if(maxSolutionsCount > mMaxSolutionCount)
+    SyncSolutionsCache();
+    // a search restarted by FindSolutions() goes through the solutions already counted again
+    while(!mSolutionsCountExact && mKnownSolutionsCount < maxSolutionsCount && NextSolution(nullptr))
+    {
+    }
+    if(!*mAbort)
     {
-        mMaxSolutionCount = maxSolutionsCount;
-        mSolutionsDirty = true;
+        SyncSolutionsCache();
     }
-    SolveExactCoverProblem();
-    bool stopped = mSolutions.size() >= mMaxSolutionCount || *mAbort == true;
-    mBruteForceThread->NotifySolutionsCountReady(mSolutions.size(), stopped);
+    mBruteForceThread->NotifySolutionsCountReady(mKnownSolutionsCount, !mSolutionsCountExact);
 }
 
 void BruteForceSolver::FindSolutions(size_t maxSolutionsCount)
 {
-    CountSolutions(maxSolutionsCount);
+    assert(!mIncidenceMatrixDirty);
+    SyncSolutionsCache();
     std::vector<unsigned short> solution;
-
-    if(mSolutions.size() > 0)
+    bool found = false;
+    if(mSolutionsCountExact && mKnownSolutionsCount > 0 && mFirstSolutions.size() == mKnownSolutionsCount)
     {
-        if(mSolutionIt == mSolutions.end())
+        // every solution is known, there is nothing left to search
+        if(mDisplayedSolutionsCount >= std::min(mKnownSolutionsCount, maxSolutionsCount))
         {
-            mSolutionIt = mSolutions.begin();
+            mDisplayedSolutionsCount = 0;
         }
-        solution = *mSolutionIt;
-        mSolutionIt++;
+        solution = mFirstSolutions[mDisplayedSolutionsCount++];
+        found = true;
+    }
+    else
+    {
+        if(mSearchFinished || mSolutionsCount >= maxSolutionsCount)
+        {
+            RestartSearch();
+        }
+        found = NextSolution(&solution);
+        if(!found && mSearchFinished && mSolutionsCount > 0)
+        {
+            // past the last solution, go back to the first one
+            RestartSearch();
+            found = NextSolution(&solution);
+        }
+        mDisplayedSolutionsCount = mSolutionsCount;
+        if(!*mAbort)
+        {
+            SyncSolutionsCache();
+        }
+    }
+    mBruteForceThread->NotifySolutionsCountReady(mKnownSolutionsCount, !mSolutionsCountExact);
 
+    if(found)
+    {
         mBruteForceThread->NotifySolutionReady(solution);
     }
 }
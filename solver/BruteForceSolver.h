@@ -3,42 +3,107 @@
 
 // Includes
 #include "Types.h"
+#include "CnfFormula.h"
 #include "thirdparty/linked_matrix.h"
+#include <atomic>
+#include <ostream>
+#include <string>
+#include <vector>
 
 typedef unsigned int CellId;
 typedef std::pair<CellId, unsigned short> Possibility; // cell-candidate pair
 
 class BruteForceSolverThread;
+class ConflictDrivenSolver;
+class SolutionCountCache;
+namespace dancing_links_GJK { class Exact_Cover_Search; }
 
 class BruteForceSolver
 {
+public:
+    enum class SearchEngine
+    {
+        DancingLinks,
+        ConflictDriven      // learns from conflicts, see ConflictDrivenSolver
+    };
+
+private:
     const SudokuGrid* mGrid;           // reference to the grid
     BruteForceSolverThread* mBruteForceThread;
 
     bool mUseHintsAsConstraints; // whether the hints should be used as constraints
     bool mIncidenceMatrixDirty;     // whether the grid has changed since the last time the map was computed
-    bool mSolutionsDirty;        // whether the grid has changed since the last time the solutions were computed
-    size_t mMaxSolutionCount;    // max number of solutions to search
-    const bool* mAbort;
+    const std::atomic<bool>* mAbort;
 
+    SearchEngine mSearchEngine;
     std::unique_ptr<linked_matrix_GJK::LMatrix> mDLXMatrix;
+    std::unique_ptr<CnfFormula> mFormula;   // only built for the conflict driven engine
+
+    // the search is suspended between calls, and resumed to find further solutions
+    std::unique_ptr<dancing_links_GJK::Exact_Cover_Search> mDLXSearch;
+    std::unique_ptr<ConflictDrivenSolver> mConflictDrivenSolver;
+    size_t mSolutionsCount;      // solutions found by the current search
+    bool mSearchFinished;        // whether the current search has found all the solutions
+    size_t mKnownSolutionsCount; // most solutions found by a search (or the cache) since the grid has changed
+    bool mSolutionsCountExact;   // whether mKnownSolutionsCount is the number of solutions of the puzzle
+    std::vector<std::vector<unsigned short>> mFirstSolutions;  // first solutions of the puzzle, at most SolutionCountCache::kMaxStoredSolutions
+    size_t mDisplayedSolutionsCount;    // solutions displayed since the search or the display has gone back to the first one
 
-    std::list<std::vector<unsigned short>> mSolutions;            // list of possible solutions
-    std::list<std::vector<unsigned short>>::iterator mSolutionIt;
+    SolutionCountCache* mSolutionsCache;
+    std::string mPuzzleKey;      // key of the puzzle in the cache, empty if it should not be cached
 
 public:
-    BruteForceSolver(BruteForceSolverThread* bruteForceThread, SudokuGrid* grid, bool* abortFlag);
+    BruteForceSolver(BruteForceSolverThread* bruteForceThread, SudokuGrid* grid, std::atomic<bool>* abortFlag);
+    ~BruteForceSolver();
 
 private:
-    Possibility PossibilityFromRowIndex(size_t row);
-    size_t IndexFromPossibility(CellId id, unsigned short value);
-    void FillIncidenceMatrix(bool** M, const size_t rows);
-    void SolveExactCoverProblem();
+    Possibility PossibilityFromRowIndex(size_t row) const;
+    size_t IndexFromPossibility(CellId id, unsigned short value) const;
+    bool IsPossibilityViable(const SudokuCell* cell, unsigned short value, bool useHints) const;
+    void FillRegionColumns(std::vector<std::vector<int>>& M, const Region* region, size_t firstColumn);
+    void FillIncidenceMatrix(std::vector<std::vector<int>>& M);
+    /// <summary>
+    /// Variable of the formula for a cell-candidate pair, the same as its row of the incidence matrix plus one
+    /// </summary>
+    int VariableFromPossibility(CellId id, unsigned short value) const;
+    std::vector<int> RegionVariablesGet(const Region* region, unsigned short value) const;
+    void FillFormula(CnfFormula& formula, bool useHints) const;
+    /// <summary>
+    /// Start the search again from the first solution
+    /// </summary>
+    void RestartSearch();
+    /// <summary>
+    /// Resume the search until the next solution. Returns false if there are no more solutions or the search has been aborted
+    /// </summary>
+    bool NextSolution(std::vector<unsigned short>* outSolution);
+    /// <summary>
+    /// Take the count and the solutions from the cache if it knows more than the searches so far,
+    /// and store in it what the searches know better
+    /// </summary>
+    void SyncSolutionsCache();
 
 public:
     void DirtySolutions();
+    void SearchEngineSet(SearchEngine engine);
+    /// <summary>
+    /// Look up and store the results of the searches in a cache, under the key of the current puzzle.
+    /// Must be called again whenever the grid changes.
+    /// </summary>
+    void SolutionsCacheSet(SolutionCountCache* cache, std::string puzzleKey);
     void GenerateIncidenceMatrix(bool useHints);
+    /// <summary>
+    /// Write the constraints of the grid as a DIMACS formula, for the standalone SAT solvers.
+    /// Does not change the state of the solver, so it can be called while a search is running.
+    /// </summary>
+    void WriteDimacs(std::ostream& stream, bool useHints) const;
+    /// <summary>
+    /// Count the solutions up to maxSolutionsCount, carrying on from the solutions already found
+    /// </summary>
     void CountSolutions(size_t maxSolutionsCount);
+    /// <summary>
+    /// Display the solution after the last one displayed, going back to the first one
+    /// after the last solution or after maxSolutionsCount solutions
+    /// </summary>
     void FindSolutions(size_t maxSolutionsCount);
 };
 
@@ -0,0 +1,87 @@
+#ifndef CANDIDATE_MASK_H
+#define CANDIDATE_MASK_H
+
+// Includes
+#include <cstdint>
+#include <set>
+
+/// <summary>
+/// Bit set of the digits that can go in a cell: digit d is stored in bit d-1.
+/// One word holds the digits of any grid up to 64x64.
+/// </summary>
+typedef std::uint64_t CandidateMask;
+
+static constexpr unsigned short kMaxMaskDigits = 64;
+
+constexpr CandidateMask CandidateBitGet(unsigned short value)
+{
+    return CandidateMask(1) << (value - 1);
+}
+
+/// <summary>
+/// Mask with all the digits from 1 to size
+/// </summary>
+constexpr CandidateMask AllCandidatesGet(unsigned short size)
+{
+    return size >= kMaxMaskDigits ? ~CandidateMask(0) : (CandidateMask(1) << size) - 1;
+}
+
+inline unsigned int CandidatesCountGet(CandidateMask mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned int>(__builtin_popcountll(mask));
+#else
+    unsigned int count = 0;
+    for (; mask; mask &= mask - 1)
+    {
+        ++count;
+    }
+    return count;
+#endif
+}
+
+/// <summary>
+/// Index of the lowest set bit. The word must not be zero.
+/// </summary>
+inline unsigned int LowestBitIndexGet(std::uint64_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned int>(__builtin_ctzll(word));
+#else
+    unsigned int index = 0;
+    for (; !(word & 1); word >>= 1)
+    {
+        ++index;
+    }
+    return index;
+#endif
+}
+
+inline std::set<unsigned short> CandidatesSetGet(CandidateMask mask)
+{
+    std::set<unsigned short> values;
+    for (unsigned short v = 1; mask; ++v, mask >>= 1)
+    {
+        if (mask & 1)
+        {
+            values.emplace_hint(values.end(), v);
+        }
+    }
+    return values;
+}
+
+/// <summary>
+/// Mask of the digits in a container of values
+/// </summary>
+template<class Container>
+CandidateMask CandidatesMaskGet(const Container& values)
+{
+    CandidateMask mask = 0;
+    for (const unsigned short v : values)
+    {
+        mask |= CandidateBitGet(v);
+    }
+    return mask;
+}
+
+#endif // CANDIDATE_MASK_H
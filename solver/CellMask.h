@@ -0,0 +1,123 @@
+#ifndef CELL_MASK_H
+#define CELL_MASK_H
+
+// Includes
+#include "Types.h"
+#include "CandidateMask.h"
+#include <array>
+#include <cassert>
+#include <cstdint>
+
+// Largest number of cells a mask can hold: every cell of a 36x36 grid
+static constexpr unsigned int kMaxMaskCells = 36 * 36;
+
+/// <summary>
+/// Bit set of cells, indexed by CellId or by the position of the cell in a region.
+/// The words are stored inline, so copying a mask is a plain memcpy
+/// </summary>
+class CellMask
+{
+    static constexpr unsigned int kMaxWords = (kMaxMaskCells + 63) / 64;
+
+    std::array<std::uint64_t, kMaxWords> mWords;
+    unsigned int mWordsCount;	// words in use: the loops below stop there
+
+public:
+    CellMask() :
+        mWords(),
+        mWordsCount(0)
+    {}
+    explicit CellMask(unsigned int cellsCount) :
+        mWords(),
+        mWordsCount((cellsCount + 63) / 64)
+    {
+        assert(cellsCount <= kMaxMaskCells);
+    }
+
+    void Set(CellId id)
+    {
+        mWords[id / 64] |= std::uint64_t(1) << (id % 64);
+    }
+
+    void Reset(CellId id)
+    {
+        mWords[id / 64] &= ~(std::uint64_t(1) << (id % 64));
+    }
+
+    bool Test(CellId id) const
+    {
+        return (mWords[id / 64] >> (id % 64)) & 1;
+    }
+
+    bool Any() const
+    {
+        for (unsigned int i = 0; i < mWordsCount; ++i)
+        {
+            if (mWords[i])
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void Clear()
+    {
+        mWords.fill(0);
+    }
+
+    CellMask& operator|=(const CellMask& other)
+    {
+        for (unsigned int i = 0; i < mWordsCount; ++i)
+        {
+            mWords[i] |= other.mWords[i];
+        }
+        return *this;
+    }
+
+    CellMask& operator&=(const CellMask& other)
+    {
+        for (unsigned int i = 0; i < mWordsCount; ++i)
+        {
+            mWords[i] &= other.mWords[i];
+        }
+        return *this;
+    }
+
+    /// <summary>
+    /// Call f(CellId) for every cell in the set, in increasing order of id
+    /// </summary>
+    template<class Function>
+    void ForEach(Function f) const
+    {
+        for (unsigned int i = 0; i < mWordsCount; ++i)
+        {
+            for (std::uint64_t w = mWords[i]; w; w &= w - 1)
+            {
+                f(static_cast<CellId>(i * 64 + LowestBitIndexGet(w)));
+            }
+        }
+    }
+
+    /// <summary>
+    /// Call f(CellId) for the cells in the set, in increasing order of id, until f returns true.
+    /// Returns whether it did
+    /// </summary>
+    template<class Predicate>
+    bool FindIf(Predicate f) const
+    {
+        for (unsigned int i = 0; i < mWordsCount; ++i)
+        {
+            for (std::uint64_t w = mWords[i]; w; w &= w - 1)
+            {
+                if (f(static_cast<CellId>(i * 64 + LowestBitIndexGet(w))))
+                {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+};
+
+#endif // CELL_MASK_H
@@ -0,0 +1,94 @@
+#include "CnfFormula.h"
+#include <cassert>
+#include <cstdlib>
+
+CnfFormula::CnfFormula() :
+    mVariablesCount(0),
+    mClauses(),
+    mAtMostOneGroups()
+{
+}
+
+int CnfFormula::VariablesCountGet() const
+{
+    return mVariablesCount;
+}
+
+const std::vector<std::vector<CnfFormula::Literal>>& CnfFormula::ClausesGet() const
+{
+    return mClauses;
+}
+
+const std::vector<std::vector<int>>& CnfFormula::AtMostOneGroupsGet() const
+{
+    return mAtMostOneGroups;
+}
+
+size_t CnfFormula::DimacsClausesCountGet() const
+{
+    size_t count = mClauses.size();
+    for (const auto& group : mAtMostOneGroups)
+    {
+        count += group.size() * (group.size() - 1) / 2;
+    }
+    return count;
+}
+
+void CnfFormula::WriteDimacs(std::ostream& stream, const std::vector<std::string>& comment) const
+{
+    for (const auto& line : comment)
+    {
+        stream << "c " << line << "\n";
+    }
+    stream << "p cnf " << mVariablesCount << " " << DimacsClausesCountGet() << "\n";
+
+    for (const auto& clause : mClauses)
+    {
+        for (const Literal l : clause)
+        {
+            stream << l << " ";
+        }
+        stream << "0\n";
+    }
+    for (const auto& group : mAtMostOneGroups)
+    {
+        for (size_t i = 0; i < group.size(); ++i)
+        {
+            for (size_t j = i + 1; j < group.size(); ++j)
+            {
+                stream << -group[i] << " " << -group[j] << " 0\n";
+            }
+        }
+    }
+}
+
+int CnfFormula::VariablesAdd(int count)
+{
+    assert(count > 0);
+    const int first = mVariablesCount + 1;
+    mVariablesCount += count;
+    return first;
+}
+
+void CnfFormula::ClauseAdd(std::vector<Literal> literals)
+{
+    for (const Literal l : literals)
+    {
+        assert(l != 0 && std::abs(l) <= mVariablesCount);
+    }
+    mClauses.push_back(std::move(literals));
+}
+
+void CnfFormula::AtMostOneAdd(std::vector<int> variables)
+{
+    if (variables.size() > 1)
+    {
+        mAtMostOneGroups.push_back(std::move(variables));
+    }
+}
+
+void CnfFormula::ExactlyOneAdd(const std::vector<int>& variables)
+{
+    ClauseAdd(variables);
+    AtMostOneAdd(variables);
+}
@@ -0,0 +1,55 @@
+#ifndef CNF_FORMULA_H
+#define CNF_FORMULA_H
+
+// Includes
+#include <ostream>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// Boolean formula in conjunctive normal form, with the variables numbered from 1.
+/// Groups of variables of which at most one can be true are kept apart from the clauses,
+/// so that a solver can propagate them directly instead of through a clause for each pair.
+/// </summary>
+class CnfFormula
+{
+public:
+    typedef int Literal;        // v if variable v is true, -v if it is false (DIMACS convention)
+
+private:
+    int mVariablesCount;
+    std::vector<std::vector<Literal>> mClauses;
+    std::vector<std::vector<int>> mAtMostOneGroups;
+
+public:
+// Constructors
+
+    CnfFormula();
+
+// Const methods
+
+    int VariablesCountGet() const;
+    const std::vector<std::vector<Literal>>& ClausesGet() const;
+    const std::vector<std::vector<int>>& AtMostOneGroupsGet() const;
+    /// <summary>
+    /// Number of clauses written by WriteDimacs, with the at most one groups expanded pairwise
+    /// </summary>
+    size_t DimacsClausesCountGet() const;
+    /// <summary>
+    /// Write the formula in the DIMACS format read by the standalone SAT solvers.
+    /// Each line of comment is written at the top, prefixed by "c ".
+    /// </summary>
+    void WriteDimacs(std::ostream& stream, const std::vector<std::string>& comment) const;
+
+// Non-const methods
+
+    /// <summary>
+    /// Add count new variables and return the first of them
+    /// </summary>
+    int VariablesAdd(int count);
+    void ClauseAdd(std::vector<Literal> literals);
+    void AtMostOneAdd(std::vector<int> variables);
+    void ExactlyOneAdd(const std::vector<int>& variables);
+};
+
+#endif // CNF_FORMULA_H
@@ -0,0 +1,618 @@
+#include "ConflictDrivenSolver.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+
+namespace
+{
+    const double kActivityDecay = 0.95;
+    const double kClauseActivityDecay = 0.999;
+    const double kActivityRescaleLimit = 1e100;
+    const size_t kRestartUnit = 100;                // conflicts in the first restart interval
+    const double kLearntLimitGrowth = 1.1;
+
+    // i-th term of the Luby sequence 1 1 2 1 1 2 4 1 1 2 1 1 2 4 8 ...
+    size_t Luby(size_t i)
+    {
+        size_t size = 1;
+        size_t exponent = 0;
+        while (size < i + 1)
+        {
+            size = 2 * size + 1;
+            ++exponent;
+        }
+        while (size - 1 != i)
+        {
+            size = (size - 1) / 2;
+            --exponent;
+            i = i % size;
+        }
+        return size_t(1) << exponent;
+    }
+}
+
+const size_t ConflictDrivenSolver::kDefaultLearntClausesLimit = 2000;
+
+ConflictDrivenSolver::ConflictDrivenSolver(const CnfFormula& formula):
+    mVariablesCount(static_cast<size_t>(formula.VariablesCountGet())),
+    mVariableGroups(mVariablesCount),
+    mGroupVariables(),
+    mClauses(),
+    mWatches(2 * mVariablesCount),
+    mLearntCount(0),
+    mLearntLimit(kDefaultLearntClausesLimit),
+    mClauseActivityIncrement(1),
+    mValues(mVariablesCount, 0),
+    mLevels(mVariablesCount, 0),
+    mReasons(mVariablesCount, {-1, -1}),
+    mTrail(),
+    mTrailLimits(),
+    mPropagated(0),
+    mActivity(mVariablesCount, 0),
+    mActivityIncrement(1),
+    mHeap(),
+    mHeapIndex(mVariablesCount, -1),
+    mSavedPhase(mVariablesCount, true),
+    mSeen(mVariablesCount, false),
+    mUnsatisfiable(false)
+{
+    mTrail.reserve(mVariablesCount);
+    mGroupVariables.reserve(formula.AtMostOneGroupsGet().size());
+    for (const auto& group : formula.AtMostOneGroupsGet())
+    {
+        const int index = static_cast<int>(mGroupVariables.size());
+        mGroupVariables.emplace_back();
+        for (const int v : group)
+        {
+            mGroupVariables.back().push_back(v - 1);
+            mVariableGroups[v - 1].push_back(index);
+        }
+    }
+
+    // variables in more groups propagate more, try them first
+    for (size_t v = 0; v < mVariablesCount; ++v)
+    {
+        mActivity[v] = 1e-3 * mVariableGroups[v].size();
+        HeapInsert(static_cast<int>(v));
+    }
+
+    std::vector<Literal> literals;
+    for (const auto& clause : formula.ClausesGet())
+    {
+        literals.clear();
+        for (const CnfFormula::Literal l : clause)
+        {
+            literals.push_back(LiteralGet(std::abs(l) - 1, l > 0));
+        }
+        if (!AddClause(literals, false))
+        {
+            mUnsatisfiable = true;
+            break;
+        }
+    }
+}
+
+signed char ConflictDrivenSolver::ValueGet(Literal literal) const
+{
+    const signed char value = mValues[VariableGet(literal)];
+    return (literal & 1) ? -value : value;
+}
+
+int ConflictDrivenSolver::DecisionLevelGet() const
+{
+    return static_cast<int>(mTrailLimits.size());
+}
+
+bool ConflictDrivenSolver::AddClause(std::vector<Literal> literals, bool learnt)
+{
+    assert(DecisionLevelGet() == 0);
+
+    // drop the literals already false, the clause is useless if one is already true
+    std::sort(literals.begin(), literals.end());
+    literals.erase(std::unique(literals.begin(), literals.end()), literals.end());
+    size_t kept = 0;
+    for (const Literal l : literals)
+    {
+        const signed char value = ValueGet(l);
+        if (value > 0)
+        {
+            return true;
+        }
+        if (value == 0)
+        {
+            literals[kept++] = l;
+        }
+    }
+    literals.resize(kept);
+
+    if (literals.empty())
+    {
+        return false;
+    }
+    if (literals.size() == 1)
+    {
+        Assign(literals[0], {-1, -1});
+        std::vector<Literal> conflict;
+        return Propagate(conflict);
+    }
+
+    const int index = static_cast<int>(mClauses.size());
+    mWatches[literals[0]].push_back(index);
+    mWatches[literals[1]].push_back(index);
+    mClauses.push_back({std::move(literals), 0, learnt});
+    mLearntCount += learnt ? 1 : 0;
+    return true;
+}
+
+void ConflictDrivenSolver::Assign(Literal literal, Reason reason)
+{
+    const int variable = VariableGet(literal);
+    assert(mValues[variable] == 0);
+    mValues[variable] = (literal & 1) ? -1 : 1;
+    mLevels[variable] = DecisionLevelGet();
+    mReasons[variable] = reason;
+    mTrail.push_back(literal);
+}
+
+bool ConflictDrivenSolver::Propagate(std::vector<Literal>& outConflict)
+{
+    while (mPropagated < mTrail.size())
+    {
+        const Literal p = mTrail[mPropagated++];
+        const int variable = VariableGet(p);
+
+        // a true variable rules out every other variable sharing one of its groups
+        if (!(p & 1))
+        {
+            for (const int g : mVariableGroups[variable])
+            {
+                for (const int other : mGroupVariables[g])
+                {
+                    if (other == variable)
+                    {
+                        continue;
+                    }
+                    if (mValues[other] > 0)
+                    {
+                        outConflict = {LiteralGet(variable, false), LiteralGet(other, false)};
+                        return false;
+                    }
+                    if (mValues[other] == 0)
+                    {
+                        Assign(LiteralGet(other, false), {-1, variable});
+                    }
+                }
+            }
+        }
+
+        // clauses watching the literal that has just become false
+        const Literal falseLiteral = Negate(p);
+        std::vector<int>& watches = mWatches[falseLiteral];
+        size_t kept = 0;
+        for (size_t i = 0; i < watches.size(); ++i)
+        {
+            const int index = watches[i];
+            std::vector<Literal>& literals = mClauses[index].mLiterals;
+            if (literals[0] == falseLiteral)
+            {
+                std::swap(literals[0], literals[1]);
+            }
+            watches[kept++] = index;
+            if (ValueGet(literals[0]) > 0)
+            {
+                continue;
+            }
+
+            // look for a new literal to watch
+            bool moved = false;
+            for (size_t k = 2; k < literals.size(); ++k)
+            {
+                if (ValueGet(literals[k]) >= 0)
+                {
+                    std::swap(literals[1], literals[k]);
+                    mWatches[literals[1]].push_back(index);
+                    --kept;
+                    moved = true;
+                    break;
+                }
+            }
+            if (moved)
+            {
+                continue;
+            }
+
+            if (ValueGet(literals[0]) < 0)
+            {
+                outConflict = literals;
+                for (++i; i < watches.size(); ++i)
+                {
+                    watches[kept++] = watches[i];
+                }
+                watches.resize(kept);
+                return false;
+            }
+            Assign(literals[0], {index, -1});
+        }
+        watches.resize(kept);
+    }
+    return true;
+}
+
+void ConflictDrivenSolver::ReasonLiteralsGet(int variable, std::vector<Literal>& outLiterals)
+{
+    const Reason& reason = mReasons[variable];
+    if (reason.mClause >= 0)
+    {
+        Clause& clause = mClauses[reason.mClause];
+        if (clause.mLearnt)
+        {
+            BumpClauseActivity(clause);
+        }
+        outLiterals = clause.mLiterals;
+    }
+    else
+    {
+        // ruled out by a true variable in the same group
+        assert(reason.mVariable >= 0);
+        outLiterals = {LiteralGet(variable, false), LiteralGet(reason.mVariable, false)};
+    }
+}
+
+void ConflictDrivenSolver::Analyze(const std::vector<Literal>& conflict, std::vector<Literal>& outLearnt, int& outBacktrackLevel)
+{
+    const int level = DecisionLevelGet();
+    outLearnt.assign(1, 0);     // the asserting literal is set at the end
+    std::vector<Literal> literals = conflict;
+    int pathCount = 0;
+    int implied = -1;
+    size_t index = mTrail.size();
+
+    // walk the trail back until a single literal of the current level is left (the first UIP)
+    for (;;)
+    {
+        for (const Literal q : literals)
+        {
+            const int variable = VariableGet(q);
+            if (variable == implied || mSeen[variable] || mLevels[variable] == 0)
+            {
+                continue;
+            }
+            mSeen[variable] = true;
+            BumpActivity(variable);
+            if (mLevels[variable] == level)
+            {
+                ++pathCount;
+            }
+            else
+            {
+                outLearnt.push_back(q);
+            }
+        }
+
+        do
+        {
+            --index;
+        }
+        while (!mSeen[VariableGet(mTrail[index])]);
+        implied = VariableGet(mTrail[index]);
+        mSeen[implied] = false;
+        if (--pathCount == 0)
+        {
+            break;
+        }
+        ReasonLiteralsGet(implied, literals);
+    }
+    outLearnt[0] = Negate(mTrail[index]);
+
+    // the learnt clause is asserting at the highest level among the other literals
+    outBacktrackLevel = 0;
+    for (size_t i = 1; i < outLearnt.size(); ++i)
+    {
+        mSeen[VariableGet(outLearnt[i])] = false;
+        if (mLevels[VariableGet(outLearnt[i])] > outBacktrackLevel)
+        {
+            outBacktrackLevel = mLevels[VariableGet(outLearnt[i])];
+            std::swap(outLearnt[1], outLearnt[i]);
+        }
+    }
+}
+
+void ConflictDrivenSolver::Backtrack(int level)
+{
+    if (DecisionLevelGet() <= level)
+    {
+        return;
+    }
+    const size_t limit = mTrailLimits[level];
+    for (size_t i = mTrail.size(); i-- > limit;)
+    {
+        const int variable = VariableGet(mTrail[i]);
+        mSavedPhase[variable] = mValues[variable] > 0;
+        mValues[variable] = 0;
+        mReasons[variable] = {-1, -1};
+        HeapInsert(variable);
+    }
+    mTrail.resize(limit);
+    mTrailLimits.resize(level);
+    mPropagated = limit;
+}
+
+void ConflictDrivenSolver::ReduceLearntClauses()
+{
+    // a clause is locked while it is the reason of an assignment
+    std::vector<bool> locked(mClauses.size(), false);
+    for (const Literal l : mTrail)
+    {
+        const int clause = mReasons[VariableGet(l)].mClause;
+        if (clause >= 0)
+        {
+            locked[clause] = true;
+        }
+    }
+
+    // drop the least active half of the learnt clauses, binary ones are cheap enough to keep
+    std::vector<int> candidates;
+    for (size_t i = 0; i < mClauses.size(); ++i)
+    {
+        if (mClauses[i].mLearnt && !locked[i] && mClauses[i].mLiterals.size() > 2)
+        {
+            candidates.push_back(static_cast<int>(i));
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(), [this](int a, int b)
+    {
+        return mClauses[a].mActivity < mClauses[b].mActivity;
+    });
+    std::vector<bool> removed(mClauses.size(), false);
+    for (size_t i = 0; i < candidates.size() / 2; ++i)
+    {
+        removed[candidates[i]] = true;
+    }
+
+    // compact the clauses and rebuild the watches
+    std::vector<int> newIndex(mClauses.size(), -1);
+    size_t kept = 0;
+    mLearntCount = 0;
+    for (size_t i = 0; i < mClauses.size(); ++i)
+    {
+        if (!removed[i])
+        {
+            newIndex[i] = static_cast<int>(kept);
+            mLearntCount += mClauses[i].mLearnt ? 1 : 0;
+            if (kept != i)
+            {
+                mClauses[kept] = std::move(mClauses[i]);
+            }
+            ++kept;
+        }
+    }
+    mClauses.resize(kept);
+    for (const Literal l : mTrail)
+    {
+        Reason& reason = mReasons[VariableGet(l)];
+        if (reason.mClause >= 0)
+        {
+            reason.mClause = newIndex[reason.mClause];
+        }
+    }
+    for (auto& watches : mWatches)
+    {
+        watches.clear();
+    }
+    for (size_t i = 0; i < mClauses.size(); ++i)
+    {
+        mWatches[mClauses[i].mLiterals[0]].push_back(static_cast<int>(i));
+        mWatches[mClauses[i].mLiterals[1]].push_back(static_cast<int>(i));
+    }
+
+    mLearntLimit = static_cast<size_t>(mLearntLimit * kLearntLimitGrowth);
+}
+
+ConflictDrivenSolver::Status ConflictDrivenSolver::Search(size_t conflictsBudget, const std::atomic<bool>* abort)
+{
+    size_t conflicts = 0;
+    std::vector<Literal> conflict;
+    std::vector<Literal> learnt;
+    for (;;)
+    {
+        if (abort && *abort)
+        {
+            return Status::Aborted;
+        }
+
+        if (!Propagate(conflict))
+        {
+            ++conflicts;
+            if (DecisionLevelGet() == 0)
+            {
+                return Status::Unsatisfiable;
+            }
+
+            int backtrackLevel;
+            Analyze(conflict, learnt, backtrackLevel);
+            Backtrack(backtrackLevel);
+            if (learnt.size() == 1)
+            {
+                Assign(learnt[0], {-1, -1});
+            }
+            else
+            {
+                const int index = static_cast<int>(mClauses.size());
+                mWatches[learnt[0]].push_back(index);
+                mWatches[learnt[1]].push_back(index);
+                mClauses.push_back({learnt, 0, true});
+                ++mLearntCount;
+                BumpClauseActivity(mClauses.back());
+                Assign(learnt[0], {index, -1});
+            }
+            mActivityIncrement /= kActivityDecay;
+            mClauseActivityIncrement /= kClauseActivityDecay;
+            continue;
+        }
+
+        if (conflicts >= conflictsBudget)
+        {
+            Backtrack(0);
+            return Status::Restart;
+        }
+        if (mLearntCount >= mLearntLimit + mTrail.size())
+        {
+            ReduceLearntClauses();
+        }
+
+        int variable = -1;
+        while (!mHeap.empty() && variable < 0)
+        {
+            const int candidate = HeapPop();
+            if (mValues[candidate] == 0)
+            {
+                variable = candidate;
+            }
+        }
+        if (variable < 0)
+        {
+            return Status::Satisfied;
+        }
+        mTrailLimits.push_back(mTrail.size());
+        Assign(LiteralGet(variable, mSavedPhase[variable]), {-1, -1});
+    }
+}
+
+void ConflictDrivenSolver::FindSolutions(std::list<Solution>& foundSolutions, size_t maxSolutionsCount, const std::atomic<bool>* abort)
+{
+    size_t found = 0;
+    size_t restarts = 0;
+    while (!mUnsatisfiable && found < maxSolutionsCount)
+    {
+        const Status status = Search(Luby(restarts++) * kRestartUnit, abort);
+        if (status == Status::Aborted)
+        {
+            Backtrack(0);
+            return;
+        }
+        if (status == Status::Unsatisfiable)
+        {
+            mUnsatisfiable = true;
+            return;
+        }
+        if (status == Status::Satisfied)
+        {
+            Solution solution;
+            std::vector<Literal> blocking;
+            for (size_t v = 0; v < mVariablesCount; ++v)
+            {
+                if (mValues[v] > 0)
+                {
+                    solution.push_back(v);
+                    blocking.push_back(LiteralGet(static_cast<int>(v), false));
+                }
+            }
+            foundSolutions.push_back(std::move(solution));
+            ++found;
+            restarts = 0;
+
+            // carry on from the top, with a nogood ruling out the solution just found
+            Backtrack(0);
+            mUnsatisfiable = !AddClause(std::move(blocking), false);
+        }
+    }
+}
+
+void ConflictDrivenSolver::BumpActivity(int variable)
+{
+    mActivity[variable] += mActivityIncrement;
+    if (mActivity[variable] > kActivityRescaleLimit)
+    {
+        for (auto& a : mActivity)
+        {
+            a /= kActivityRescaleLimit;
+        }
+        mActivityIncrement /= kActivityRescaleLimit;
+    }
+    if (mHeapIndex[variable] >= 0)
+    {
+        HeapPercolateUp(static_cast<size_t>(mHeapIndex[variable]));
+    }
+}
+
+void ConflictDrivenSolver::BumpClauseActivity(Clause& clause)
+{
+    clause.mActivity += mClauseActivityIncrement;
+    if (clause.mActivity > kActivityRescaleLimit)
+    {
+        for (auto& c : mClauses)
+        {
+            c.mActivity /= kActivityRescaleLimit;
+        }
+        mClauseActivityIncrement /= kActivityRescaleLimit;
+    }
+}
+
+void ConflictDrivenSolver::HeapInsert(int variable)
+{
+    if (mHeapIndex[variable] >= 0)
+    {
+        return;
+    }
+    mHeapIndex[variable] = static_cast<int>(mHeap.size());
+    mHeap.push_back(variable);
+    HeapPercolateUp(mHeap.size() - 1);
+}
+
+int ConflictDrivenSolver::HeapPop()
+{
+    const int top = mHeap.front();
+    mHeapIndex[top] = -1;
+    mHeap.front() = mHeap.back();
+    mHeap.pop_back();
+    if (!mHeap.empty())
+    {
+        mHeapIndex[mHeap.front()] = 0;
+        HeapPercolateDown(0);
+    }
+    return top;
+}
+
+void ConflictDrivenSolver::HeapPercolateUp(size_t index)
+{
+    const int variable = mHeap[index];
+    while (index > 0)
+    {
+        const size_t parent = (index - 1) / 2;
+        if (mActivity[mHeap[parent]] >= mActivity[variable])
+        {
+            break;
+        }
+        mHeap[index] = mHeap[parent];
+        mHeapIndex[mHeap[index]] = static_cast<int>(index);
+        index = parent;
+    }
+    mHeap[index] = variable;
+    mHeapIndex[variable] = static_cast<int>(index);
+}
+
+void ConflictDrivenSolver::HeapPercolateDown(size_t index)
+{
+    const int variable = mHeap[index];
+    for (;;)
+    {
+        size_t child = 2 * index + 1;
+        if (child >= mHeap.size())
+        {
+            break;
+        }
+        if (child + 1 < mHeap.size() && mActivity[mHeap[child + 1]] > mActivity[mHeap[child]])
+        {
+            ++child;
+        }
+        if (mActivity[mHeap[child]] <= mActivity[variable])
+        {
+            break;
+        }
+        mHeap[index] = mHeap[child];
+        mHeapIndex[mHeap[index]] = static_cast<int>(index);
+        index = child;
+    }
+    mHeap[index] = variable;
+    mHeapIndex[variable] = static_cast<int>(index);
+}
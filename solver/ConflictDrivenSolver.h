@@ -0,0 +1,112 @@
+#ifndef CONFLICT_DRIVEN_SOLVER_H
+#define CONFLICT_DRIVEN_SOLVER_H
+
+// Includes
+#include "CnfFormula.h"
+#include <atomic>
+#include <cstddef>
+#include <list>
+#include <vector>
+
+/// <summary>
+/// SAT solver for the formulas built by BruteForceSolver, alternative to dancing links.
+/// Besides the clauses, the at most one groups of the formula are propagated directly,
+/// without expanding them into binary clauses. The search learns a nogood from every conflict (first UIP),
+/// picks the variables by activity, restarts following the Luby sequence and periodically drops
+/// the least active nogoods, so that a conflict is not rediscovered in every branch of the search.
+/// Further solutions are found by adding a nogood that blocks each solution found.
+/// </summary>
+class ConflictDrivenSolver
+{
+public:
+    typedef std::vector<size_t> Solution;           // variables set to true, counted from 0
+
+    static const size_t kDefaultLearntClausesLimit;
+
+private:
+    typedef int Literal;                            // 2 * variable if the variable is true, 2 * variable + 1 if it is false
+
+    struct Clause
+    {
+        std::vector<Literal> mLiterals;             // the first two are watched
+        double mActivity;
+        bool mLearnt;
+    };
+
+    struct Reason
+    {
+        int mClause;                                // clause that implied the assignment, or -1
+        int mVariable;                              // if mClause is -1: true variable sharing an at most one group, or -1 for decisions
+    };
+
+    enum class Status
+    {
+        Satisfied,
+        Unsatisfiable,
+        Restart,
+        Aborted
+    };
+
+    const size_t mVariablesCount;
+    std::vector<std::vector<int>> mVariableGroups;  // at most one groups of each variable
+    std::vector<std::vector<int>> mGroupVariables;  // variables of each at most one group
+
+    std::vector<Clause> mClauses;                   // clauses of the formula, learnt nogoods and blocked solutions
+    std::vector<std::vector<int>> mWatches;         // clauses watching each literal
+    size_t mLearntCount;
+    size_t mLearntLimit;
+    double mClauseActivityIncrement;
+
+    std::vector<signed char> mValues;               // 1 true, -1 false, 0 unassigned
+    std::vector<int> mLevels;
+    std::vector<Reason> mReasons;
+    std::vector<Literal> mTrail;
+    std::vector<size_t> mTrailLimits;               // start of each decision level in the trail
+    size_t mPropagated;                             // literals of the trail already propagated
+
+    std::vector<double> mActivity;                  // variable activity, bumped when involved in a conflict
+    double mActivityIncrement;
+    std::vector<int> mHeap;                         // unassigned variables, most active first
+    std::vector<int> mHeapIndex;                    // position of each variable in mHeap, -1 if not in it
+    std::vector<bool> mSavedPhase;
+    std::vector<bool> mSeen;
+
+    bool mUnsatisfiable;
+
+    static Literal LiteralGet(int variable, bool value) { return 2 * variable + (value ? 0 : 1); }
+    static int VariableGet(Literal literal) { return literal >> 1; }
+    static Literal Negate(Literal literal) { return literal ^ 1; }
+    signed char ValueGet(Literal literal) const;
+    int DecisionLevelGet() const;
+
+    bool AddClause(std::vector<Literal> literals, bool learnt);
+    void Assign(Literal literal, Reason reason);
+    bool Propagate(std::vector<Literal>& outConflict);
+    void Analyze(const std::vector<Literal>& conflict, std::vector<Literal>& outLearnt, int& outBacktrackLevel);
+    void ReasonLiteralsGet(int variable, std::vector<Literal>& outLiterals);
+    void Backtrack(int level);
+    void ReduceLearntClauses();
+    Status Search(size_t conflictsBudget, const std::atomic<bool>* abort);
+
+    void BumpActivity(int variable);
+    void BumpClauseActivity(Clause& clause);
+    void HeapInsert(int variable);
+    int HeapPop();
+    void HeapPercolateUp(size_t index);
+    void HeapPercolateDown(size_t index);
+
+public:
+// Constructors
+
+    explicit ConflictDrivenSolver(const CnfFormula& formula);
+
+// Non-const methods
+
+    /// <summary>
+    /// Find up to maxSolutionsCount solutions, stopping early when abort is set.
+    /// Can be called again to look for further solutions.
+    /// </summary>
+    void FindSolutions(std::list<Solution>& foundSolutions, size_t maxSolutionsCount, const std::atomic<bool>* abort);
+};
+
+#endif // CONFLICT_DRIVEN_SOLVER_H
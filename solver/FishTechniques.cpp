@@ -44,7 +44,7 @@ bool FishTechnique::IsFishValid(RegionList& currentSet, CellList& fins, const Ce
 
         if (secondaryCellsSeeingFins.size() > 0)
         {
-            mGrid->ProgressManagerGet()->RegisterProgress(std::make_shared<Progress_FinnedFish>(mDefiningRegions, std::move(currentSet), std::move(fins), std::move(secondaryCellsSeeingFins), mCurrentValue));
+            mGrid->ProgressManagerGet()->RegisterProgress<Progress_FinnedFish>(mDefiningRegions, currentSet, fins, secondaryCellsSeeingFins, mCurrentValue);
             return true;
         }
     }
@@ -54,14 +54,14 @@ bool FishTechnique::IsFishValid(RegionList& currentSet, CellList& fins, const Ce
         // and therefore we have a legitimate fish. Cannibal cells can be checked now.
         if (cannibalCells.size() > 0)
         {
-            mGrid->ProgressManagerGet()->RegisterProgress(std::make_shared<Progress_CannibalFish>(mDefiningRegions, mDefiningCells, std::move(currentSet), std::move(cannibalCells), mCurrentValue));
+            mGrid->ProgressManagerGet()->RegisterProgress<Progress_CannibalFish>(mDefiningRegions, mDefiningCells, currentSet, cannibalCells, mCurrentValue);
             return true;
         }
         else if (secondaryCells.size() > mDefiningCells.size())
         {
             // is there at least one cell in the secondary set that is not in the defining set?
             // if not, this fish is pointless as it would not lead to any elimination
-            mGrid->ProgressManagerGet()->RegisterProgress(std::make_shared<Progress_Fish>(mDefiningRegions, mDefiningCells, std::move(currentSet), mCurrentValue));
+            mGrid->ProgressManagerGet()->RegisterProgress<Progress_Fish>(mDefiningRegions, mDefiningCells, currentSet, mCurrentValue);
             return true;
         }
     }
@@ -174,7 +174,7 @@ bool FishTechnique::SearchSecondaryFishRegionInner(CellList::const_iterator& cel
     else if(fins.size() == 0)
     {
         impossible = true;
-        mGrid->ProgressManagerGet()->RegisterProgress(std::make_shared<Impossible_Fish>(mDefiningRegions, std::move(currentSet), mCurrentValue, mGrid));
+        mGrid->ProgressManagerGet()->RegisterProgress<Impossible_Fish>(mDefiningRegions, currentSet, mCurrentValue);
         return false;
     }
 
@@ -189,7 +189,7 @@ bool FishTechnique::SearchSecondaryFishRegion()
 
 
     // The following map is used to map each region in the defining set to the secondary regions who share at least a fish cell
-    std::map<Region*, RegionSet> intersectionMapRegions;
+    std::map<Region*, RegionSet, RegionIdLess> intersectionMapRegions;
 
     // Find all the cells in the defining set that can accomodate value.
     // None of these cell can be shared between two or more regions of the defining set
@@ -276,7 +276,7 @@ void FishTechnique::GetPossibeDefiningRegionsInner(std::list<DefininfSet>& defin
     }
     else
     {
-        std::set<SudokuCell*> cells;
+        CellSet cells;
         for (const auto& r : nextSet)
         {
             const auto& c = (*r)->CellsWithValueGet(mCurrentValue);
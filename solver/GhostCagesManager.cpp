@@ -2,6 +2,7 @@
 #include "SudokuGrid.h"
 #include "SudokuCell.h"
 #include "RegionUpdatesManager.h"
+#include "RegionArena.h"
 #include <iterator>
 #include <algorithm>
 #include <cassert>
@@ -42,7 +43,7 @@ void GhostCagesManager::RegionsWithCellsGet(RegionSet &outSet, const CellSet &ce
         RegionSet group1(std::move(outSet));
         const RegionSet& group2 = RegionsWithCellGet(cell);
         outSet.clear();
-        std::set_intersection(group1.begin(), group1.end(), group2.begin(), group2.end(), std::inserter(outSet, outSet.begin()));
+        std::set_intersection(group1.begin(), group1.end(), group2.begin(), group2.end(), std::inserter(outSet, outSet.begin()), outSet.key_comp());
 
         if (outSet.size() == 0)
         {
@@ -51,7 +52,29 @@ void GhostCagesManager::RegionsWithCellsGet(RegionSet &outSet, const CellSet &ce
     }
 }
 
-void GhostCagesManager::PartitionRegionsWithCells(CellSet cells)
+void GhostCagesManager::RegionsWithCellsGet(RegionSet& outSet, const IdSpan& cells) const
+{
+    if (cells.empty())
+        return;
+
+    outSet = mCellToRegionsMap.at(cells.front());
+
+    // find the regions containing ALL the cells in the set
+    for (const CellId id : cells)
+    {
+        RegionSet group1(std::move(outSet));
+        const RegionSet& group2 = mCellToRegionsMap.at(id);
+        outSet.clear();
+        std::set_intersection(group1.begin(), group1.end(), group2.begin(), group2.end(), std::inserter(outSet, outSet.begin()), outSet.key_comp());
+
+        if (outSet.size() == 0)
+        {
+            break;
+        }
+    }
+}
+
+void GhostCagesManager::PartitionRegionsWithCells(const IdSpan& cells)
 {
     RegionSet outSplitRegions;
     RegionsWithCellsGet(outSplitRegions, cells);
@@ -69,32 +92,32 @@ void GhostCagesManager::PartitionRegionsWithCells(CellSet cells)
     }
 
     // check whether a region made up by these cells already exists
-    RegionSPtr regionSPtr;
-    for (const Region* r : outSplitRegions)
+    Region* leftNode = nullptr;
+    for (Region* r : outSplitRegions)
     {
         // region with these cells alreday exists
         if (r->CellsGet().size() == cells.size() && !r->IsStartingRegion())
         {
-            regionSPtr = RegionSharedPtrGet(r);
+            leftNode = r;
             break;
         }
     }
-    if (!regionSPtr) // create a new Region
+    if (!leftNode) // create a new Region
     {
-        regionSPtr = std::make_shared<Region>(mParentGrid, std::move(cells), false);
+        leftNode = mParentGrid->RegionArenaGet()->Create(mParentGrid, cells, false);
     }
 
     for (Region* r : outSplitRegions)
     {
-        PartitionRegionWithCells(regionSPtr, r);
+        PartitionRegionWithCells(leftNode, r);
     }
 }
 
-void GhostCagesManager::PartitionRegionWithCells(const RegionSPtr &regionSPtr, Region *region)
+void GhostCagesManager::PartitionRegionWithCells(Region* leftNode, Region* region)
 {
     assert(region->IsLeafNode());
     Region* newRegion;
-    bool success = region->PartitionRegion(regionSPtr, newRegion);
+    bool success = region->PartitionRegion(leftNode, newRegion);
 
     if (success)
     {
@@ -103,9 +126,9 @@ void GhostCagesManager::PartitionRegionWithCells(const RegionSPtr &regionSPtr, R
         {
             mLeafRegions.insert(newRegion);
         }
-        if (regionSPtr)
+        if (leftNode)
         {
-            mLeafRegions.insert(regionSPtr.get());
+            mLeafRegions.insert(leftNode);
         }
         // update the cell to regions map
         for (SudokuCell* c : region->CellsGet())
@@ -116,9 +139,9 @@ void GhostCagesManager::PartitionRegionWithCells(const RegionSPtr &regionSPtr, R
             {
                 regionsWithCell.insert(newRegion);
             }
-            else if (regionSPtr && regionSPtr->CellsGet().count(c) > 0)
+            else if (leftNode && leftNode->CellsGet().count(c) > 0)
             {
-                regionsWithCell.insert(regionSPtr.get());
+                regionsWithCell.insert(leftNode);
             }
         }
 
@@ -156,7 +179,7 @@ void GhostCagesManager::PartitionRegionWithCells(const RegionSPtr &regionSPtr, R
 
             for (Region* r : outSplitRegions)
             {
-                r->MergeRegions(RegionSharedPtrGet(newRegion));
+                r->MergeRegions(newRegion);
                 mLeafRegions.erase(r);
                 // update the cell to regions map
                 for (SudokuCell* c : newRegion->CellsGet())
@@ -169,14 +192,12 @@ void GhostCagesManager::PartitionRegionWithCells(const RegionSPtr &regionSPtr, R
     }
 }
 
-void GhostCagesManager::RegisterRegion(RegionSPtr regionSPtr)
+void GhostCagesManager::RegisterRegion(Region* region)
 {
-    Region* region = regionSPtr.get();
     // Add region to the starting regions if it's not there already
-    auto it = std::find_if(mGhostCages.begin(), mGhostCages.end(), [=](const RegionSPtr& r) { return region == r.get(); });
-    if (it == mGhostCages.end())
+    if (std::find(mGhostCages.begin(), mGhostCages.end(), region) == mGhostCages.end())
     {
-        mGhostCages.emplace_back(regionSPtr);
+        mGhostCages.emplace_back(region);
     }
 
     // add the group to the list
@@ -191,7 +212,7 @@ void GhostCagesManager::RegisterRegion(RegionSPtr regionSPtr)
     // then the former can be partitioned.
     // Any additional constraint needs to be already attached
     // to the region at this point.
-    std::list<RegionSPtr> subsets;
+    std::list<Region*> subsets;
     Region* congruentRegion = nullptr;
     for (Region* r : mLeafRegions)
     {
@@ -203,18 +224,19 @@ void GhostCagesManager::RegisterRegion(RegionSPtr regionSPtr)
             }
             else if(r->IsClosed())
             {
-                subsets.push_back(RegionSharedPtrGet(r));
+                subsets.push_back(r);
             }
         }
     }
     if (subsets.size() > 0)
     {
-        for (const RegionSPtr& sub : subsets)
+        for (Region* sub : subsets)
         {
-            region->UpdateManagerGet()->OnNakedSetFound(sub->CellsGet(), sub->ConfirmedValuesGet(), false);
+            const std::vector<CellId> subCells = sub->CellIdsGet();
+            region->UpdateManagerGet()->OnNakedSetFound(IdSpan(subCells), sub->ConfirmedValuesGet(), false);
             if (sub->IsStartingRegion())
             {
-                PartitionRegionsWithCells(sub->CellsGet());
+                PartitionRegionsWithCells(IdSpan(subCells));
             }
             else if(sub->IsLeafNode())
             {
@@ -235,7 +257,7 @@ void GhostCagesManager::RegisterRegion(RegionSPtr regionSPtr)
         }
         else
         {
-            region->MergeRegions(RegionSharedPtrGet(congruentRegion));
+            region->MergeRegions(congruentRegion);
             mLeafRegions.erase(region);
             // update the cell to regions map
             for (SudokuCell* c : region->CellsGet())
@@ -281,18 +303,3 @@ void GhostCagesManager::RestoreSnapshot()
         }
     }
 }
-
-RegionSPtr GhostCagesManager::RegionSharedPtrGet(const Region *r) const
-{
-    RegionSPtr regionSPtr;
-    regionSPtr = r->RegionSharedPtrGet();
-    if (regionSPtr.get() == nullptr) // the region is one of the starting regions
-    {
-        auto it = std::find_if(mGhostCages.begin(), mGhostCages.end(), [=](RegionSPtr s_ptr) {return s_ptr.get() == r; });
-        if (it != mGhostCages.end())
-        {
-            regionSPtr = *it;
-        }
-    }
-    return regionSPtr;
-}
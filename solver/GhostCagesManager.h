@@ -4,23 +4,24 @@
 // Include
 #include "Types.h"
 #include "Region.h"
+#include "IdSpan.h"
 
 // Typedefs
 typedef std::vector<RegionSet> CellToRegionMap;
 
 class GhostCagesManager
 {
-    std::list<RegionSPtr> mGhostCages;
+    std::list<Region*> mGhostCages;
     RegionSet mLeafRegions;				// list of all leaf regions (see Region class)
     CellToRegionMap mCellToRegionsMap;	// maps each cell in the grid to the regions that cell is in
     SudokuGrid* mParentGrid;			// pointer to the grid the cell belongs to
 
     struct Snapshot
     {
-        std::list<RegionSPtr> mGhostCages;
+        std::list<Region*> mGhostCages;
         RegionSet mLeafRegions;
         CellToRegionMap mCellToRegionsMap;
-        Snapshot(const std::list<RegionSPtr> ghostCages, const RegionSet& leaves, const CellToRegionMap& map):
+        Snapshot(const std::list<Region*>& ghostCages, const RegionSet& leaves, const CellToRegionMap& map):
             mGhostCages(ghostCages),
             mLeafRegions(leaves),
             mCellToRegionsMap(map)
@@ -46,6 +47,7 @@ public:
     /// Finds a returns all the regions cantaining all the cells passed as parameters.
     /// </summary>
     void RegionsWithCellsGet(RegionSet& outSet, const CellSet& cells) const;
+    void RegionsWithCellsGet(RegionSet& outSet, const IdSpan& cells) const;
 
 // Non-constant methods
 
@@ -55,12 +57,12 @@ public:
     /// one made up by the cells in the argument and the other made up by
     /// the remaining cells.
     /// </summary>
-    void PartitionRegionsWithCells(CellSet cells);
+    void PartitionRegionsWithCells(const IdSpan& cells);
 
     /// <summary>
     /// Define a staring region of the puzzle
     /// </summary>
-    void RegisterRegion(RegionSPtr regionSPtr);
+    void RegisterRegion(Region* region);
 
     /// <summary>
     /// Clear all the starting regions
@@ -71,14 +73,12 @@ public:
     void RestoreSnapshot();
 
 private:
-    RegionSPtr RegionSharedPtrGet(const Region* r) const;
-
     /// <summary>
     /// Partition the argument region into two new smaller regions,
-    /// one made up by the cells in the argument regionSPtr and the other
-    /// made up by theremaining cells.
+    /// one made up by the cells in the argument leftNode and the other
+    /// made up by the remaining cells.
     /// </summary>
-    void PartitionRegionWithCells(const RegionSPtr& regionSPtr, Region* region);
+    void PartitionRegionWithCells(Region* leftNode, Region* region);
 };
 
 #endif // GHOSTCAGESMANAGER_H
@@ -3,16 +3,68 @@
 #include "Region.h"
 #include "RegionUpdatesManager.h"
 #include "SudokuGrid.h"
-#include "../sudokusolverthread.h"
+#include "SolverObserver.h"
+#include "TranspositionTable.h"
+#include "Trace.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+SolveStatistics::SolveStatistics() :
+    mTechniqueSteps(static_cast<size_t>(TechniqueType::MAX_TECHNIQUES), 0),
+    mProgressCounts(static_cast<size_t>(ProgressType::MAX_PROGRESS_TYPES), 0),
+    mMaxBifurcationDepth(0)
+{
+}
+
+void SolveStatistics::Clear()
+{
+    std::fill(mTechniqueSteps.begin(), mTechniqueSteps.end(), 0);
+    std::fill(mProgressCounts.begin(), mProgressCounts.end(), 0);
+    mMaxBifurcationDepth = 0;
+}
+
+TechniqueCost::TechniqueCost() :
+    mMicroseconds(0),
+    mYield(0),
+    mSteps(0),
+    mMisses(0)
+{
+}
+
+void TechniqueCost::RecordStep(double microseconds, size_t deductions)
+{
+    // exponential moving average, so that the estimates follow the puzzle being solved
+    const double weight = mSteps < 8 ? 1.0 / (mSteps + 1) : 0.125;
+    mMicroseconds += (microseconds - mMicroseconds) * weight;
+    mYield += (static_cast<double>(deductions) - mYield) * weight;
+    ++mSteps;
+    if (deductions > 0)
+    {
+        mMisses = 0;
+    }
+}
+
+double TechniqueCost::ScoreGet() const
+{
+    // the small constants keep techniques that have not found anything yet in the running
+    const double score = (mYield + 0.01) / (mMicroseconds + 0.1);
+    return std::ldexp(score, -static_cast<int>(std::min(mMisses, 16u)));
+}
 
 GridProgressManager::GridProgressManager(SudokuGrid* sudoku) :
     mSudokuGrid(sudoku),
+    mProgressPool(sudoku),
     mProgressQueue(),
+    mHighPriorityProgressQueue(),
     mTechniques(static_cast<size_t>(TechniqueType::MAX_TECHNIQUES)),
     mTechniqueActive(static_cast<size_t>(TechniqueType::MAX_TECHNIQUES), true),
+    mTechniqueCosts(static_cast<size_t>(TechniqueType::MAX_TECHNIQUES)),
+    mSchedulingMode(SchedulingMode::FixedOrder),
     mCurrentTechnique(static_cast<TechniqueType>(0)),
     mFinished(false),
-    mAbort(false)
+    mAbort(false),
+    mStatistics()
 {
     mTechniques[static_cast<size_t>(TechniqueType::LockedCandidates)] =
         std::make_unique<LockedCandidatesTechnique>(mSudokuGrid, SolvingTechnique::ObserveValues);
@@ -38,11 +90,18 @@ GridProgressManager::GridProgressManager(SudokuGrid* sudoku) :
         BifurcationTechnique* bifurcation = static_cast<BifurcationTechnique*>(technique.get());
         depth = bifurcation->DepthGet() + 1;
         targetDepth = bifurcation->TargetDepthGet();
+        mSchedulingMode = parent->ProgressManagerGet()->mSchedulingMode;
+        mTechniqueCosts = parent->ProgressManagerGet()->mTechniqueCosts;
     }
     mTechniques[static_cast<size_t>(TechniqueType::Bifurcation)] =
         std::make_unique<BifurcationTechnique>(mSudokuGrid, SolvingTechnique::ObserveNothing, depth, targetDepth);
 }
 
+GridProgressManager::~GridProgressManager()
+{
+    Clear();
+}
+
 const SolvingTechnique* GridProgressManager::TechniqueGet(TechniqueType type) const
 {
     return mTechniques[static_cast<size_t>(type)].get();
@@ -53,8 +112,8 @@ bool GridProgressManager::HasFinished() const
     return  mAbort ||
             (
                 mFinished &&
-                mHighPriorityProgressQueue.empty() &&
-                mProgressQueue.empty()
+                mHighPriorityProgressQueue.Empty() &&
+                mProgressQueue.Empty()
                 );
 }
 
@@ -63,16 +122,19 @@ bool GridProgressManager::HasAborted() const
     return mAbort;
 }
 
-void GridProgressManager::RegisterProgress(std::shared_ptr<Progress>&& deduction)
+const SolveStatistics& GridProgressManager::StatisticsGet() const
 {
-    if (deduction->isHighPriotity())
-    {
-        mHighPriorityProgressQueue.push(deduction);
-    }
-    else
-    {
-        mProgressQueue.push(deduction);
-    }
+    return mStatistics;
+}
+
+const TechniqueCost& GridProgressManager::TechniqueCostGet(TechniqueType type) const
+{
+    return mTechniqueCosts[static_cast<size_t>(type)];
+}
+
+SchedulingMode GridProgressManager::SchedulingModeGet() const
+{
+    return mSchedulingMode;
 }
 
 void GridProgressManager::RegisterFailure(TechniqueType type, Region* region, SudokuCell* cell /* = nullptr */, unsigned short value /* = 0 */)
@@ -93,62 +155,109 @@ void GridProgressManager::RegisterFailure(TechniqueType type, Region* region, Su
 
 void  GridProgressManager::NextStep()
 {
+    SUDOKU_TRACE_SCOPE("GridProgressManager::NextStep");
     if(mAbort)
     {
         return;
     }
 
-    if (!mHighPriorityProgressQueue.empty())
+    if (!mHighPriorityProgressQueue.Empty() || !mProgressQueue.Empty())
     {
         Reset();
-        mHighPriorityProgressQueue.front()->ProcessProgress();
-        mHighPriorityProgressQueue.pop();
+        ProcessNextProgress();
     }
-    else if (!mProgressQueue.empty())
+    else if (!mAbort && !mFinished)
     {
+        NextTechnique();
+    }
+
+    CheckSolved();
+}
+
+void GridProgressManager::NextBatch()
+{
+    if(mAbort)
+    {
+        return;
+    }
+
+    if (!mHighPriorityProgressQueue.Empty() || !mProgressQueue.Empty())
+    {
+        // no technique runs until the queues are empty,
+        // so the techniques only need to be sent back to the start once
         Reset();
-        mProgressQueue.front()->ProcessProgress();
-        mProgressQueue.pop();
+        while (!mAbort && ProcessNextProgress())
+        {
+        }
     }
-    else if (!mAbort && !mFinished)
+    else if (!mFinished)
     {
         NextTechnique();
     }
 
+    CheckSolved();
+}
+
+bool GridProgressManager::ProcessNextProgress()
+{
+    ProgressQueue* queue = nullptr;
+    if (!mHighPriorityProgressQueue.Empty())
+    {
+        queue = &mHighPriorityProgressQueue;
+    }
+    else if (!mProgressQueue.Empty())
+    {
+        queue = &mProgressQueue;
+    }
+    else
+    {
+        return false;
+    }
+
+    // pop before processing: the deduction may queue further progress
+    Progress* progress = queue->Front();
+    queue->Pop();
+    const ProgressType type = progress->TypeGet();
+    ++mStatistics.mProgressCounts[static_cast<size_t>(type)];
+    {
+        SUDOKU_TRACE_SCOPE_ARG("Progress::ProcessProgress", "type", type);
+        progress->ProcessProgress();
+    }
+    mProgressPool.Destroy(progress);
+    return true;
+}
+
+void GridProgressManager::CheckSolved()
+{
     if(mSudokuGrid->IsSolved())
     {
-        while(!mHighPriorityProgressQueue.empty())
-        {
-            Reset();
-            mHighPriorityProgressQueue.front()->ProcessProgress();
-            mHighPriorityProgressQueue.pop();
-        }
-        while(!mProgressQueue.empty())
+        Reset();
+        while(ProcessNextProgress())
         {
-            Reset();
-            mProgressQueue.front()->ProcessProgress();
-            mProgressQueue.pop();
         }
         mFinished = true;
 
-        if(mSudokuGrid->ParentNodeGet() == nullptr)
+        if(mSudokuGrid->ParentNodeGet() == nullptr && mSudokuGrid->ObserverGet())
         {
-            mSudokuGrid->SolverThreadGet()->NotifyLogicalDeduction("Puzzle Solved!");
+            mSudokuGrid->ObserverGet()->NotifyLogicalDeduction("Puzzle Solved!");
         }
     }
 }
 
 void GridProgressManager::Clear()
 {
+    while (!mProgressQueue.Empty())
     {
-        std::queue<std::shared_ptr<Progress>> empty;
-        std::swap(mProgressQueue, empty);
+        mProgressPool.Destroy(mProgressQueue.Front());
+        mProgressQueue.Pop();
     }
+    while (!mHighPriorityProgressQueue.Empty())
     {
-        std::queue<std::shared_ptr<Progress>> empty;
-        std::swap(mHighPriorityProgressQueue, empty);
+        mProgressPool.Destroy(mHighPriorityProgressQueue.Front());
+        mHighPriorityProgressQueue.Pop();
     }
     mAbort = false;
+    mStatistics.Clear();
     Reset();
 }
 
@@ -170,15 +279,45 @@ void GridProgressManager::Abort()
 
 void GridProgressManager::TechniqueActiveSet(TechniqueType t, bool enable)
 {
+    if (mTechniqueActive[static_cast<size_t>(t)] == enable)
+    {
+        return;
+    }
     mTechniqueActive[static_cast<size_t>(t)] = enable;
+
+    // the cached bifurcation results were reached with the previous set of techniques
+    TranspositionTable* table = mSudokuGrid->TranspositionTableGet();
+    if (table)
+    {
+        table->Clear();
+    }
+}
+
+void GridProgressManager::SchedulingModeSet(SchedulingMode mode)
+{
+    mSchedulingMode = mode;
 }
 
 void GridProgressManager::NextTechnique()
 {
+    if (mSchedulingMode == SchedulingMode::Adaptive)
+    {
+        mCurrentTechnique = ScheduledTechniqueGet();
+        if (mCurrentTechnique == TechniqueType::MAX_TECHNIQUES)
+        {
+            mFinished = true;
+        }
+        else
+        {
+            RunTechnique(static_cast<size_t>(mCurrentTechnique));
+        }
+        return;
+    }
+
     size_t index = static_cast<size_t>(mCurrentTechnique);
     if(mTechniqueActive[index])
     {
-        mTechniques.at(index)->NextStep();
+        RunTechnique(index);
     }
 
     if (mTechniques.at(index)->HasFinished() ||
@@ -192,3 +331,79 @@ void GridProgressManager::NextTechnique()
         }
     }
 }
+
+void GridProgressManager::RunTechnique(size_t index)
+{
+    // only the adaptive scheduler reads the costs, so the fixed order does not time the steps
+    const bool measure = mSchedulingMode == SchedulingMode::Adaptive;
+    std::chrono::steady_clock::time_point start;
+    if (measure)
+    {
+        start = std::chrono::steady_clock::now();
+    }
+    {
+        SUDOKU_TRACE_SCOPE_ARG("SolvingTechnique::NextStep", "technique", mTechniques.at(index)->TypeGet());
+        mTechniques.at(index)->NextStep();
+    }
+    // techniques only run when the queues are empty
+    const size_t deductions = mHighPriorityProgressQueue.Size() + mProgressQueue.Size();
+
+    if (deductions > 0)
+    {
+        ++mStatistics.mTechniqueSteps[index];
+        if (static_cast<TechniqueType>(index) == TechniqueType::Bifurcation)
+        {
+            const auto* bifurcation = static_cast<const BifurcationTechnique*>(mTechniques.at(index).get());
+            mStatistics.mMaxBifurcationDepth = std::max(mStatistics.mMaxBifurcationDepth, bifurcation->TargetDepthGet());
+        }
+    }
+
+    if (measure)
+    {
+        const std::chrono::duration<double, std::micro> duration = std::chrono::steady_clock::now() - start;
+        TechniqueCost& cost = mTechniqueCosts[index];
+        cost.RecordStep(duration.count(), deductions);
+        if (deductions == 0 && mTechniques.at(index)->HasFinished())
+        {
+            // a whole pass over the regions the technique observes found nothing
+            ++cost.mMisses;
+        }
+    }
+}
+
+TechniqueType GridProgressManager::ScheduledTechniqueGet() const
+{
+    TechniqueType best = TechniqueType::MAX_TECHNIQUES;
+    double bestScore = 0;
+    for (size_t i = 0; i < mTechniques.size(); ++i)
+    {
+        const TechniqueType type = static_cast<TechniqueType>(i);
+        if (type == TechniqueType::Bifurcation || !mTechniqueActive[i] || mTechniques[i]->HasFinished())
+        {
+            continue;
+        }
+
+        // techniques that have never run are tried first, in order
+        const TechniqueCost& cost = mTechniqueCosts[i];
+        if (cost.mSteps == 0)
+        {
+            return type;
+        }
+        const double score = cost.ScoreGet();
+        if (best == TechniqueType::MAX_TECHNIQUES || score > bestScore)
+        {
+            best = type;
+            bestScore = score;
+        }
+    }
+
+    // only escalate to bifurcation once the cheap techniques are exhausted
+    const size_t bifurcation = static_cast<size_t>(TechniqueType::Bifurcation);
+    if (best == TechniqueType::MAX_TECHNIQUES &&
+        mTechniqueActive[bifurcation] &&
+        !mTechniques[bifurcation]->HasFinished())
+    {
+        best = TechniqueType::Bifurcation;
+    }
+    return best;
+}
@@ -4,9 +4,49 @@
 #include "Types.h"
 #include "Progress.h"
 #include "SolvingTechnique.h"
-#include <queue>
+#include "ProgressPool.h"
 #include <functional>
 
+/// <summary>
+/// Record of the techniques and deductions used on a grid
+/// </summary>
+struct SolveStatistics
+{
+    std::vector<unsigned int> mTechniqueSteps;  // steps of each technique that found some progress
+    std::vector<unsigned int> mProgressCounts;  // deductions processed, per ProgressType
+    unsigned int mMaxBifurcationDepth;          // deepest bifurcation that found some progress
+
+    SolveStatistics();
+    void Clear();
+};
+
+/// <summary>
+/// Order in which the techniques are tried once the progress queues are empty
+/// </summary>
+enum class SchedulingMode
+{
+    FixedOrder,     // restart from the first technique after any progress. Gives reproducible explanations
+    Adaptive        // try first the technique expected to find the most deductions per microsecond
+};
+
+/// <summary>
+/// Running averages of the cost and yield of a technique, learned while solving
+/// </summary>
+struct TechniqueCost
+{
+    double mMicroseconds;   // average duration of a step
+    double mYield;          // average number of deductions queued by a step
+    unsigned int mSteps;    // number of steps measured
+    unsigned int mMisses;   // consecutive passes that ran to the end without finding anything
+
+    TechniqueCost();
+    void RecordStep(double microseconds, size_t deductions);
+    /// <summary>
+    /// Expected deductions per microsecond, halved for every consecutive miss
+    /// </summary>
+    double ScoreGet() const;
+};
+
 /// <summary>
 /// Deals with notifying relevant Regions when new progress
 /// has been made on the grid.
@@ -14,31 +54,62 @@
 class GridProgressManager
 {
     SudokuGrid* mSudokuGrid;
-    std::queue<std::shared_ptr<Progress>> mProgressQueue;
-    std::queue<std::shared_ptr<Progress>> mHighPriorityProgressQueue;
+    ProgressPool mProgressPool;             // owns the pending progress
+    ProgressQueue mProgressQueue;
+    ProgressQueue mHighPriorityProgressQueue;
 
     std::vector<std::unique_ptr<SolvingTechnique>> mTechniques;
     std::vector<bool> mTechniqueActive;
+    std::vector<TechniqueCost> mTechniqueCosts;
+    SchedulingMode mSchedulingMode;
     TechniqueType mCurrentTechnique;
     bool mFinished;
     bool mAbort;
+    SolveStatistics mStatistics;
 
 public:
 // Constructors
 
     GridProgressManager(SudokuGrid* sudoku);
+    ~GridProgressManager();
 
 // Const methods
     const SolvingTechnique* TechniqueGet(TechniqueType type) const;
     bool HasFinished() const;
     bool HasAborted() const;
+    const SolveStatistics& StatisticsGet() const;
+    const TechniqueCost& TechniqueCostGet(TechniqueType type) const;
+    SchedulingMode SchedulingModeGet() const;
 
 // Non-const methods
 
-    void RegisterProgress(std::shared_ptr<Progress>&& deduction);
+    /// <summary>
+    /// Construct a new deduction of type T in the progress pool and queue it
+    /// </summary>
+    template<class T, class... Args>
+    void RegisterProgress(Args&&... args)
+    {
+        Progress* deduction = mProgressPool.Create<T>(std::forward<Args>(args)...);
+        if (deduction->isHighPriotity())
+        {
+            mHighPriorityProgressQueue.Push(deduction);
+        }
+        else
+        {
+            mProgressQueue.Push(deduction);
+        }
+    }
+
     void RegisterFailure(TechniqueType type, Region* region, SudokuCell* cell = nullptr, unsigned short value = 0);
     void NextStep();
 
+    /// <summary>
+    /// Process all the pending progress in one go. The techniques are only
+    /// resumed once both queues have been emptied.
+    /// If there is no pending progress, this is equivalent to NextStep()
+    /// </summary>
+    void NextBatch();
+
     /// <summary>
     /// Clear the progress queues
     /// </summary>
@@ -57,11 +128,27 @@ public:
     void Abort();
 
     /// <summary>
-    /// Enable/disable a technique
+    /// Enable/disable a technique.
+    /// Changing the set of active techniques clears the cached bifurcation results
     /// </summary>
     void TechniqueActiveSet(TechniqueType t, bool enable);
+
+    /// <summary>
+    /// Choose how the next technique is picked, FixedOrder by default. Child grids created
+    /// by bifurcation inherit the mode and the learned costs of their parent
+    /// </summary>
+    void SchedulingModeSet(SchedulingMode mode);
 private:
     void NextTechnique();
+    void RunTechnique(size_t index);
+    /// <summary>
+    /// Pick the active technique with the best score that has not finished yet.
+    /// Bifurcation is only picked once all the others have finished.
+    /// Returns MAX_TECHNIQUES if there is nothing left to try
+    /// </summary>
+    TechniqueType ScheduledTechniqueGet() const;
+    bool ProcessNextProgress();
+    void CheckSolved();
 };
 
 
@@ -0,0 +1,35 @@
+#ifndef ID_SPAN_H
+#define ID_SPAN_H
+
+// Includes
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+/// <summary>
+/// Read-only view of a run of cell or region ids, stored elsewhere (see ProgressPool).
+/// The ids are kept in the order they were stored in
+/// </summary>
+class IdSpan
+{
+    const unsigned int* mData;
+    unsigned int mSize;
+
+public:
+    IdSpan() : mData(nullptr), mSize(0) {}
+    IdSpan(const unsigned int* data, unsigned int size) : mData(data), mSize(size) {}
+    explicit IdSpan(const std::vector<unsigned int>& ids) : mData(ids.data()), mSize(static_cast<unsigned int>(ids.size())) {}
+
+    const unsigned int* begin() const { return mData; }
+    const unsigned int* end() const { return mData + mSize; }
+    unsigned int size() const { return mSize; }
+    bool empty() const { return mSize == 0; }
+    unsigned int front() const { return mData[0]; }
+
+    bool Contains(unsigned int id) const
+    {
+        return std::find(begin(), end(), id) != end();
+    }
+};
+
+#endif // ID_SPAN_H
@@ -6,6 +6,21 @@
 #include "GridProgressManager.h"
 #include "GhostCagesManager.h"
 #include "SudokuCell.h"
+#include <algorithm>
+
+bool KillerConstraintLess::operator()(const KillerConstraint* a, const KillerConstraint* b) const
+{
+    return RegionIdLess()(a->RegionGet(), b->RegionGet());
+}
+
+bool KillerCageLess::operator()(const std::pair<unsigned int, CellSet>& a, const std::pair<unsigned int, CellSet>& b) const
+{
+    if (a.first != b.first)
+    {
+        return a.first < b.first;
+    }
+    return std::lexicographical_compare(a.second.begin(), a.second.end(), b.second.begin(), b.second.end(), CellIdLess());
+}
 
 void InniesAndOuties::SearchInnies()
 {
@@ -40,7 +55,7 @@ void InniesAndOuties::SearchInniesInner(KillerCage_t& unionCage)
     int ghostCageTotal = static_cast<int>(mCurrentRegionTotal) - static_cast<int>(unionCage.first);
     if(ghostCageTotal < 0 || (ghostCageTotal == 0 && cells.size() > 0))
     {
-        mGrid->ProgressManagerGet()->RegisterProgress(std::make_shared<Impossible_BrokenInnie>(std::move(cells), mGrid));
+        mGrid->ProgressManagerGet()->RegisterProgress<Impossible_BrokenInnie>(cells);
         return;
     }
     else if(cells.size() == 0)
@@ -55,7 +70,7 @@ void InniesAndOuties::SearchInniesInner(KillerCage_t& unionCage)
             if(k->RegionGet()->SizeGet() == cells.size()
                && k->SumGet() != (unsigned int)ghostCageTotal)
             {
-                mGrid->ProgressManagerGet()->RegisterProgress(std::make_shared<Impossible_ClashingGhostCages>(std::move(cells), ghostCageTotal, k->SumGet(), mGrid));
+                mGrid->ProgressManagerGet()->RegisterProgress<Impossible_ClashingGhostCages>(cells, ghostCageTotal, k->SumGet());
             }
             return;
         }
@@ -120,7 +135,7 @@ void InniesAndOuties::SearchOutiesInner(KillerCage_t &unionCage)
     int ghostCageTotal = static_cast<int>(unionCage.first) - static_cast<int>(mCurrentRegionTotal);
     if(ghostCageTotal < 0 || (ghostCageTotal == 0 && cells.size() > 0))
     {
-        mGrid->ProgressManagerGet()->RegisterProgress(std::make_shared<Impossible_BrokenOutie>(std::move(cells), mGrid));
+        mGrid->ProgressManagerGet()->RegisterProgress<Impossible_BrokenOutie>(cells);
         return;
     }
     else if(cells.size() == 0)
@@ -143,7 +158,7 @@ void InniesAndOuties::SearchOutiesInner(KillerCage_t &unionCage)
             {
                 if(c->HasGuess(i))
                 {
-                    mGrid->ProgressManagerGet()->RegisterProgress(std::make_shared<Progress_SplitOutie>(std::move(cells),ghostCageTotal, minCandidate, maxCandidate, mGrid));
+                    mGrid->ProgressManagerGet()->RegisterProgress<Progress_SplitOutie>(cells, ghostCageTotal, minCandidate, maxCandidate);
                     return;
                 }
             }
@@ -151,7 +166,7 @@ void InniesAndOuties::SearchOutiesInner(KillerCage_t &unionCage)
             {
                 if(c->HasGuess(i))
                 {
-                    mGrid->ProgressManagerGet()->RegisterProgress(std::make_shared<Progress_SplitOutie>(std::move(cells),ghostCageTotal, minCandidate, maxCandidate, mGrid));
+                    mGrid->ProgressManagerGet()->RegisterProgress<Progress_SplitOutie>(cells, ghostCageTotal, minCandidate, maxCandidate);
                     return;
                 }
             }
@@ -168,7 +183,7 @@ void InniesAndOuties::SearchOutiesInner(KillerCage_t &unionCage)
         {
             if(r->SumGet() != (unsigned int)ghostCageTotal)
             {
-                mGrid->ProgressManagerGet()->RegisterProgress(std::make_shared<Impossible_ClashingGhostCages>(std::move(cells), ghostCageTotal, r->SumGet(), mGrid));
+                mGrid->ProgressManagerGet()->RegisterProgress<Impossible_ClashingGhostCages>(cells, ghostCageTotal, r->SumGet());
             }
             return;
         }
@@ -181,7 +196,7 @@ void InniesAndOuties::SearchOutiesInner(KillerCage_t &unionCage)
     }
 }
 
-void InniesAndOuties::CalculateCageCombinations(unsigned int size, const std::set<const KillerConstraint*>& availableKillers)
+void InniesAndOuties::CalculateCageCombinations(unsigned int size, const KillerSet& availableKillers)
 {
     mKillerUnions.clear();
     if(size == 1)
@@ -212,7 +227,7 @@ void InniesAndOuties::CalculateCageCombinations(unsigned int size, const std::se
 
 void InniesAndOuties::CalculateCageCombinationsInner(std::list<KillerCombination>& outCombinations, KillerSetIt kIt, const KillerSetIt& end, KillerCombination& nextComb, unsigned int size)
 {
-    std::set<SudokuCell*> cells;
+    CellSet cells;
     unsigned int total = 0;
     for (const auto& k : nextComb)
     {
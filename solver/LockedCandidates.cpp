@@ -45,10 +45,10 @@ void LockedCandidatesTechnique::SearchLockedCandidates(unsigned short value)
 
     if (lockedRegions.size() > 0)
     {
-        mGrid->ProgressManagerGet()->RegisterProgress(std::make_shared<Progress_LockedCandidates>(mCurrentRegion, std::move(lockedRegions), mCurrentRegion->CellsWithValueGet(value), value));
+        mGrid->ProgressManagerGet()->RegisterProgress<Progress_LockedCandidates>(mCurrentRegion, lockedRegions, mCurrentRegion->CellsWithValueGet(value), value);
     }
     if (almostLockedCells.size() > 0)
     {
-        mGrid->ProgressManagerGet()->RegisterProgress(std::make_shared<Progress_FinnedLockedCandidates>(mCurrentRegion, std::move(almostLockedCells), value));
+        mGrid->ProgressManagerGet()->RegisterProgress<Progress_FinnedLockedCandidates>(mCurrentRegion, almostLockedCells, value);
     }
 }
@@ -3,79 +3,43 @@
 #include "Region.h"
 #include "GridProgressManager.h"
 #include "SudokuGrid.h"
+#include "RegionUpdatesManager.h"
+#include "SolverKernels.h"
 #include <algorithm>
-#include <iterator>
-#include <list>
-#include <map>
-#include <string>
+#include <cstdint>
+#include <vector>
 
-typedef CellList::iterator CellListIter;
-
-bool NakedSubsetTechnique::SearchNakedSubsetInner(const CellList& cells, CellList::iterator it, const CellList::iterator endIt, const CellSet& excludeCells, std::set<unsigned short> &candidates, CellList &outNakedSubset, const size_t targetSize, bool& impossible)
-{
-    if (impossible)
-    {
-        return false;
-    }
-    else if (outNakedSubset.size() == targetSize && candidates.size() == targetSize) // naked subset found
-    {
-        return true;
-    }
-    else if (outNakedSubset.size() == targetSize || candidates.size() > targetSize) // naked subset cannot exist with this combination of cells
-    {
-        return false;
-    }
-    else if (outNakedSubset.size() > candidates.size()) // We need to place N values in M cells with N < M. That's not going to work wothout repeating a number.
-    {
-        impossible = true;
-        return false;
-    }
-    else
-    {
-        while (std::distance(it, endIt) >= static_cast<int>(targetSize) - static_cast<int>(outNakedSubset.size())) // make sure the iterator is followed by enough elemnts to reach the desired subset size
-        {
-            if (excludeCells.find(*it) != excludeCells.end())
-            {
-                ++it;
-            }
-            else
-            {
-                std::set<unsigned short> newCandidates;
-                std::merge((*it)->OptionsGet().begin(), (*it)->OptionsGet().end(),
-                    candidates.begin(), candidates.end(),
-                    std::inserter(newCandidates, newCandidates.begin()));
-                // add the current cell to the naked subset
-                outNakedSubset.push_back(*it);
-
-                if (SearchNakedSubsetInner(cells, ++it, endIt, excludeCells, newCandidates, outNakedSubset, targetSize, impossible))
-                {
-                    candidates = newCandidates;
-                    return true;
-                }
-
-                // backtrack
-                outNakedSubset.pop_back();
-            }
-        }
-        return false;
-    }
-}
-
-void NakedSubsetTechnique::SearchNakedSubsets(const CellSet& cellsToSearch)
+void NakedSubsetTechnique::SearchNakedSubsets(const CellMask& cellsToSearch)
 {
     static constexpr size_t s_minSubsetSize = 1;
-
-    CellList cells(mCurrentRegion->CellsGet().begin(), mCurrentRegion->CellsGet().end());
+    const RegionUpdatesManager* updateManager = mCurrentRegion->UpdateManagerGet();
+    const CellSet& regionCells = mCurrentRegion->CellsGet();
 
     // sort the cells from lowest to largest number of viable options. This allows to stop
     // the search early if a cell with more candidates than the subset size is reached.
-    cells.sort([](SudokuCell* const &a, SudokuCell* const &b) { return a->OptionsGet().size() < b->OptionsGet().size(); });
+    std::vector<SudokuCell*> cells(regionCells.begin(), regionCells.end());
+    std::vector<unsigned int> order(cells.size());
+    for (unsigned int i = 0; i < order.size(); ++i)
+    {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](unsigned int a, unsigned int b) { return cells[a]->OptionsCountGet() < cells[b]->OptionsCountGet(); });
 
-    auto endIt = cells.begin();
+    // candidates of the sorted cells, as searched by the kernels,
+    // and position in that order of each cell of the region
+    std::vector<CandidateMask> masks(cells.size());
+    std::vector<unsigned int> sortedPosition(cells.size());
+    for (unsigned int i = 0; i < order.size(); ++i)
+    {
+        masks[i] = cells[order[i]]->OptionsMaskGet();
+        sortedPosition[order[i]] = i;
+    }
+
+    unsigned int endIndex = 0;
 
     // the size of the subset is at least as great as the number of viable options for the
     // first cell in the list (rember the list is sorted lowest to largest number of viable options)
-    size_t minSubsetSize = std::max(s_minSubsetSize, (*endIt)->OptionsGet().size());
+    size_t minSubsetSize = std::max(s_minSubsetSize, static_cast<size_t>(CandidatesCountGet(masks[0])));
 
     // if the region has size N we only need to check for naked subset up to a size of N-1,
     // since a set of size N would obviously be naked but would not allow us to make any progress
@@ -83,112 +47,82 @@ void NakedSubsetTechnique::SearchNakedSubsets(const CellSet& cellsToSearch)
     unsigned short maxSubsetSize = cells.size() - 1;
     if (mCurrentRegion->IsClosed())
     {
-        maxSubsetSize = mCurrentRegion->CellsGet().size() / 2;
+        maxSubsetSize = regionCells.size() / 2;
     }
     for (size_t subsetSize = minSubsetSize; subsetSize <= maxSubsetSize; ++subsetSize)
     {
         // we will end the iteration on the first cell that has too many options for the subset size we are aiming for
-        while (endIt != cells.end() && (*endIt)->OptionsGet().size() <= subsetSize)
+        while (endIndex < masks.size() && CandidatesCountGet(masks[endIndex]) <= subsetSize)
         {
-            ++endIt;
+            ++endIndex;
         }
 
-        CellSet excludeCells;
+        std::uint64_t excludeCells = 0;
 
-        for (SudokuCell* c : cellsToSearch)
+        bool found = cellsToSearch.FindIf([&](CellId i)
         {
+            SudokuCell* c = updateManager->CellGet(i);
             bool impossible = false;
-            CellList nakedSubset;
-            std::set<unsigned short> candidateValues(c->OptionsGet().begin(), c->OptionsGet().end());
-            nakedSubset.push_back(c);
-            excludeCells.insert(c);
+            std::uint64_t members = 0;
+            CandidateMask candidateValues = c->OptionsMaskGet();
+            excludeCells |= std::uint64_t(1) << sortedPosition[i];
 
-            if (SearchNakedSubsetInner(cells, cells.begin(), endIt, excludeCells, candidateValues, nakedSubset, subsetSize, impossible))
+            if (mGrid->KernelsGet().SubsetFind(masks.data(), endIndex, excludeCells, c->OptionsMaskGet(), subsetSize, members, candidateValues, impossible))
             {
-                mGrid->ProgressManagerGet()->RegisterProgress(std::make_shared<Progress_NakedSubset>(std::move(nakedSubset), std::move(candidateValues)));
-                return;
+                CellList nakedSubset = { c };
+                for (; members; members &= members - 1)
+                {
+                    nakedSubset.push_back(cells[order[LowestBitIndexGet(members)]]);
+                }
+                mGrid->ProgressManagerGet()->RegisterProgress<Progress_NakedSubset>(nakedSubset, candidateValues);
+                return true;
             }
             else if (impossible)
             {
-                mGrid->ProgressManagerGet()->RegisterProgress(std::make_shared<Impossible_TooFewValuesForRegion>(std::move(nakedSubset), std::move(candidateValues), mGrid));
+                mGrid->ProgressManagerGet()->RegisterProgress<Impossible_TooFewValuesForRegion>(CellList{ c }, candidateValues);
             }
+            return false;
+        });
+        if (found)
+        {
+            return;
         }
     }
-    for (SudokuCell* c : cellsToSearch)
+    cellsToSearch.ForEach([&](CellId i)
     {
-        mGrid->ProgressManagerGet()->RegisterFailure(TechniqueType::NakedSubset, mCurrentRegion, c);
-    }
+        mGrid->ProgressManagerGet()->RegisterFailure(TechniqueType::NakedSubset, mCurrentRegion, updateManager->CellGet(i));
+    });
 }
 
 
-bool HiddenSubsetTechnique::SearchHiddenSubsetInner(const std::list<ValueMapEntry>& values, std::list<ValueMapEntry>::iterator it, const std::list<ValueMapEntry>::iterator endIt, const std::set<unsigned short>& excludeValues, std::list<unsigned short>& candidates, CellSet& outNakedSubset, const size_t subsetFinalSize, bool& impossible)
-{
-    if (impossible)
-    {
-        return false;
-    }
-    if (outNakedSubset.size() == subsetFinalSize && candidates.size() == subsetFinalSize) // naked subset found
-    {
-        return true;
-    }
-    else if (candidates.size() == subsetFinalSize || outNakedSubset.size() > subsetFinalSize) // naked subset cannot exist with this combination of values
-    {
-        return false;
-    }
-    else if (candidates.size() > outNakedSubset.size()) // We need to place N values in M cells with N > M. That's not going to work as some numbers will be left out.
-    {
-        impossible = true;
-        return false;
-    }
-    else
-    {
-        while (std::distance(it, endIt) >= static_cast<int>(subsetFinalSize) - static_cast<int>(candidates.size())) // make sure the iterator is followed by enough elemnts to reach the desired subset size
-        {
-            if (excludeValues.find(it->first) != excludeValues.end())
-            {
-                ++it;
-            }
-            else
-            {
-                CellSet newSubset;
-                std::merge(it->second.begin(), it->second.end(),
-                    outNakedSubset.begin(), outNakedSubset.end(),
-                    std::inserter(newSubset, newSubset.begin()));
-                // add the current cell to the naked subset
-                candidates.push_back(it->first);
-
-                if (SearchHiddenSubsetInner(values, ++it, endIt, excludeValues, candidates, newSubset, subsetFinalSize, impossible))
-                {
-                    outNakedSubset = newSubset;
-                    return true;
-                }
-
-                // backtrack
-                candidates.pop_back();
-            }
-        }
-        return false;
-    }
-}
-
-void HiddenSubsetTechnique::SearchHiddenSubsets(const std::set<unsigned short>& valuesToSearch)
+void HiddenSubsetTechnique::SearchHiddenSubsets(CandidateMask valuesToSearch)
 {
     static constexpr size_t s_minSubsetSize = 1;
     const std::set<unsigned short>& confirmedValues = mCurrentRegion->ConfirmedValuesGet();
+    const std::vector<SudokuCell*> regionCells(mCurrentRegion->CellsGet().begin(), mCurrentRegion->CellsGet().end());
 
-    std::list<ValueMapEntry> valueToCellMap; // maps each value to the cells than can host it
-
+    // maps each value to the positions of the cells than can host it
+    std::vector<unsigned short> entryValues;
+    std::vector<std::uint64_t> masks;
     for (const unsigned short& v : confirmedValues)
     {
-        valueToCellMap.push_back(ValueMapEntry(v, mCurrentRegion->CellsWithValueGet(v)));
+        std::uint64_t hosts = 0;
+        for (SudokuCell* c : mCurrentRegion->CellsWithValueGet(v))
+        {
+            const auto it = std::lower_bound(regionCells.begin(), regionCells.end(), c, CellIdLess());
+            hosts |= std::uint64_t(1) << (it - regionCells.begin());
+        }
+        entryValues.push_back(v);
+        masks.push_back(hosts);
     }
 
-    std::set<unsigned short> values;
-    for (const unsigned short& v : valuesToSearch)
+    CandidateMask values = 0;
+    for (CandidateMask m = valuesToSearch; m; m &= m - 1)
     {
+        const unsigned short v = static_cast<unsigned short>(LowestBitIndexGet(m) + 1);
         if (mCurrentRegion->HasConfirmedValue(v))
         {
-            values.insert(v);
+            values |= CandidateBitGet(v);
         }
         else
         {
@@ -198,56 +132,82 @@ void HiddenSubsetTechnique::SearchHiddenSubsets(const std::set<unsigned short>&
 
     // sort the values from lowest to largest number of viable hosting cells. This allows to stop
     // the search early if a value with more hosts than the subset size is reached.
-    valueToCellMap.sort([](const ValueMapEntry &a, const ValueMapEntry &b) { return a.second.size() < b.second.size(); });
+    std::vector<unsigned int> order(masks.size());
+    for (unsigned int i = 0; i < order.size(); ++i)
+    {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](unsigned int a, unsigned int b) { return CandidatesCountGet(masks[a]) < CandidatesCountGet(masks[b]); });
+    std::vector<std::uint64_t> sortedMasks(masks.size());
+    std::vector<unsigned short> sortedValues(masks.size());
+    for (unsigned int i = 0; i < order.size(); ++i)
+    {
+        sortedMasks[i] = masks[order[i]];
+        sortedValues[i] = entryValues[order[i]];
+    }
 
-    auto endIt = valueToCellMap.begin();
+    unsigned int endIndex = 0;
 
     // the size of the subset is at least as great as the number of viable cells for the first
     // value in the list (rember the list is sorted lowest to largest number of viable cells)
-    size_t minSubsetSize = std::max(s_minSubsetSize, endIt->second.size());
+    size_t minSubsetSize = s_minSubsetSize;
+    if (!sortedMasks.empty())
+    {
+        minSubsetSize = std::max(s_minSubsetSize, static_cast<size_t>(CandidatesCountGet(sortedMasks[0])));
+    }
 
     // if the region has size N we only neet to check for naked subset up to a size of N-1,
     // since a set of size N would obviously be naked but would not allow us to make any progress
     // on the puzzle
-    unsigned short maxSubsetSize = std::min(valueToCellMap.size(), mCurrentRegion->CellsGet().size() - 1);
+    unsigned short maxSubsetSize = std::min(sortedMasks.size(), regionCells.size() - 1);
     if (mCurrentRegion->IsClosed())
     {
-        maxSubsetSize = mCurrentRegion->CellsGet().size() / 2;
+        maxSubsetSize = regionCells.size() / 2;
     }
     for (size_t subsetSize = minSubsetSize; subsetSize <= maxSubsetSize; ++subsetSize)
     {
         // we will end the iteration on the first value that can go in too many cells
         // for the subset size we are aiming for
-        while (endIt != valueToCellMap.end() && endIt->second.size() <= subsetSize)
+        while (endIndex < sortedMasks.size() && CandidatesCountGet(sortedMasks[endIndex]) <= subsetSize)
         {
-            ++endIt;
+            ++endIndex;
         }
 
-        std::set<unsigned short> excludeValues;
+        std::uint64_t excludeValues = 0;
 
-        for (const unsigned short& v : values)
+        for (CandidateMask m = values; m; m &= m - 1)
         {
+            const unsigned short v = static_cast<unsigned short>(LowestBitIndexGet(m) + 1);
+            const unsigned int start = static_cast<unsigned int>(std::find(sortedValues.begin(), sortedValues.end(), v) - sortedValues.begin());
             bool impossible = false;
-            std::list<ValueMapEntry>::iterator startingCells = std::find_if(valueToCellMap.begin(), valueToCellMap.end(), [=](ValueMapEntry a) { return a.first == v; });
-            CellSet nakedSubset(startingCells->second.begin(), startingCells->second.end());
-            std::list<unsigned short> candidateValues;
-            candidateValues.push_back(v);
-            excludeValues.insert(v);
+            std::uint64_t members = 0;
+            std::uint64_t hosts = 0;
+            excludeValues |= std::uint64_t(1) << start;
 
-            if (SearchHiddenSubsetInner(valueToCellMap, valueToCellMap.begin(), endIt, excludeValues, candidateValues, nakedSubset, subsetSize, impossible))
+            if (mGrid->KernelsGet().SubsetFind(sortedMasks.data(), endIndex, excludeValues, sortedMasks[start], subsetSize, members, hosts, impossible))
             {
-                mGrid->ProgressManagerGet()->RegisterProgress(std::make_shared<Progress_HiddenSubset>(std::move(nakedSubset), mCurrentRegion, std::move(candidateValues)));
+                CandidateMask candidateValues = CandidateBitGet(v);
+                for (; members; members &= members - 1)
+                {
+                    candidateValues |= CandidateBitGet(sortedValues[LowestBitIndexGet(members)]);
+                }
+                CellSet nakedSubset;
+                for (; hosts; hosts &= hosts - 1)
+                {
+                    nakedSubset.emplace_hint(nakedSubset.end(), regionCells[LowestBitIndexGet(hosts)]);
+                }
+                mGrid->ProgressManagerGet()->RegisterProgress<Progress_HiddenSubset>(nakedSubset, mCurrentRegion, candidateValues);
                 return;
             }
             else if (impossible)
             {
-                mGrid->ProgressManagerGet()->RegisterProgress(std::make_shared<Impossible_TooManyValuesForRegion>(std::move(nakedSubset), std::move(candidateValues), mGrid));
+                mGrid->ProgressManagerGet()->RegisterProgress<Impossible_TooManyValuesForRegion>(mCurrentRegion->CellsWithValueGet(v), CandidateBitGet(v));
                 return;
             }
         }
     }
-    for (const unsigned short& v : valuesToSearch)
+    for (CandidateMask m = valuesToSearch; m; m &= m - 1)
     {
-        mGrid->ProgressManagerGet()->RegisterFailure(TechniqueType::HiddenSubset, mCurrentRegion, nullptr, v);
+        mGrid->ProgressManagerGet()->RegisterFailure(TechniqueType::HiddenSubset, mCurrentRegion, nullptr, static_cast<unsigned short>(LowestBitIndexGet(m) + 1));
     }
 }
@@ -6,12 +6,78 @@
 #include "SudokuGrid.h"
 #include "GridProgressManager.h"
 #include "RegionsManager.h"
-#include "../sudokusolverthread.h"
+#include "SolverObserver.h"
 #include "GhostCagesManager.h"
+#include "RegionArena.h"
+
+namespace
+{
+    SudokuCell* CellGet(const SudokuGrid* grid, unsigned int id)
+    {
+        return grid->CellGet(id);
+    }
+
+    Region* RegionGet(const SudokuGrid* grid, unsigned int id)
+    {
+        return grid->RegionArenaGet()->RegionGet(id);
+    }
+
+    // comma separated names, in the order they were stored
+    std::string CellNamesGet(const SudokuGrid* grid, const IdSpan& ids)
+    {
+        std::string names;
+        for (const unsigned int id : ids)
+        {
+            names += CellGet(grid, id)->CellNameGet() + ",";
+        }
+        if (!names.empty())
+        {
+            names.pop_back();
+        }
+        return names;
+    }
+
+    std::string RegionNamesGet(const SudokuGrid* grid, const IdSpan& ids)
+    {
+        std::string names;
+        for (const unsigned int id : ids)
+        {
+            names += RegionGet(grid, id)->RegionNameGet() + ",";
+        }
+        if (!names.empty())
+        {
+            names.pop_back();
+        }
+        return names;
+    }
+
+    std::string ValueNamesGet(CandidateMask values)
+    {
+        std::string names;
+        for (CandidateMask m = values; m; m &= m - 1)
+        {
+            names += std::to_string(LowestBitIndexGet(m) + 1) + ",";
+        }
+        if (!names.empty())
+        {
+            names.pop_back();
+        }
+        return names;
+    }
+
+    void RemoveOptions(SudokuCell* cell, CandidateMask values)
+    {
+        for (CandidateMask m = values; m; m &= m - 1)
+        {
+            cell->RemoveOption(static_cast<unsigned short>(LowestBitIndexGet(m) + 1));
+        }
+    }
+}
 
 void Progress_GivenCellAdded::ProcessProgress()
 {
-    ScanNaked({ mCell }, { mValue }, mCell->GridGet(), false);
+    const CellId id = mCell->IdGet();
+    ScanNaked(IdSpan(&id, 1), { mValue }, mCell->GridGet(), false);
     mCell->ValueSet(mValue);
 
     PrintMessage();
@@ -19,7 +85,7 @@ void Progress_GivenCellAdded::ProcessProgress()
 
 void Progress_GivenCellAdded::PrintMessage() const
 {
-    SudokuSolverThread* st = mCell->GridGet()->SolverThreadGet();
+    SolverObserver* st = mCell->GridGet()->ObserverGet();
     if(st)
     {
         std::string message = "->Scan given " + std::to_string(mValue) + " in " + mCell->CellNameGet() + ".";
@@ -31,7 +97,8 @@ void Progress_SingleOptionLeftInCell::ProcessProgress()
 {
     if(mCell->IsSolved()) return;
 
-    ScanNaked({ mCell }, { mValue }, mCell->GridGet(), false);
+    const CellId id = mCell->IdGet();
+    ScanNaked(IdSpan(&id, 1), { mValue }, mCell->GridGet(), false);
     mCell->ValueSet(mValue);
 
     PrintMessage();
@@ -39,7 +106,7 @@ void Progress_SingleOptionLeftInCell::ProcessProgress()
 
 void Progress_SingleOptionLeftInCell::PrintMessage() const
 {
-    SudokuSolverThread* st = mCell->GridGet()->SolverThreadGet();
+    SolverObserver* st = mCell->GridGet()->ObserverGet();
     if(st)
     {
         std::string message = "->Naked single in " + mCell->CellNameGet() + ". " +
@@ -52,7 +119,8 @@ void Progress_SingleCellForOption::ProcessProgress()
 {
     if(mCell->IsSolved()) return;
 
-    ScanNaked({ mCell }, { mValue }, mCell->GridGet(), true);
+    const CellId id = mCell->IdGet();
+    ScanNaked(IdSpan(&id, 1), { mValue }, mCell->GridGet(), true);
     mCell->ValueSet(mValue);
 
     PrintMessage();
@@ -60,7 +128,7 @@ void Progress_SingleCellForOption::ProcessProgress()
 
 void Progress_SingleCellForOption::PrintMessage() const
 {
-    SudokuSolverThread* st = mCell->GridGet()->SolverThreadGet();
+    SolverObserver* st = mCell->GridGet()->ObserverGet();
     if(st)
     {
         std::string message = "->Hidden single on " + std::to_string(mValue) + ". " +
@@ -73,37 +141,18 @@ void Progress_SingleCellForOption::PrintMessage() const
 
 void Progress_NakedSubset::ProcessProgress()
 {
-    auto cIt = mCells.begin();
-    SudokuGrid* grid = (*cIt)->GridGet();
-    ScanNaked(mCells, mValues, grid, false);
+    ScanNaked(mCells, CandidatesSetGet(mValues), mGrid, false);
 
     PrintMessage();
 }
 
 void Progress_NakedSubset::PrintMessage() const
 {
-    auto cIt = mCells.begin();
-    SudokuGrid* grid = (*cIt)->GridGet();
-    SudokuSolverThread* st = grid->SolverThreadGet();
-    if(st && mCells.size() < grid->SizeGet())
+    SolverObserver* st = mGrid->ObserverGet();
+    if(st && mCells.size() < mGrid->SizeGet())
     {
-        std::string message = "->Naked subset in {";
-        while(cIt != mCells.end())
-        {
-            message += (*cIt)->CellNameGet() + ",";
-            cIt++;
-        }
-        message.pop_back();
-        message += "} on values {";
-
-        auto vIt = mValues.begin();
-        while(vIt != mValues.end())
-        {
-            message += std::to_string(*vIt) + ",";
-            vIt++;
-        }
-        message.pop_back();
-        message += "}.";
+        std::string message = "->Naked subset in {" + CellNamesGet(mGrid, mCells) +
+                              "} on values {" + ValueNamesGet(mValues) + "}.";
 
         st->NotifyLogicalDeduction(message);
     }
@@ -111,30 +160,18 @@ void Progress_NakedSubset::PrintMessage() const
 
 void Progress_HiddenSubset::ProcessProgress()
 {
-    auto cIt = mCells.begin();
-    SudokuGrid* grid = (*cIt)->GridGet();
-    ScanNaked(mCells, mValues, grid, true);
+    ScanNaked(mCells, CandidatesSetGet(mValues), mGrid, true);
 
     PrintMessage();
 }
 
 void Progress_HiddenSubset::PrintMessage() const
 {
-    auto cIt = mCells.begin();
-    SudokuGrid* grid = (*cIt)->GridGet();
-    SudokuSolverThread* st = grid->SolverThreadGet();
-    if(st && mCells.size() < grid->SizeGet())
+    SolverObserver* st = mGrid->ObserverGet();
+    if(st && mCells.size() < mGrid->SizeGet())
     {
-        std::string message = "->Hidden subset on values {";
-        auto vIt = mValues.begin();
-        while(vIt != mValues.end())
-        {
-            message += std::to_string(*vIt) + ",";
-            vIt++;
-        }
-        message.pop_back();
-        message += "} in " + mRegion->RegionNameGet();
-        message += ".";
+        std::string message = "->Hidden subset on values {" + ValueNamesGet(mValues) +
+                              "} in " + mRegion->RegionNameGet() + ".";
 
         st->NotifyLogicalDeduction(message);
     }
@@ -159,9 +196,9 @@ void Progress_OptionRemoved::ProcessProgress()
 
 void Progress_LockedCandidates::ProcessProgress()
 {
-    for (const Region* region : mIntersectingRegions)
+    for (const unsigned int id : mIntersectingRegions)
     {
-        ScanLocked(mIntersection, region, mValue);
+        ScanLocked(mIntersection, RegionGet(mGrid, id), mValue);
     }
 
     PrintMessage();
@@ -169,20 +206,11 @@ void Progress_LockedCandidates::ProcessProgress()
 
 void Progress_LockedCandidates::PrintMessage() const
 {
-    SudokuSolverThread* st = (*mIntersectingRegions.begin())->GridGet()->SolverThreadGet();
+    SolverObserver* st = mGrid->ObserverGet();
     if(st)
     {
         std::string message = "->Locked " + std::to_string(mValue) + " in " + mDefiningRegion->RegionNameGet() + ". " +
-                "Cover region(s): ";
-
-        auto it = mIntersectingRegions.begin();
-        while(it != mIntersectingRegions.end())
-        {
-            message += (*it)->RegionNameGet() + ",";
-            it++;
-        }
-        message.pop_back();
-        message += ".";
+                "Cover region(s): " + RegionNamesGet(mGrid, mIntersectingRegions) + ".";
 
         st->NotifyLogicalDeduction(message);
     }
@@ -190,9 +218,9 @@ void Progress_LockedCandidates::PrintMessage() const
 
 void Progress_FinnedLockedCandidates::ProcessProgress()
 {
-    for (SudokuCell* const & c : mCells)
+    for (const unsigned int id : mCells)
     {
-        c->RemoveOption(mValue);
+        CellGet(mGrid, id)->RemoveOption(mValue);
     }
 
     PrintMessage();
@@ -200,19 +228,11 @@ void Progress_FinnedLockedCandidates::ProcessProgress()
 
 void Progress_FinnedLockedCandidates::PrintMessage() const
 {
-    SudokuSolverThread* st = mRegion->GridGet()->SolverThreadGet();
+    SolverObserver* st = mGrid->ObserverGet();
     if(st)
     {
-        std::string message = "->Value " + std::to_string(mValue) + " excluded from cells {";
-
-        auto cIt = mCells.begin();
-        while(cIt != mCells.end())
-        {
-            message += (*cIt)->CellNameGet() + ",";
-            cIt++;
-        }
-        message.pop_back();
-        message += "} as there would be no way to place " + std::to_string(mValue) +
+        std::string message = "->Value " + std::to_string(mValue) + " excluded from cells {" + CellNamesGet(mGrid, mCells) +
+                "} as there would be no way to place " + std::to_string(mValue) +
                 " in " + mRegion->RegionNameGet();
 
         st->NotifyLogicalDeduction(message);
@@ -222,9 +242,9 @@ void Progress_FinnedLockedCandidates::PrintMessage() const
 void Progress_Fish::ProcessProgress()
 {
     // remove mValue from all the cells in the secondary set that are not in the defining set
-    for (Region* r : mSecondaryRegions)
+    for (const unsigned int id : mSecondaryRegions)
     {
-        r->UpdateManagerGet()->OnFishFound(mDefiningCells, mValue);
+        RegionGet(mGrid, id)->UpdateManagerGet()->OnFishFound(mDefiningCells, mValue);
     }
 
     PrintMessage();
@@ -232,28 +252,12 @@ void Progress_Fish::ProcessProgress()
 
 void Progress_Fish::PrintMessage() const
 {
-    auto rIt = mSecondaryRegions.begin();
-    SudokuSolverThread* st = (*rIt)->GridGet()->SolverThreadGet();
+    SolverObserver* st = mGrid->ObserverGet();
     if(st)
     {
         std::string message = "->Fish on " + std::to_string(mValue) +
-                              ". Base regions: ";
-
-        auto bIt = mDefiningRegions.begin();
-        while(bIt != mDefiningRegions.end())
-        {
-            message += (*bIt)->RegionNameGet() + ",";
-            bIt++;
-        }
-        message.pop_back();
-        message += "; Cover regions: ";
-        while(rIt != mSecondaryRegions.end())
-        {
-            message += (*rIt)->RegionNameGet() + ",";
-            rIt++;
-        }
-        message.pop_back();
-        message += ".";
+                              ". Base regions: " + RegionNamesGet(mGrid, mDefiningRegions) +
+                              "; Cover regions: " + RegionNamesGet(mGrid, mSecondaryRegions) + ".";
 
         st->NotifyLogicalDeduction(message);
     }
@@ -261,45 +265,22 @@ void Progress_Fish::PrintMessage() const
 
 void Progress_CannibalFish::ProcessProgress()
 {
-    for (const auto& cell : mCannibalCells)
+    for (const unsigned int id : mCannibalCells)
     {
-        cell->RemoveOption(mValue);
+        CellGet(mGrid, id)->RemoveOption(mValue);
     }
     Progress_Fish::ProcessProgress();
 }
 
 void Progress_CannibalFish::PrintMessage() const
 {
-    auto rIt = mSecondaryRegions.begin();
-    SudokuSolverThread* st = (*rIt)->GridGet()->SolverThreadGet();
+    SolverObserver* st = mGrid->ObserverGet();
     if(st)
     {
         std::string message = "->Cannibal fish on " + std::to_string(mValue) +
-                              ". Base regions: ";
-
-        auto bIt = mDefiningRegions.begin();
-        while(bIt != mDefiningRegions.end())
-        {
-            message += (*bIt)->RegionNameGet() + ",";
-            bIt++;
-        }
-        message.pop_back();
-        message += "; Cover regions: ";
-        while(rIt != mSecondaryRegions.end())
-        {
-            message += (*rIt)->RegionNameGet() + ",";
-            rIt++;
-        }
-        message.pop_back();
-        message += "; Eaten cells: {";
-        auto cIt = mCannibalCells.begin();
-        while(cIt != mCannibalCells.end())
-        {
-            message += (*cIt)->CellNameGet() + ",";
-            cIt++;
-        }
-        message.pop_back();
-        message += "}.";
+                              ". Base regions: " + RegionNamesGet(mGrid, mDefiningRegions) +
+                              "; Cover regions: " + RegionNamesGet(mGrid, mSecondaryRegions) +
+                              "; Eaten cells: {" + CellNamesGet(mGrid, mCannibalCells) + "}.";
 
         st->NotifyLogicalDeduction(message);
     }
@@ -307,9 +288,9 @@ void Progress_CannibalFish::PrintMessage() const
 
 void Progress_FinnedFish::ProcessProgress()
 {
-    for (SudokuCell* const& c : mCellsSeingFins)
+    for (const unsigned int id : mCellsSeingFins)
     {
-        c->RemoveOption(mValue);
+        CellGet(mGrid, id)->RemoveOption(mValue);
     }
 
     PrintMessage();
@@ -317,37 +298,13 @@ void Progress_FinnedFish::ProcessProgress()
 
 void Progress_FinnedFish::PrintMessage() const
 {
-    auto rIt = mSecondaryRegions.begin();
-    SudokuSolverThread* st = (*rIt)->GridGet()->SolverThreadGet();
+    SolverObserver* st = mGrid->ObserverGet();
     if(st)
     {
         std::string message = "->Finned fish on " + std::to_string(mValue) +
-                              ". Base regions: ";
-
-        auto bIt = mDefiningRegions.begin();
-        while(bIt != mDefiningRegions.end())
-        {
-            message += (*bIt)->RegionNameGet() + ",";
-            bIt++;
-        }
-        message.pop_back();
-        message += "; Cover regions: ";
-        while(rIt != mSecondaryRegions.end())
-        {
-            message += (*rIt)->RegionNameGet() + ",";
-            rIt++;
-        }
-        message.pop_back();
-        message += "; Fins: ";
-
-        auto cIt = mFins.begin();
-        while(cIt != mFins.end())
-        {
-            message += (*cIt)->CellNameGet() + ",";
-            cIt++;
-        }
-        message.pop_back();
-        message += ".";
+                              ". Base regions: " + RegionNamesGet(mGrid, mDefiningRegions) +
+                              "; Cover regions: " + RegionNamesGet(mGrid, mSecondaryRegions) +
+                              "; Fins: " + CellNamesGet(mGrid, mFins) + ".";
 
         st->NotifyLogicalDeduction(message);
     }
@@ -355,54 +312,23 @@ void Progress_FinnedFish::PrintMessage() const
 
 void Progress_CannibalFinnedFish::ProcessProgress()
 {
-    for (const auto& cell : mCannibalCells)
+    for (const unsigned int id : mCannibalCells)
     {
-        cell->RemoveOption(mValue);
+        CellGet(mGrid, id)->RemoveOption(mValue);
     }
     Progress_FinnedFish::ProcessProgress();
 }
 
 void Progress_CannibalFinnedFish::PrintMessage() const
 {
-    auto rIt = mSecondaryRegions.begin();
-    SudokuSolverThread* st = (*rIt)->GridGet()->SolverThreadGet();
+    SolverObserver* st = mGrid->ObserverGet();
     if(st)
     {
         std::string message = "->Cannibal finned fish on " + std::to_string(mValue) +
-                              ". Base regions";
-
-        auto bIt = mDefiningRegions.begin();
-        while(bIt != mDefiningRegions.end())
-        {
-            message += (*bIt)->RegionNameGet() + ",";
-            bIt++;
-        }
-        message.pop_back();
-        message += "; Cover regions: ";
-        while(rIt != mSecondaryRegions.end())
-        {
-            message += (*rIt)->RegionNameGet() + ",";
-            rIt++;
-        }
-        message.pop_back();
-        message += "; Fins: ";
-
-        auto cIt = mFins.begin();
-        while(cIt != mFins.end())
-        {
-            message += (*cIt)->CellNameGet() + ",";
-            cIt++;
-        }
-        message.pop_back();
-        message += "; Eaten cells: {";
-        auto eIt = mCannibalCells.begin();
-        while(eIt != mCannibalCells.end())
-        {
-            message += (*eIt)->CellNameGet() + ",";
-            eIt++;
-        }
-        message.pop_back();
-        message += ".";
+                              ". Base regions" + RegionNamesGet(mGrid, mDefiningRegions) +
+                              "; Cover regions: " + RegionNamesGet(mGrid, mSecondaryRegions) +
+                              "; Fins: " + CellNamesGet(mGrid, mFins) +
+                              "; Eaten cells: {" + CellNamesGet(mGrid, mCannibalCells) + ".";
 
         st->NotifyLogicalDeduction(message);
     }
@@ -410,14 +336,15 @@ void Progress_CannibalFinnedFish::PrintMessage() const
 
 void Progress_RegionBecameClosed::ProcessProgress()
 {
-    ScanNaked(mRegion->CellsGet(), mRegion->ConfirmedValuesGet(), mRegion->GridGet(), false);
+    const std::vector<CellId> cells = mRegion->CellIdsGet();
+    ScanNaked(IdSpan(cells), mRegion->ConfirmedValuesGet(), mRegion->GridGet(), false);
 
     PrintMessage();
 }
 
 void Progress_RegionBecameClosed::PrintMessage() const
 {
-    SudokuSolverThread* st = mRegion->GridGet()->SolverThreadGet();
+    SolverObserver* st = mRegion->GridGet()->ObserverGet();
     if(st && !mRegion->IsHouse() && mRegion->IsStartingRegion())
     {
         std::string message = "->" + mRegion->RegionNameGet() + " forms a naked set.";
@@ -427,25 +354,17 @@ void Progress_RegionBecameClosed::PrintMessage() const
 
 void Progress_ValueNotInKiller::ProcessProgress()
 {
-    mCell->RemoveMultipleOptions(mValues);
+    RemoveOptions(mCell, mValues);
 
     PrintMessage();
 }
 
 void Progress_ValueNotInKiller::PrintMessage() const
 {
-    SudokuSolverThread* st = mCell->GridGet()->SolverThreadGet();
+    SolverObserver* st = mCell->GridGet()->ObserverGet();
     if(st)
     {
-        std::string message = "->Values {";
-        auto vIt = mValues.begin();
-        while(vIt != mValues.end())
-        {
-            message += std::to_string(*vIt) + ",";
-            vIt++;
-        }
-        message.pop_back();
-        message += "} removed from " + mCell->CellNameGet() +
+        std::string message = "->Values {" + ValueNamesGet(mValues) + "} removed from " + mCell->CellNameGet() +
                 " as they break the sum in " + mRegion->RegionNameGet() + ".";
 
         st->NotifyLogicalDeduction(message);
@@ -461,25 +380,17 @@ void Progress_ValueForcedInKiller::ProcessProgress()
 
 void Progress_ValueDisallowedByBifurcation::ProcessProgress()
 {
-    mCell->RemoveMultipleOptions(mValues);
+    RemoveOptions(mCell, mValues);
 
     PrintMessage();
 }
 
 void Progress_ValueDisallowedByBifurcation::PrintMessage() const
 {
-    SudokuSolverThread* st = mCell->GridGet()->SolverThreadGet();
+    SolverObserver* st = mCell->GridGet()->ObserverGet();
     if(st)
     {
-        std::string message = "->Values {";
-        auto vIt = mValues.begin();
-        while(vIt != mValues.end())
-        {
-            message += std::to_string(*vIt) + ",";
-            vIt++;
-        }
-        message.pop_back();
-        message += "} excluded from cell " + mCell->CellNameGet() +
+        std::string message = "->Values {" + ValueNamesGet(mValues) + "} excluded from cell " + mCell->CellNameGet() +
                 " after bifurcating cell " + mPivot->CellNameGet() + ".";
 
         st->NotifyLogicalDeduction(message);
@@ -495,7 +406,7 @@ void Progress_OptionRemovedViaGuessing::ProcessProgress()
 
 void Progress_OptionRemovedViaGuessing::PrintMessage() const
 {
-    SudokuSolverThread* st = mCell->GridGet()->SolverThreadGet();
+    SolverObserver* st = mCell->GridGet()->ObserverGet();
     if(st)
     {
         std::string message = "->Value " + std::to_string(mValue) + " removed from " + mCell->CellNameGet() +
@@ -507,42 +418,26 @@ void Progress_OptionRemovedViaGuessing::PrintMessage() const
 
 void Progress_GhostCage::ProcessProgress()
 {
-    CellSet cells = mCells;
-    RegionSPtr regionSPtr = std::make_shared<Region>(mGrid, std::move(cells), true);
-    regionSPtr->AddVariantConstraint(std::make_unique<KillerConstraint>(mTotal));
+    Region* region = mGrid->RegionArenaGet()->Create(mGrid, mCells, true);
+    region->AddVariantConstraint(std::make_unique<KillerConstraint>(mTotal));
 
     std::string type = mInnie ? "innie" : "outie";
-    std::string name = "the " + std::to_string(mTotal) + " " + type + " at {";
-    auto cIt = mCells.begin();
-    while(cIt != mCells.end())
-    {
-        name += (*cIt)->CellNameGet() + ",";
-        cIt++;
-    }
-    name.pop_back();
-    name += "}";
+    std::string name = "the " + std::to_string(mTotal) + " " + type + " at {" + CellNamesGet(mGrid, mCells) + "}";
 
-    regionSPtr->RegionNameSet(name);
-    mGrid->GhostRegionsManagerGet()->RegisterRegion(regionSPtr);
+    region->RegionNameSet(name);
+    mGrid->GhostRegionsManagerGet()->RegisterRegion(region);
 
     PrintMessage();
 }
 
 void Progress_GhostCage::PrintMessage() const
 {
-    SudokuSolverThread* st = mGrid->SolverThreadGet();
+    SolverObserver* st = mGrid->ObserverGet();
     if(st)
     {
         std::string type = mInnie ? "Innie" : "Outie";
-        std::string message = "->" + type + " cage added to the grid. Total: " + std::to_string(mTotal) + "; Cells: {";
-        auto cIt = mCells.begin();
-        while(cIt != mCells.end())
-        {
-            message += (*cIt)->CellNameGet() + ",";
-            cIt++;
-        }
-        message.pop_back();
-        message += "}.";
+        std::string message = "->" + type + " cage added to the grid. Total: " + std::to_string(mTotal) +
+                "; Cells: {" + CellNamesGet(mGrid, mCells) + "}.";
 
         st->NotifyLogicalDeduction(message);
     }
@@ -550,8 +445,9 @@ void Progress_GhostCage::PrintMessage() const
 
 void Progress_SplitOutie::ProcessProgress()
 {
-    for (const auto& c : mCells)
+    for (const unsigned int id : mCells)
     {
+        SudokuCell* c = CellGet(mGrid, id);
         for (unsigned short i = mMinAllowedValue - 1; i > 0; --i)
         {
             c->RemoveOption(i);
@@ -567,18 +463,11 @@ void Progress_SplitOutie::ProcessProgress()
 
 void Progress_SplitOutie::PrintMessage() const
 {
-    SudokuSolverThread* st = mGrid->SolverThreadGet();
+    SolverObserver* st = mGrid->ObserverGet();
     if(st)
     {
-        std::string message = "->Broken outie in cells {";
-        auto cIt = mCells.begin();
-        while(cIt != mCells.end())
-        {
-            message += (*cIt)->CellNameGet() + ",";
-            cIt++;
-        }
-        message.pop_back();
-        message += "} has total " + std::to_string(mTotal) + ". Only values between " +
+        std::string message = "->Broken outie in cells {" + CellNamesGet(mGrid, mCells) +
+                "} has total " + std::to_string(mTotal) + ". Only values between " +
                 std::to_string(mMinAllowedValue) + " and " + std::to_string(mMaxAllowedValue) + " are allowed.";
 
         st->NotifyLogicalDeduction(message);
@@ -605,7 +494,7 @@ void Progress_ImpossiblePuzzle::ProcessProgress()
 
 void Progress_ImpossiblePuzzle::PrintMessage() const
 {
-    SudokuSolverThread* st = mGrid->SolverThreadGet();
+    SolverObserver* st = mGrid->ObserverGet();
     if(st)
     {
         std::string message = "The puzzle is broken!";
@@ -2,6 +2,9 @@
 #define PROGRESS_H
 
 #include "Types.h"
+#include "CandidateMask.h"
+#include "IdSpan.h"
+#include "ProgressPool.h"
 
 class KillerConstraint;
 
@@ -14,6 +17,7 @@ public:
 // Constructors
 
     Progress(ProgressType type) : mType(type) {}
+    virtual ~Progress() = default;
 
 // Non-const functions
 
@@ -81,13 +85,15 @@ public:
 
 class Progress_NakedSubset : public Progress
 {
-    CellSet mCells;
-    std::set<unsigned short> mValues;
+    IdSpan mCells;
+    CandidateMask mValues;
+    SudokuGrid* mGrid;
 public:
-    Progress_NakedSubset(CellList&& cells, std::set<unsigned short>&& values) :
+    Progress_NakedSubset(ProgressPool& pool, const CellList& cells, CandidateMask values) :
         Progress(ProgressType::NakedSubetFound),
-        mCells(cells.begin(), cells.end()),
-        mValues(values)
+        mCells(pool.IdsStore(cells)),
+        mValues(values),
+        mGrid(pool.GridGet())
     {}
     void ProcessProgress() override;
     void PrintMessage() const override;
@@ -95,15 +101,17 @@ public:
 
 class Progress_HiddenSubset : public Progress
 {
-    CellSet mCells;
+    IdSpan mCells;
     Region* mRegion;
-    std::set<unsigned short> mValues;
+    CandidateMask mValues;
+    SudokuGrid* mGrid;
 public:
-    Progress_HiddenSubset(CellSet&& cells, Region* region, std::list<unsigned short>&& values) :
+    Progress_HiddenSubset(ProgressPool& pool, const CellSet& cells, Region* region, CandidateMask values) :
         Progress(ProgressType::HiddenSubsetFound),
-        mCells(cells),
+        mCells(pool.IdsStore(cells)),
         mRegion(region),
-        mValues(values.begin(), values.end())
+        mValues(values),
+        mGrid(pool.GridGet())
     {}
     void ProcessProgress() override;
     void PrintMessage() const override;
@@ -125,16 +133,18 @@ public:
 class Progress_LockedCandidates : public Progress
 {
     Region* mDefiningRegion;
-    RegionSet mIntersectingRegions;
-    CellSet mIntersection;
+    IdSpan mIntersectingRegions;
+    IdSpan mIntersection;
     unsigned short mValue;
+    SudokuGrid* mGrid;
 public:
-    Progress_LockedCandidates(Region* definingRegion, RegionSet&& intersectingRegions, const CellSet& intersection, unsigned short value) :
+    Progress_LockedCandidates(ProgressPool& pool, Region* definingRegion, const RegionSet& intersectingRegions, const CellSet& intersection, unsigned short value) :
         Progress(ProgressType::LockedCandidatesFound),
         mDefiningRegion(definingRegion),
-        mIntersectingRegions(intersectingRegions),
-        mIntersection(intersection),
-        mValue(value)
+        mIntersectingRegions(pool.IdsStore(intersectingRegions)),
+        mIntersection(pool.IdsStore(intersection)),
+        mValue(value),
+        mGrid(pool.GridGet())
     {}
     void ProcessProgress() override;
     void PrintMessage() const override;
@@ -143,14 +153,16 @@ public:
 class Progress_FinnedLockedCandidates : public Progress
 {
     Region* mRegion;
-    CellSet mCells;
+    IdSpan mCells;
     unsigned short mValue;
+    SudokuGrid* mGrid;
 public:
-    Progress_FinnedLockedCandidates(Region* region, CellSet&& cells, unsigned short value) :
+    Progress_FinnedLockedCandidates(ProgressPool& pool, Region* region, const CellSet& cells, unsigned short value) :
         Progress(ProgressType::FinnedLockedCandidatesFound),
         mRegion(region),
-        mCells(cells),
-        mValue(value)
+        mCells(pool.IdsStore(cells)),
+        mValue(value),
+        mGrid(pool.GridGet())
     {}
     void ProcessProgress() override;
     void PrintMessage() const override;
@@ -159,17 +171,19 @@ public:
 class Progress_Fish : public Progress
 {
 protected:
-    RegionList mDefiningRegions;
-    CellSet mDefiningCells;
-    RegionList mSecondaryRegions;
+    IdSpan mDefiningRegions;
+    IdSpan mDefiningCells;
+    IdSpan mSecondaryRegions;
     unsigned short mValue;
+    SudokuGrid* mGrid;
 public:
-    Progress_Fish(const RegionList& definingRegions, const CellList& definingCells, RegionList&& secondaryRegions, unsigned short value) :
+    Progress_Fish(ProgressPool& pool, const RegionList& definingRegions, const CellList& definingCells, const RegionList& secondaryRegions, unsigned short value) :
         Progress(ProgressType::FishFound),
-        mDefiningRegions(definingRegions),
-        mDefiningCells(definingCells.begin(), definingCells.end()),
-        mSecondaryRegions(secondaryRegions),
-        mValue(value)
+        mDefiningRegions(pool.IdsStore(definingRegions)),
+        mDefiningCells(pool.IdsStore(definingCells)),
+        mSecondaryRegions(pool.IdsStore(secondaryRegions)),
+        mValue(value),
+        mGrid(pool.GridGet())
     {}
     void ProcessProgress() override;
     void PrintMessage() const override;
@@ -177,11 +191,11 @@ public:
 
 class Progress_CannibalFish : public Progress_Fish
 {
-    CellSet mCannibalCells;
+    IdSpan mCannibalCells;
 public:
-    Progress_CannibalFish(const RegionList& definingRegions, const CellList& definingCells, RegionList&& secondaryRegions, CellSet&& cannibalCells, unsigned short value) :
-        Progress_Fish(definingRegions, definingCells, std::move(secondaryRegions), value),
-        mCannibalCells(cannibalCells)
+    Progress_CannibalFish(ProgressPool& pool, const RegionList& definingRegions, const CellList& definingCells, const RegionList& secondaryRegions, const CellSet& cannibalCells, unsigned short value) :
+        Progress_Fish(pool, definingRegions, definingCells, secondaryRegions, value),
+        mCannibalCells(pool.IdsStore(cannibalCells))
     {
         mType = ProgressType::CannibalFishFound;
     }
@@ -192,19 +206,21 @@ public:
 class Progress_FinnedFish : public Progress
 {
 protected:
-    RegionList mDefiningRegions;
-    RegionList mSecondaryRegions;
-    CellList mFins;
-    CellSet mCellsSeingFins;
+    IdSpan mDefiningRegions;
+    IdSpan mSecondaryRegions;
+    IdSpan mFins;
+    IdSpan mCellsSeingFins;
     unsigned short mValue;
+    SudokuGrid* mGrid;
 public:
-    Progress_FinnedFish(const RegionList& definingRegions, RegionList&& secondaryRegions, CellList&& fins, CellSet&& cellsSeingFins, unsigned short value) :
+    Progress_FinnedFish(ProgressPool& pool, const RegionList& definingRegions, const RegionList& secondaryRegions, const CellList& fins, const CellSet& cellsSeingFins, unsigned short value) :
         Progress(ProgressType::FinnedFishFound),
-        mDefiningRegions(definingRegions),
-        mSecondaryRegions(secondaryRegions),
-        mFins(fins),
-        mCellsSeingFins(cellsSeingFins),
-        mValue(value)
+        mDefiningRegions(pool.IdsStore(definingRegions)),
+        mSecondaryRegions(pool.IdsStore(secondaryRegions)),
+        mFins(pool.IdsStore(fins)),
+        mCellsSeingFins(pool.IdsStore(cellsSeingFins)),
+        mValue(value),
+        mGrid(pool.GridGet())
     {}
     void ProcessProgress() override;
     void PrintMessage() const override;
@@ -212,11 +228,11 @@ public:
 
 class Progress_CannibalFinnedFish : public Progress_FinnedFish
 {
-    CellSet mCannibalCells;
+    IdSpan mCannibalCells;
 public:
-    Progress_CannibalFinnedFish(const RegionList& definingRegions, RegionList&& secondaryRegions, CellList&& fins, CellSet&& cellsSeingFins, CellSet&& cannibalCells, unsigned short value) :
-        Progress_FinnedFish(definingRegions, std::move(secondaryRegions), std::move(fins), std::move(cellsSeingFins), value),
-        mCannibalCells(cannibalCells)
+    Progress_CannibalFinnedFish(ProgressPool& pool, const RegionList& definingRegions, const RegionList& secondaryRegions, const CellList& fins, const CellSet& cellsSeingFins, const CellSet& cannibalCells, unsigned short value) :
+        Progress_FinnedFish(pool, definingRegions, secondaryRegions, fins, cellsSeingFins, value),
+        mCannibalCells(pool.IdsStore(cannibalCells))
     {
         mType = ProgressType::CannibalFinnedFishFound;
     }
@@ -240,9 +256,9 @@ class Progress_ValueNotInKiller : public Progress
 {
     SudokuCell* mCell;
     Region* mRegion;
-    std::set<unsigned short> mValues;
+    CandidateMask mValues;
 public:
-    Progress_ValueNotInKiller(SudokuCell* cell, Region* region, std::set<unsigned short>&& values) :
+    Progress_ValueNotInKiller(SudokuCell* cell, Region* region, CandidateMask values) :
         Progress(ProgressType::ValueNotAllowedInKillerSum),
         mCell(cell),
         mRegion(region),
@@ -269,9 +285,9 @@ class Progress_ValueDisallowedByBifurcation : public Progress
 {
     SudokuCell* mPivot;
     SudokuCell* mCell;
-    std::set<unsigned short> mValues;
+    CandidateMask mValues;
 public:
-    Progress_ValueDisallowedByBifurcation(SudokuCell* cell, std::set<unsigned short>&& values, SudokuCell* pivot):
+    Progress_ValueDisallowedByBifurcation(SudokuCell* cell, CandidateMask values, SudokuCell* pivot):
         Progress(ProgressType::ValueDisallowedByBifurcation),
         mPivot(pivot),
         mCell(cell),
@@ -297,18 +313,18 @@ public:
 
 class Progress_GhostCage : public Progress
 {
-    CellSet mCells;
+    IdSpan mCells;
     unsigned int mTotal;
     bool mInnie;
     SudokuGrid* mGrid;
 
 public:
-    Progress_GhostCage(CellSet&& cells, unsigned int total, bool innie, SudokuGrid* grid):
+    Progress_GhostCage(ProgressPool& pool, const CellSet& cells, unsigned int total, bool innie):
         Progress(ProgressType::GhostCageAddedToGrid),
-        mCells(cells),
+        mCells(pool.IdsStore(cells)),
         mTotal(total),
         mInnie(innie),
-        mGrid(grid)
+        mGrid(pool.GridGet())
     {}
     void ProcessProgress() override;
     void PrintMessage() const override;
@@ -316,20 +332,20 @@ public:
 
 class Progress_SplitOutie : public Progress
 {
-    CellSet mCells;
+    IdSpan mCells;
     unsigned int mTotal;
     unsigned short mMinAllowedValue;
     unsigned short mMaxAllowedValue;
     SudokuGrid* mGrid;
 
 public:
-    Progress_SplitOutie(CellSet&& cells, unsigned int total, unsigned short minValue, unsigned short maxValue, SudokuGrid* grid):
+    Progress_SplitOutie(ProgressPool& pool, const CellSet& cells, unsigned int total, unsigned short minValue, unsigned short maxValue):
         Progress(ProgressType::SumConstraintOnSplitOutie),
-        mCells(cells),
+        mCells(pool.IdsStore(cells)),
         mTotal(total),
         mMinAllowedValue(minValue),
         mMaxAllowedValue(maxValue),
-        mGrid(grid)
+        mGrid(pool.GridGet())
     {}
     void ProcessProgress() override;
     void PrintMessage() const override;
@@ -409,17 +425,17 @@ public:
 
 class Impossible_TooFewValuesForRegion : public Progress_ImpossiblePuzzle
 {
-    CellSet mCells;
-    std::set<unsigned short> mValues;
+    IdSpan mCells;
+    CandidateMask mValues;
 public:
-    Impossible_TooFewValuesForRegion(CellList&& cells, std::set<unsigned short>&& values, SudokuGrid* grid) :
-        Progress_ImpossiblePuzzle(ProgressType::Impossible_TooFewValuesForRegion, grid),
-        mCells(cells.begin(), cells.end()),
+    Impossible_TooFewValuesForRegion(ProgressPool& pool, const CellList& cells, CandidateMask values) :
+        Progress_ImpossiblePuzzle(ProgressType::Impossible_TooFewValuesForRegion, pool.GridGet()),
+        mCells(pool.IdsStore(cells)),
         mValues(values)
     {}
-    Impossible_TooFewValuesForRegion(CellSet& cells, std::set<unsigned short>& values, SudokuGrid* grid) :
-        Progress_ImpossiblePuzzle(ProgressType::Impossible_TooFewValuesForRegion, grid),
-        mCells(cells),
+    Impossible_TooFewValuesForRegion(ProgressPool& pool, const CellSet& cells, CandidateMask values) :
+        Progress_ImpossiblePuzzle(ProgressType::Impossible_TooFewValuesForRegion, pool.GridGet()),
+        mCells(pool.IdsStore(cells)),
         mValues(values)
     {}
     void ProcessProgress() override;
@@ -427,17 +443,12 @@ public:
 
 class Impossible_TooManyValuesForRegion : public Progress_ImpossiblePuzzle
 {
-    CellSet mCells;
-    std::set<unsigned short> mValues;
+    IdSpan mCells;
+    CandidateMask mValues;
 public:
-    Impossible_TooManyValuesForRegion(CellSet&& cells, std::list<unsigned short>&& values, SudokuGrid* grid) :
-        Progress_ImpossiblePuzzle(ProgressType::Impossible_TooManyValuesForRegion, grid),
-        mCells(cells),
-        mValues(values.begin(), values.end())
-    {}
-    Impossible_TooManyValuesForRegion(CellSet& cells, std::set<unsigned short>& values, SudokuGrid* grid) :
-        Progress_ImpossiblePuzzle(ProgressType::Impossible_TooManyValuesForRegion, grid),
-        mCells(cells),
+    Impossible_TooManyValuesForRegion(ProgressPool& pool, const CellSet& cells, CandidateMask values) :
+        Progress_ImpossiblePuzzle(ProgressType::Impossible_TooManyValuesForRegion, pool.GridGet()),
+        mCells(pool.IdsStore(cells)),
         mValues(values)
     {}
     void ProcessProgress() override;
@@ -445,14 +456,14 @@ public:
 
 class Impossible_Fish : public Progress_ImpossiblePuzzle
 {
-    RegionList mDefiningRegion;
-    RegionList mSecondaryRegion;
+    IdSpan mDefiningRegion;
+    IdSpan mSecondaryRegion;
     unsigned short mValue;
 public:
-    Impossible_Fish( const RegionList& definingRegion, RegionList&& secondaryRegions, unsigned short value, SudokuGrid* grid) :
-        Progress_ImpossiblePuzzle(ProgressType::Impossible_Fish, grid),
-        mDefiningRegion(definingRegion),
-        mSecondaryRegion(secondaryRegions),
+    Impossible_Fish(ProgressPool& pool, const RegionList& definingRegion, const RegionList& secondaryRegions, unsigned short value) :
+        Progress_ImpossiblePuzzle(ProgressType::Impossible_Fish, pool.GridGet()),
+        mDefiningRegion(pool.IdsStore(definingRegion)),
+        mSecondaryRegion(pool.IdsStore(secondaryRegions)),
         mValue(value)
     {}
     void ProcessProgress() override;
@@ -482,25 +493,25 @@ public:
 
 class Impossible_BrokenInnie : public Progress_ImpossiblePuzzle
 {
-    CellSet mCage;
+    IdSpan mCage;
 public:
-    Impossible_BrokenInnie(CellSet&& cage, SudokuGrid* grid):
-        Progress_ImpossiblePuzzle(ProgressType::Impossible_BrokenInnie, grid),
-        mCage(cage)
+    Impossible_BrokenInnie(ProgressPool& pool, const CellSet& cage):
+        Progress_ImpossiblePuzzle(ProgressType::Impossible_BrokenInnie, pool.GridGet()),
+        mCage(pool.IdsStore(cage))
     {}
     void ProcessProgress() override;
 };
 
 class Impossible_ClashingGhostCages : public Progress_ImpossiblePuzzle
 {
-    CellSet mCage;
+    IdSpan mCage;
     unsigned int mSum1;
     unsigned int mSum2;
 
 public:
-    Impossible_ClashingGhostCages(CellSet&& cage, unsigned int sum1, unsigned int sum2, SudokuGrid* grid):
-        Progress_ImpossiblePuzzle(ProgressType::Impossible_ClashingInnies, grid),
-        mCage(cage),
+    Impossible_ClashingGhostCages(ProgressPool& pool, const CellSet& cage, unsigned int sum1, unsigned int sum2):
+        Progress_ImpossiblePuzzle(ProgressType::Impossible_ClashingInnies, pool.GridGet()),
+        mCage(pool.IdsStore(cage)),
         mSum1(sum1),
         mSum2(sum2)
     {}
@@ -509,11 +520,11 @@ public:
 
 class Impossible_BrokenOutie : public Progress_ImpossiblePuzzle
 {
-    CellSet mCage;
+    IdSpan mCage;
 public:
-    Impossible_BrokenOutie(CellSet&& cage, SudokuGrid* grid):
-        Progress_ImpossiblePuzzle(ProgressType::Impossible_BrokenOutie, grid),
-        mCage(cage)
+    Impossible_BrokenOutie(ProgressPool& pool, const CellSet& cage):
+        Progress_ImpossiblePuzzle(ProgressType::Impossible_BrokenOutie, pool.GridGet()),
+        mCage(pool.IdsStore(cage))
     {}
     void ProcessProgress() override;
 };
@@ -0,0 +1,133 @@
+#include "ProgressPool.h"
+#include "Progress.h"
+#include "SudokuCell.h"
+#include "Region.h"
+#include <algorithm>
+#include <cassert>
+
+ProgressPool::ProgressPool(SudokuGrid* grid):
+    mGrid(grid),
+    mSlabs(),
+    mFreeList(nullptr),
+    mLiveCount(0),
+    mIdChunks(),
+    mIdChunk(0),
+    mIdChunkUsed(0)
+{
+}
+
+void* ProgressPool::Allocate()
+{
+    if (!mFreeList)
+    {
+        mSlabs.emplace_back(std::make_unique<Block[]>(kBlocksPerSlab));
+        Block* slab = mSlabs.back().get();
+        for (size_t i = 0; i < kBlocksPerSlab; ++i)
+        {
+            slab[i].mNext = mFreeList;
+            mFreeList = &slab[i];
+        }
+    }
+    Block* block = mFreeList;
+    mFreeList = block->mNext;
+    ++mLiveCount;
+    return block->mStorage;
+}
+
+unsigned int* ProgressPool::IdsAllocate(size_t count)
+{
+    // a span never straddles two chunks: skip to the first chunk with enough room left
+    while (mIdChunk < mIdChunks.size() && mIdChunkUsed + count > mIdChunks[mIdChunk].mCapacity)
+    {
+        ++mIdChunk;
+        mIdChunkUsed = 0;
+    }
+    if (mIdChunk == mIdChunks.size())
+    {
+        const size_t capacity = std::max(kIdsPerChunk, count);
+        mIdChunks.push_back(IdChunk{std::make_unique<unsigned int[]>(capacity), capacity});
+        mIdChunkUsed = 0;
+    }
+    unsigned int* ids = mIdChunks[mIdChunk].mIds.get() + mIdChunkUsed;
+    mIdChunkUsed += count;
+    return ids;
+}
+
+template<class Container>
+IdSpan ProgressPool::IdsStoreImpl(const Container& items)
+{
+    unsigned int* ids = IdsAllocate(items.size());
+    unsigned int* out = ids;
+    for (const auto* item : items)
+    {
+        *out++ = item->IdGet();
+    }
+    return IdSpan(ids, static_cast<unsigned int>(items.size()));
+}
+
+IdSpan ProgressPool::IdsStore(const CellSet& cells)
+{
+    return IdsStoreImpl(cells);
+}
+
+IdSpan ProgressPool::IdsStore(const CellList& cells)
+{
+    return IdsStoreImpl(cells);
+}
+
+IdSpan ProgressPool::IdsStore(const RegionSet& regions)
+{
+    return IdsStoreImpl(regions);
+}
+
+IdSpan ProgressPool::IdsStore(const RegionList& regions)
+{
+    return IdsStoreImpl(regions);
+}
+
+void ProgressPool::Destroy(Progress* progress)
+{
+    if (!progress)
+    {
+        return;
+    }
+    // the Progress base is not necessarily at the start of the most derived object,
+    // so the block address has to be taken before the object is destroyed
+    void* storage = dynamic_cast<void*>(progress);
+    progress->~Progress();
+    Block* block = static_cast<Block*>(storage);
+    block->mNext = mFreeList;
+    mFreeList = block;
+
+    // nothing refers to the stored ids any more
+    if (--mLiveCount == 0)
+    {
+        mIdChunk = 0;
+        mIdChunkUsed = 0;
+    }
+}
+
+ProgressQueue::ProgressQueue(size_t capacity /* = 64 */):
+    mBuffer(),
+    mHead(0),
+    mCount(0)
+{
+    size_t size = 1;
+    while (size < capacity)
+    {
+        size <<= 1;
+    }
+    mBuffer.resize(size, nullptr);
+}
+
+void ProgressQueue::Grow()
+{
+    assert(mCount == mBuffer.size());
+    std::vector<Progress*> buffer(mBuffer.size() * 2, nullptr);
+    for (size_t i = 0; i < mCount; ++i)
+    {
+        buffer[i] = mBuffer[(mHead + i) & (mBuffer.size() - 1)];
+    }
+    mBuffer = std::move(buffer);
+    mHead = 0;
+}
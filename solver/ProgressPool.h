@@ -0,0 +1,147 @@
+#ifndef PROGRESS_POOL_H
+#define PROGRESS_POOL_H
+
+// Includes
+#include "Types.h"
+#include "IdSpan.h"
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Classes
+class Progress;
+
+/// <summary>
+/// Slab allocator for the progress objects of a grid. Each progress is stored in
+/// a fixed-size block; released blocks are recycled, so that once the pool has
+/// grown to the peak number of pending deductions no further allocation is made.
+/// The cells and regions of a deduction are stored by id in chunks owned by the pool,
+/// which are reused from the start whenever no progress is left alive.
+/// </summary>
+class ProgressPool
+{
+public:
+    static constexpr size_t kBlockSize = 256;       // size of the largest progress type, rounded up
+    static constexpr size_t kBlocksPerSlab = 128;
+    static constexpr size_t kIdsPerChunk = 1024;
+
+private:
+    union Block
+    {
+        Block* mNext;
+        alignas(std::max_align_t) unsigned char mStorage[kBlockSize];
+    };
+
+    struct IdChunk
+    {
+        std::unique_ptr<unsigned int[]> mIds;
+        size_t mCapacity;
+    };
+
+    SudokuGrid* mGrid;
+    std::vector<std::unique_ptr<Block[]>> mSlabs;
+    Block* mFreeList;
+    size_t mLiveCount;                  // progress created and not destroyed yet
+    std::vector<IdChunk> mIdChunks;     // never move, so the spans stay valid
+    size_t mIdChunk;                    // chunk being filled
+    size_t mIdChunkUsed;                // ids stored in it
+
+    void* Allocate();
+    unsigned int* IdsAllocate(size_t count);
+
+    template<class Container>
+    IdSpan IdsStoreImpl(const Container& items);
+
+public:
+// Constructors/Destructors
+
+    explicit ProgressPool(SudokuGrid* grid);
+    ProgressPool(const ProgressPool&) = delete;
+    ProgressPool& operator=(const ProgressPool&) = delete;
+
+// Const methods
+
+    SudokuGrid* GridGet() const { return mGrid; }
+
+// Non-const methods
+
+    /// <summary>
+    /// Construct a progress object in a block owned by the pool.
+    /// Types that store cells or regions take the pool as their first constructor argument
+    /// </summary>
+    template<class T, class... Args>
+    T* Create(Args&&... args)
+    {
+        static_assert(sizeof(T) <= kBlockSize, "Progress type does not fit in a pool block");
+        static_assert(alignof(T) <= alignof(std::max_align_t), "Progress type is over-aligned");
+        if constexpr (std::is_constructible<T, ProgressPool&, Args...>::value)
+        {
+            return new (Allocate()) T(*this, std::forward<Args>(args)...);
+        }
+        else
+        {
+            return new (Allocate()) T(std::forward<Args>(args)...);
+        }
+    }
+
+    /// <summary>
+    /// Copy the ids of the cells or regions into the pool.
+    /// The span is valid until the progress that stored it is destroyed
+    /// </summary>
+    IdSpan IdsStore(const CellSet& cells);
+    IdSpan IdsStore(const CellList& cells);
+    IdSpan IdsStore(const RegionSet& regions);
+    IdSpan IdsStore(const RegionList& regions);
+
+    /// <summary>
+    /// Destroy a progress object created by this pool and recycle its block
+    /// </summary>
+    void Destroy(Progress* progress);
+};
+
+/// <summary>
+/// FIFO of pending progress, stored in a ring buffer whose capacity is a power of two.
+/// The buffer doubles when full, so pushing never allocates in the steady state.
+/// </summary>
+class ProgressQueue
+{
+    std::vector<Progress*> mBuffer;
+    size_t mHead;
+    size_t mCount;
+
+    void Grow();
+
+public:
+// Constructors
+
+    explicit ProgressQueue(size_t capacity = 64);
+
+// Const methods
+
+    bool Empty() const { return mCount == 0; }
+    size_t Size() const { return mCount; }
+    Progress* Front() const { return mBuffer[mHead]; }
+
+// Non-const methods
+
+    void Push(Progress* progress)
+    {
+        if (mCount == mBuffer.size())
+        {
+            Grow();
+        }
+        mBuffer[(mHead + mCount) & (mBuffer.size() - 1)] = progress;
+        ++mCount;
+    }
+
+    void Pop()
+    {
+        mHead = (mHead + 1) & (mBuffer.size() - 1);
+        --mCount;
+    }
+};
+
+#endif // PROGRESS_POOL_H
@@ -0,0 +1,113 @@
+#include "PuzzleGenerator.h"
+#include <algorithm>
+
+PuzzleGenerator::PuzzleGenerator(unsigned int threadsCount, unsigned int seed):
+    mWorkers(threadsCount),
+    mRng(seed)
+{
+}
+
+bool PuzzleGenerator::HasUniqueSolution(const PuzzleData &puzzleData, const std::atomic<bool>* abort) const
+{
+    // two solutions are enough to rule out uniqueness
+    return PuzzleSolutionCounter(puzzleData, false).CountSolutions(2, abort) == 1;
+}
+
+bool PuzzleGenerator::FillGrid(const PuzzleData &layout, PuzzleSolutionCounter::Solution &outSolution, const std::atomic<bool>* abort)
+{
+    PuzzleSolutionCounter counter(layout, false);
+    counter.ShuffleRows(mRng);
+
+    std::vector<PuzzleSolutionCounter::Solution> solutions;
+    if (counter.CountSolutions(1, abort, &solutions) == 0 || *abort)
+    {
+        return false;
+    }
+    outSolution = std::move(solutions.front());
+    return true;
+}
+
+bool PuzzleGenerator::Generate(const PuzzleData &layout, Givens &outGivens, const std::atomic<bool>* abort)
+{
+    PuzzleSolutionCounter::Solution solution;
+    if (!FillGrid(layout, solution, abort))
+    {
+        return false;
+    }
+
+    PuzzleData puzzleData = layout;
+    puzzleData.mHints.clear();
+    for (CellCoord i = 0; i < solution.size(); ++i)
+    {
+        puzzleData.mGivens[i] = solution[i];
+    }
+    return Minimise(puzzleData, outGivens, abort);
+}
+
+bool PuzzleGenerator::Minimise(const PuzzleData &puzzleData, Givens &outGivens, const std::atomic<bool>* abort)
+{
+    PuzzleData current = puzzleData;
+    current.mHints.clear();
+    if (!HasUniqueSolution(current, abort) || *abort)
+    {
+        return false;
+    }
+
+    std::vector<CellCoord> candidates;
+    candidates.reserve(current.mGivens.size());
+    for (const auto& g : current.mGivens)
+    {
+        candidates.push_back(g.first);
+    }
+    std::shuffle(candidates.begin(), candidates.end(), mRng);
+
+    // Removing givens can only add solutions, so a given that cannot be removed now
+    // will not be removable later either. Each batch tests the next candidates against
+    // the current givens in parallel; the first removable one is removed, the ones that
+    // are not removable are kept for good and the other removable ones are tested again
+    // against the new set of givens.
+    const size_t batchSize = mWorkers.ThreadsCountGet();
+    size_t next = 0;
+    while (next < candidates.size())
+    {
+        const size_t count = std::min(batchSize, candidates.size() - next);
+        std::vector<char> removable(count, 0);
+        for (size_t i = 0; i < count; ++i)
+        {
+            mWorkers.Submit([this, &current, &removable, &candidates, next, i, abort]()
+            {
+                PuzzleData test = current;
+                test.mGivens.erase(candidates[next + i]);
+                removable[i] = HasUniqueSolution(test, abort);
+            });
+        }
+        mWorkers.Wait();
+        if (*abort)
+        {
+            return false;
+        }
+
+        size_t first = 0;
+        while (first < count && !removable[first])
+        {
+            ++first;
+        }
+        if (first == count)
+        {
+            next += count;
+            continue;
+        }
+
+        current.mGivens.erase(candidates[first + next]);
+        std::vector<CellCoord> retest;
+        for (size_t i = first + 1; i < count; ++i)
+        {
+            if (removable[i]) retest.push_back(candidates[next + i]);
+        }
+        candidates.erase(candidates.begin() + next, candidates.begin() + next + count);
+        candidates.insert(candidates.begin() + next, retest.begin(), retest.end());
+    }
+
+    outGivens = std::move(current.mGivens);
+    return true;
+}
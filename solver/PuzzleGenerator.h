@@ -0,0 +1,49 @@
+#ifndef PUZZLE_GENERATOR_H
+#define PUZZLE_GENERATOR_H
+
+// Includes
+#include "puzzledata.h"
+#include "PuzzleSolutionCounter.h"
+#include "WorkerPool.h"
+#include <atomic>
+#include <map>
+#include <random>
+
+/// <summary>
+/// Creates puzzles with a unique solution for the layout described by a PuzzleData
+/// (regions, diagonals and killer cages), and reduces existing puzzles to an
+/// irreducible set of givens. Removals are tested concurrently on a worker pool.
+/// </summary>
+class PuzzleGenerator
+{
+public:
+    typedef std::map<CellCoord, unsigned short> Givens;
+
+private:
+    WorkerPool mWorkers;
+    std::mt19937 mRng;
+
+    bool HasUniqueSolution(const PuzzleData& puzzleData, const std::atomic<bool>* abort) const;
+
+public:
+    PuzzleGenerator(unsigned int threadsCount = 0, unsigned int seed = std::random_device()());
+
+    /// <summary>
+    /// Fill the grid with a random solution that satisfies the constraints of the layout,
+    /// including its givens. Returns false if there is no such solution or the search was aborted.
+    /// </summary>
+    bool FillGrid(const PuzzleData& layout, PuzzleSolutionCounter::Solution& outSolution, const std::atomic<bool>* abort);
+
+    /// <summary>
+    /// Fill the grid, then remove givens in random order as long as the solution stays unique
+    /// </summary>
+    bool Generate(const PuzzleData& layout, Givens& outGivens, const std::atomic<bool>* abort);
+
+    /// <summary>
+    /// Remove givens from a puzzle with a unique solution until none of the remaining
+    /// ones can be removed without losing uniqueness
+    /// </summary>
+    bool Minimise(const PuzzleData& puzzleData, Givens& outGivens, const std::atomic<bool>* abort);
+};
+
+#endif // PUZZLE_GENERATOR_H
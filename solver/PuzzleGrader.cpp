@@ -0,0 +1,107 @@
+#include "PuzzleGrader.h"
+#include "PuzzleLoader.h"
+#include "SolverKernels.h"
+#include "SudokuGrid.h"
+#include <algorithm>
+#include <array>
+
+namespace
+{
+// cost of a single deduction of each kind, in the order of TechniqueType
+const std::array<double, static_cast<size_t>(TechniqueType::MAX_TECHNIQUES)> kTechniqueWeights =
+{
+    3.0,    // LockedCandidates
+    6.0,    // NakedSubset
+    8.0,    // HiddenSubset
+    15.0,   // Fish
+    10.0,   // InniesOuties
+    50.0    // Bifurcation, multiplied by the depth reached
+};
+const double kNakedSingleWeight = 0.05;
+const double kHiddenSingleWeight = 0.1;
+
+double ScoreGet(const SolveStatistics& statistics)
+{
+    const auto& progress = statistics.mProgressCounts;
+    double score = kNakedSingleWeight * progress[static_cast<size_t>(ProgressType::SingleOptionLeftInCell)] +
+                   kHiddenSingleWeight * progress[static_cast<size_t>(ProgressType::SingleCellInRegionForOption)];
+
+    for (size_t i = 0; i < kTechniqueWeights.size(); ++i)
+    {
+        double weight = kTechniqueWeights[i];
+        if(static_cast<TechniqueType>(i) == TechniqueType::Bifurcation)
+        {
+            weight *= std::max(1u, statistics.mMaxBifurcationDepth);
+        }
+        score += weight * statistics.mTechniqueSteps[i];
+    }
+    return score;
+}
+}
+
+GradeResult::GradeResult() :
+    mSolved(false),
+    mImpossible(false),
+    mScore(0.0),
+    mHardestTechnique(TechniqueType::MAX_TECHNIQUES),
+    mStatistics()
+{
+}
+
+PuzzleGrader::PuzzleGrader(unsigned int threadsCount /* = 0 */) :
+    mWorkers(threadsCount)
+{
+}
+
+GradeResult PuzzleGrader::Grade(const PuzzleData& puzzleData, const std::atomic<bool>* abort /* = nullptr */)
+{
+    GradeResult result;
+
+    // no observer: the grid runs without reporting its deductions
+    SudokuGrid grid(puzzleData.mSize, nullptr, SolverKernelsGet(puzzleData.mSize));
+    GridProgressManager* progressManager = grid.ProgressManagerGet();
+    progressManager->TechniqueActiveSet(TechniqueType::Fish, false);
+    // the grade depends on the techniques that find progress first
+    progressManager->SchedulingModeSet(SchedulingMode::FixedOrder);
+    PuzzleLoader(grid, puzzleData).LoadAll();
+
+    while (!progressManager->HasFinished())
+    {
+        if(abort && *abort)
+        {
+            return result;
+        }
+        progressManager->NextBatch();
+    }
+
+    result.mSolved = grid.IsSolved();
+    result.mImpossible = progressManager->HasAborted();
+    result.mStatistics = progressManager->StatisticsGet();
+    result.mScore = ScoreGet(result.mStatistics);
+
+    // techniques are ordered by difficulty
+    const auto& steps = result.mStatistics.mTechniqueSteps;
+    for (size_t i = steps.size(); i-- > 0;)
+    {
+        if(steps[i] > 0)
+        {
+            result.mHardestTechnique = static_cast<TechniqueType>(i);
+            break;
+        }
+    }
+    return result;
+}
+
+std::vector<GradeResult> PuzzleGrader::Grade(const std::vector<PuzzleData>& puzzles, const std::atomic<bool>* abort /* = nullptr */)
+{
+    std::vector<GradeResult> results(puzzles.size());
+    for (size_t i = 0; i < puzzles.size(); ++i)
+    {
+        mWorkers.Submit([&puzzles, &results, abort, i]()
+        {
+            results[i] = Grade(puzzles[i], abort);
+        });
+    }
+    mWorkers.Wait();
+    return results;
+}
@@ -0,0 +1,47 @@
+#ifndef PUZZLE_GRADER_H
+#define PUZZLE_GRADER_H
+
+// Includes
+#include "puzzledata.h"
+#include "GridProgressManager.h"
+#include "WorkerPool.h"
+#include <atomic>
+#include <vector>
+
+/// <summary>
+/// Outcome of grading a puzzle with the logical solver
+/// </summary>
+struct GradeResult
+{
+    bool mSolved;                       // the logical solver reached the solution
+    bool mImpossible;                   // the logical solver found a contradiction
+    double mScore;                      // weighted sum of the deductions used. Higher is harder
+    TechniqueType mHardestTechnique;    // MAX_TECHNIQUES if only singles were needed
+    SolveStatistics mStatistics;        // technique histogram and bifurcation depth
+
+    GradeResult();
+};
+
+/// <summary>
+/// Rates puzzles by running the logical solver to completion, without any UI.
+/// Every puzzle is solved on its own SudokuGrid, so batches are graded concurrently on a worker pool.
+/// </summary>
+class PuzzleGrader
+{
+    WorkerPool mWorkers;
+
+public:
+    explicit PuzzleGrader(unsigned int threadsCount = 0);
+
+    /// <summary>
+    /// Grade a single puzzle on the calling thread
+    /// </summary>
+    static GradeResult Grade(const PuzzleData& puzzleData, const std::atomic<bool>* abort = nullptr);
+
+    /// <summary>
+    /// Grade a batch of puzzles in parallel. The results are in the same order as the puzzles.
+    /// </summary>
+    std::vector<GradeResult> Grade(const std::vector<PuzzleData>& puzzles, const std::atomic<bool>* abort = nullptr);
+};
+
+#endif // PUZZLE_GRADER_H
@@ -0,0 +1,124 @@
+#include "PuzzleLoader.h"
+#include "SudokuGrid.h"
+#include "VariantConstraints.h"
+#include <string>
+
+PuzzleLoader::PuzzleLoader(SudokuGrid& grid, const PuzzleData& puzzleData) :
+    mGrid(grid),
+    mPuzzleData(puzzleData)
+{
+}
+
+void PuzzleLoader::LoadAll() const
+{
+    for (const auto& given : mPuzzleData.mGivens)
+    {
+        LoadGiven(given.first);
+    }
+    for (const auto& hints : mPuzzleData.mHints)
+    {
+        LoadHints(hints.first);
+    }
+    for (size_t i = 0; i < mPuzzleData.mRegions.size(); ++i)
+    {
+        LoadRegion(i);
+    }
+    for (const auto& killer : mPuzzleData.mKillerCages)
+    {
+        LoadKillerCage(killer.first);
+    }
+    if(mPuzzleData.mNegativeDiagonal)
+    {
+        LoadDiagonal(PuzzleData::Diagonal_Negative);
+    }
+    if(mPuzzleData.mPositiveDiagonal)
+    {
+        LoadDiagonal(PuzzleData::Diagonal_Positive);
+    }
+}
+
+void PuzzleLoader::LoadGiven(CellCoord id) const
+{
+    auto it = mPuzzleData.mGivens.find(id);
+    if(it == mPuzzleData.mGivens.end()) return;
+
+    const auto cell = CellGet(id);
+    mGrid.AddGivenCell(cell[0], cell[1], it->second);
+}
+
+void PuzzleLoader::LoadHints(CellCoord id) const
+{
+    auto it = mPuzzleData.mHints.find(id);
+    if(it == mPuzzleData.mHints.end()) return;
+
+    const auto cell = CellGet(id);
+    mGrid.SetCellEliminationHints(cell[0], cell[1], it->second);
+}
+
+void PuzzleLoader::LoadRegion(size_t index) const
+{
+    if(index >= mPuzzleData.mRegions.size()) return;
+    const auto& region = mPuzzleData.mRegions.at(index);
+    if(region.size() == 0) return;
+
+    mGrid.DefineRegion(CellsGet(region),
+                       region.size() == mPuzzleData.mSize ? RegionType::House_Region : RegionType::Generic_region,
+                       nullptr, "region " + std::to_string(index+1));
+}
+
+void PuzzleLoader::LoadKillerCage(CellCoord id) const
+{
+    auto it = mPuzzleData.mKillerCages.find(id);
+    if(it == mPuzzleData.mKillerCages.end()) return;
+
+    const unsigned int killerSum = it->second.first;
+    const auto firstCell = CellGet(id);
+    mGrid.DefineRegion(CellsGet(it->second.second), RegionType::KillerCage, new KillerConstraint(killerSum),
+                       "the " + std::to_string(killerSum) + " cage at r" + std::to_string(firstCell[0] + 1) + "c" + std::to_string(firstCell[1] + 1));
+}
+
+void PuzzleLoader::LoadDiagonal(PuzzleData::Diagonal diagonal) const
+{
+    mGrid.DefineRegion(DiagonalCellsGet(mPuzzleData.mSize, diagonal), RegionType::House_Region, nullptr,
+                       diagonal == PuzzleData::Diagonal_Negative ? "negative diagonal" : "positive diagonal");
+}
+
+std::vector<std::array<unsigned short, 2>> PuzzleLoader::DiagonalCellsGet(unsigned short gridSize, PuzzleData::Diagonal diagonal)
+{
+    std::vector<std::array<unsigned short, 2>> cells;
+    cells.reserve(gridSize);
+
+    if(diagonal == PuzzleData::Diagonal_Negative)
+    {
+        for (unsigned short i = 0; i < gridSize; ++i)
+        {
+            cells.push_back({i, i});
+        }
+    }
+    else if(diagonal == PuzzleData::Diagonal_Positive)
+    {
+        for (unsigned short i = 0; i < gridSize; ++i)
+        {
+            cells.push_back({i, static_cast<unsigned short>(gridSize - 1 - i)});
+        }
+    }
+
+    return cells;
+}
+
+std::array<unsigned short, 2> PuzzleLoader::CellGet(CellCoord id) const
+{
+    return {static_cast<unsigned short>(id / mPuzzleData.mSize),
+            static_cast<unsigned short>(id % mPuzzleData.mSize)};
+}
+
+std::vector<std::array<unsigned short, 2>> PuzzleLoader::CellsGet(const CellsInRegion& ids) const
+{
+    std::vector<std::array<unsigned short, 2>> cells;
+    cells.reserve(ids.size());
+    for (const CellCoord id : ids)
+    {
+        cells.push_back(CellGet(id));
+    }
+    return cells;
+}
@@ -0,0 +1,47 @@
+#ifndef PUZZLE_LOADER_H
+#define PUZZLE_LOADER_H
+
+// Includes
+#include "puzzledata.h"
+#include <array>
+#include <cstddef>
+#include <vector>
+
+// Classes
+class SudokuGrid;
+
+/// <summary>
+/// Feeds the inputs of a puzzle to a grid of the logical solver.
+/// Inputs can be loaded one at a time, as the solver thread does when the puzzle is edited,
+/// or all at once. Givens and hints must be loaded before the regions.
+/// </summary>
+class PuzzleLoader
+{
+    SudokuGrid& mGrid;
+    const PuzzleData& mPuzzleData;
+
+public:
+// Constructors
+
+    PuzzleLoader(SudokuGrid& grid, const PuzzleData& puzzleData);
+
+// Constant methods
+
+    /// <summary>
+    /// Load every given, hint, region, killer cage and diagonal of the puzzle
+    /// </summary>
+    void LoadAll() const;
+
+    void LoadGiven(CellCoord id) const;
+    void LoadHints(CellCoord id) const;
+    void LoadRegion(size_t index) const;
+    void LoadKillerCage(CellCoord id) const;
+    void LoadDiagonal(PuzzleData::Diagonal diagonal) const;
+
+private:
+    static std::vector<std::array<unsigned short, 2>> DiagonalCellsGet(unsigned short gridSize, PuzzleData::Diagonal diagonal);
+    std::array<unsigned short, 2> CellGet(CellCoord id) const;
+    std::vector<std::array<unsigned short, 2>> CellsGet(const CellsInRegion& ids) const;
+};
+
+#endif // PUZZLE_LOADER_H
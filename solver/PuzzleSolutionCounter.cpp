@@ -0,0 +1,336 @@
+#include "PuzzleSolutionCounter.h"
+#include "Trace.h"
+#include "thirdparty/dancing_links.h"
+#include <algorithm>
+#include <climits>
+#include <list>
+
+namespace
+{
+    // all the sets of count distinct digits in [from, size] adding up to sum, as bitmasks
+    void FindCombinations(unsigned short from, unsigned short size, unsigned int count, int sum,
+                          unsigned long long mask, std::vector<unsigned long long>& outCombinations)
+    {
+        if (count == 0)
+        {
+            if (sum == 0) outCombinations.push_back(mask);
+            return;
+        }
+        for (unsigned short v = from; v <= size && static_cast<int>(v) <= sum; ++v)
+        {
+            FindCombinations(v + 1, size, count - 1, sum - v, mask | (1ull << v), outCombinations);
+        }
+    }
+
+    std::vector<CellsInRegion> DiagonalsGet(const PuzzleData& puzzleData)
+    {
+        std::vector<CellsInRegion> diagonals;
+        const unsigned short size = puzzleData.mSize;
+        if (puzzleData.mNegativeDiagonal)
+        {
+            diagonals.emplace_back();
+            for (unsigned int i = 0; i < size; ++i) diagonals.back().insert(i * size + i);
+        }
+        if (puzzleData.mPositiveDiagonal)
+        {
+            diagonals.emplace_back();
+            for (unsigned int i = 0; i < size; ++i) diagonals.back().insert(i * size + size - 1 - i);
+        }
+        return diagonals;
+    }
+}
+
+PuzzleSolutionCounter::PuzzleSolutionCounter(const PuzzleData &puzzleData, bool useHints):
+    mSize(puzzleData.mSize),
+    mContradiction(false),
+    mColumnsCount(0),
+    mPrimaryColumns(),
+    mRows(),
+    mRowToPossibility(),
+    mMatrix(nullptr)
+{
+    const unsigned int size = mSize;
+    const unsigned int cellsCount = size * size;
+
+    // cell, row-digit and column-digit constraints
+    std::vector<std::vector<int>> cellColumns(cellsCount);
+    for (unsigned int cell = 0; cell < cellsCount; ++cell)
+    {
+        cellColumns[cell] = { static_cast<int>(cell),
+                              static_cast<int>(cellsCount + (cell / size) * size),
+                              static_cast<int>(2 * cellsCount + (cell % size) * size) };
+    }
+    mColumnsCount = 3 * cellsCount;
+    mPrimaryColumns.assign(mColumnsCount, true);
+
+    // regions, diagonals and killer cages
+    for (const auto& region : puzzleData.mRegions)
+    {
+        if (!region.empty())
+        {
+            AddGroup(cellColumns, region, region.size() == size);
+        }
+    }
+    for (const auto& diagonal : DiagonalsGet(puzzleData))
+    {
+        AddGroup(cellColumns, diagonal, true);
+    }
+    for (const auto& cage : puzzleData.mKillerCages)
+    {
+        AddKillerCage(cellColumns, cage.second.first, cage.second.second);
+    }
+
+    // one row per cell-digit pair; the first column of each group, except the cell column,
+    // is the one for digit 1
+    std::vector<std::vector<int>> primaryRows;
+    std::vector<unsigned int> primaryPossibilities;
+    primaryRows.reserve(cellsCount * size);
+    primaryPossibilities.reserve(cellsCount * size);
+    for (unsigned int cell = 0; cell < cellsCount; ++cell)
+    {
+        auto givenIt = puzzleData.mGivens.find(cell);
+        auto hintsIt = useHints ? puzzleData.mHints.find(cell) : puzzleData.mHints.end();
+        for (unsigned short v = 1; v <= size; ++v)
+        {
+            if (givenIt != puzzleData.mGivens.end() && givenIt->second != v) continue;
+            if (hintsIt != puzzleData.mHints.end() && hintsIt->second.count(v) > 0) continue;
+
+            std::vector<int> row;
+            row.reserve(cellColumns[cell].size());
+            row.push_back(cellColumns[cell][0]);
+            for (size_t i = 1; i < cellColumns[cell].size(); ++i)
+            {
+                row.push_back(cellColumns[cell][i] + v - 1);
+            }
+            primaryRows.push_back(std::move(row));
+            primaryPossibilities.push_back(cell * size + v - 1);
+        }
+    }
+
+    // primary rows go first, so that the search picks them before the slack rows
+    mRows.insert(mRows.begin(), std::make_move_iterator(primaryRows.begin()), std::make_move_iterator(primaryRows.end()));
+    mRowToPossibility.insert(mRowToPossibility.begin(), primaryPossibilities.begin(), primaryPossibilities.end());
+}
+
+PuzzleSolutionCounter::~PuzzleSolutionCounter()
+{
+}
+
+void PuzzleSolutionCounter::AddGroup(std::vector<std::vector<int>> &cellColumns, const CellsInRegion &cells, bool full)
+{
+    const unsigned int cellsCount = mSize * mSize;
+    if (cells.size() > mSize)
+    {
+        mContradiction = true;
+        return;
+    }
+
+    const int base = mColumnsCount;
+    mColumnsCount += mSize;
+    mPrimaryColumns.resize(mColumnsCount, full);
+    for (const auto& c : cells)
+    {
+        if (c < cellsCount) cellColumns[c].push_back(base);
+    }
+    if (!full)
+    {
+        // the digits missing from the group are covered by slack rows
+        for (int v = 0; v < mSize; ++v)
+        {
+            mRows.push_back({ base + v });
+            mRowToPossibility.push_back(kSecondaryRow);
+        }
+    }
+}
+
+void PuzzleSolutionCounter::AddKillerCage(std::vector<std::vector<int>> &cellColumns, unsigned int sum, const CellsInRegion &cells)
+{
+    const unsigned int cellsCount = mSize * mSize;
+    std::vector<unsigned long long> combinations;
+    if (cells.size() <= mSize && sum <= static_cast<unsigned int>(mSize * (mSize + 1) / 2))
+    {
+        FindCombinations(1, mSize, static_cast<unsigned int>(cells.size()), static_cast<int>(sum), 0, combinations);
+    }
+    if (combinations.empty())
+    {
+        mContradiction = true;
+        return;
+    }
+
+    const int base = mColumnsCount;
+    mColumnsCount += mSize;
+    mPrimaryColumns.resize(mColumnsCount, false);
+    for (const auto& c : cells)
+    {
+        if (c < cellsCount) cellColumns[c].push_back(base);
+    }
+    // each combination row covers the digits that are not in the cage
+    for (const auto& mask : combinations)
+    {
+        std::vector<int> row;
+        for (int v = 1; v <= mSize; ++v)
+        {
+            if (!(mask & (1ull << v))) row.push_back(base + v - 1);
+        }
+        mRows.push_back(std::move(row));
+        mRowToPossibility.push_back(kSecondaryRow);
+    }
+}
+
+void PuzzleSolutionCounter::ShuffleRows(std::mt19937 &rng)
+{
+    std::vector<size_t> order(mRows.size());
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        order[i] = i;
+    }
+    std::shuffle(order.begin(), order.end(), rng);
+
+    std::vector<std::vector<int>> rows(mRows.size());
+    std::vector<unsigned int> rowToPossibility(mRows.size());
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        rows[i] = std::move(mRows[order[i]]);
+        rowToPossibility[i] = mRowToPossibility[order[i]];
+    }
+    mRows = std::move(rows);
+    mRowToPossibility = std::move(rowToPossibility);
+    mMatrix.reset();
+}
+
+size_t PuzzleSolutionCounter::CountSolutions(size_t maxSolutionsCount, const std::atomic<bool>* abort, std::vector<Solution> *outSolutions)
+{
+    if (mContradiction || maxSolutionsCount == 0)
+    {
+        return 0;
+    }
+    if (!mMatrix)
+    {
+        mMatrix = std::make_unique<linked_matrix_GJK::LMatrix>(mRows, mColumnsCount, mPrimaryColumns);
+    }
+
+    std::list<std::vector<size_t>> solutions;
+    {
+        SUDOKU_TRACE_SCOPE("dancing_links::Exact_Cover_Solver");
+        dancing_links_GJK::Exact_Cover_Solver(*mMatrix, solutions, maxSolutionsCount, abort);
+    }
+
+    if (outSolutions)
+    {
+        for (const auto& sol : solutions)
+        {
+            outSolutions->emplace_back(mSize * mSize, 0);
+            for (const auto& r : sol)
+            {
+                const unsigned int p = mRowToPossibility[r];
+                if (p != kSecondaryRow)
+                {
+                    outSolutions->back()[p / mSize] = static_cast<unsigned short>(p % mSize + 1);
+                }
+            }
+        }
+    }
+    return solutions.size();
+}
+
+bool PuzzleSolutionCounter::IsSolution(const PuzzleData &puzzleData, const Solution &solution, bool useHints)
+{
+    const unsigned int size = puzzleData.mSize;
+    if (solution.size() != size * size)
+    {
+        return false;
+    }
+
+    const auto distinct = [&](const CellsInRegion& cells, unsigned int& outSum)
+    {
+        std::vector<bool> seen(size + 1, false);
+        outSum = 0;
+        for (const auto& c : cells)
+        {
+            const unsigned short v = solution[c];
+            if (seen[v]) return false;
+            seen[v] = true;
+            outSum += v;
+        }
+        return true;
+    };
+
+    unsigned int sum;
+    for (unsigned int i = 0; i < size; ++i)
+    {
+        CellsInRegion row, col;
+        for (unsigned int j = 0; j < size; ++j)
+        {
+            if (solution[i * size + j] == 0 || solution[i * size + j] > size) return false;
+            row.insert(i * size + j);
+            col.insert(j * size + i);
+        }
+        if (!distinct(row, sum) || !distinct(col, sum)) return false;
+    }
+    for (const auto& given : puzzleData.mGivens)
+    {
+        if (solution[given.first] != given.second) return false;
+    }
+    if (useHints)
+    {
+        for (const auto& hints : puzzleData.mHints)
+        {
+            if (hints.second.count(solution[hints.first]) > 0) return false;
+        }
+    }
+    for (const auto& region : puzzleData.mRegions)
+    {
+        if (!distinct(region, sum)) return false;
+    }
+    for (const auto& diagonal : DiagonalsGet(puzzleData))
+    {
+        if (!distinct(diagonal, sum)) return false;
+    }
+    for (const auto& cage : puzzleData.mKillerCages)
+    {
+        if (!distinct(cage.second.second, sum) || sum != cage.second.first) return false;
+    }
+    return true;
+}
+
+bool PuzzleSolutionCounter::IsRestrictionOf(const PuzzleData &puzzleData, const PuzzleData &original, bool useHints)
+{
+    if (puzzleData.mSize != original.mSize ||
+        (original.mPositiveDiagonal && !puzzleData.mPositiveDiagonal) ||
+        (original.mNegativeDiagonal && !puzzleData.mNegativeDiagonal))
+    {
+        return false;
+    }
+    for (const auto& given : original.mGivens)
+    {
+        auto it = puzzleData.mGivens.find(given.first);
+        if (it == puzzleData.mGivens.end() || it->second != given.second) return false;
+    }
+    if (useHints)
+    {
+        for (const auto& hints : original.mHints)
+        {
+            auto it = puzzleData.mHints.find(hints.first);
+            if (hints.second.empty()) continue;
+            if (it == puzzleData.mHints.end() ||
+                !std::includes(it->second.begin(), it->second.end(), hints.second.begin(), hints.second.end()))
+            {
+                return false;
+            }
+        }
+    }
+    for (size_t i = 0; i < original.mRegions.size(); ++i)
+    {
+        if (!original.mRegions[i].empty() &&
+            (i >= puzzleData.mRegions.size() || puzzleData.mRegions[i] != original.mRegions[i]))
+        {
+            return false;
+        }
+    }
+    for (const auto& cage : original.mKillerCages)
+    {
+        auto it = puzzleData.mKillerCages.find(cage.first);
+        if (it == puzzleData.mKillerCages.end() || it->second != cage.second) return false;
+    }
+    return true;
+}
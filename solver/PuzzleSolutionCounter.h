@@ -0,0 +1,67 @@
+#ifndef PUZZLE_SOLUTION_COUNTER_H
+#define PUZZLE_SOLUTION_COUNTER_H
+
+// Includes
+#include "puzzledata.h"
+#include "thirdparty/linked_matrix.h"
+#include <atomic>
+#include <climits>
+#include <memory>
+#include <random>
+#include <vector>
+
+/// <summary>
+/// Exact cover model of a puzzle built straight from its PuzzleData, so that
+/// solutions can be counted without setting up a SudokuGrid. Uses the same
+/// formulation as BruteForceSolver: one row per cell-digit pair, primary
+/// columns for cells, rows, columns and full-size regions, slack rows for
+/// smaller regions and one row per allowed combination of each killer cage.
+/// </summary>
+class PuzzleSolutionCounter
+{
+public:
+    typedef std::vector<unsigned short> Solution;   // digit of each cell
+
+private:
+    static constexpr unsigned int kSecondaryRow = UINT_MAX;
+
+    unsigned short mSize;
+    bool mContradiction;                            // the constraints cannot be satisfied at all
+    int mColumnsCount;
+    std::vector<bool> mPrimaryColumns;              // columns that cannot be covered by slack rows
+    std::vector<std::vector<int>> mRows;            // non-zero columns of each row
+    std::vector<unsigned int> mRowToPossibility;    // cell * size + digit - 1, or kSecondaryRow
+    std::unique_ptr<linked_matrix_GJK::LMatrix> mMatrix;
+
+    void AddGroup(std::vector<std::vector<int>>& cellColumns, const CellsInRegion& cells, bool full);
+    void AddKillerCage(std::vector<std::vector<int>>& cellColumns, unsigned int sum, const CellsInRegion& cells);
+
+public:
+    PuzzleSolutionCounter(const PuzzleData& puzzleData, bool useHints);
+    ~PuzzleSolutionCounter();
+
+    /// <summary>
+    /// Randomise the order in which the digits are tried, so that the
+    /// first solution found is a random one
+    /// </summary>
+    void ShuffleRows(std::mt19937& rng);
+
+    /// <summary>
+    /// Count the solutions, stopping at maxSolutionsCount or when abort is set.
+    /// The solutions found are appended to outSolutions if provided.
+    /// </summary>
+    size_t CountSolutions(size_t maxSolutionsCount, const std::atomic<bool>* abort, std::vector<Solution>* outSolutions = nullptr);
+
+    /// <summary>
+    /// Whether the filled grid satisfies all the constraints of the puzzle
+    /// </summary>
+    static bool IsSolution(const PuzzleData& puzzleData, const Solution& solution, bool useHints);
+
+    /// <summary>
+    /// Whether puzzleData has all the constraints of original, and possibly more. If so,
+    /// every solution of puzzleData is also a solution of original.
+    /// </summary>
+    static bool IsRestrictionOf(const PuzzleData& puzzleData, const PuzzleData& original, bool useHints);
+};
+
+#endif // PUZZLE_SOLUTION_COUNTER_H
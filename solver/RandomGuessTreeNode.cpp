@@ -2,6 +2,8 @@
 #include "SudokuGrid.h"
 #include "SudokuCell.h"
 #include "GridProgressManager.h"
+#include "TranspositionTable.h"
+#include "SolvingTechnique.h"
 #include <cassert>
 
 RandomGuessTreeRoot::RandomGuessTreeRoot(SudokuGrid* parentGrid, SudokuGrid* bifurcationGrid, CellId pivot, BifurcationTechnique* technique):
@@ -22,7 +24,7 @@ RandomGuessTreeRoot::RandomGuessTreeRoot(SudokuGrid* parentGrid, SudokuGrid* bif
     }
 
     size_t i = 0;
-    mChildNodes.reserve(mParentGrid->CellGet(mPivot)->OptionsGet().size());
+    mChildNodes.reserve(mParentGrid->CellGet(mPivot)->OptionsCountGet());
     for(const auto& v : mParentGrid->CellGet(mPivot)->OptionsGet())
     {
         mChildNodes.push_back(std::make_unique<RandomGuessTreeNode>(mBifurcationGrid, mPivot, v, this, i, mTechnique));
@@ -54,7 +56,7 @@ void RandomGuessTreeRoot::NextStep()
         }
         if(!valid)
         {
-            progressManager->RegisterProgress(std::make_shared<Impossible_NoSolutionByBifurcation>(mParentGrid->CellGet(mPivot), mParentGrid));
+            progressManager->RegisterProgress<Impossible_NoSolutionByBifurcation>(mParentGrid->CellGet(mPivot), mParentGrid);
         }
         mFinished = true;
     }
@@ -70,12 +72,16 @@ void RandomGuessTreeRoot::NodeHasFinished(unsigned short nodeIndex)
     {
         auto it = mEliminatedValues.begin();
         auto endIt = mEliminatedValues.end();
+        const std::vector<CandidateMask>& finalOptions = mChildNodes.at(nodeIndex)->FinalOptionsGet();
         while (it != endIt)
         {
-            SudokuCell* cell = mBifurcationGrid->CellGet(it->first);
-            for (const auto& v : cell->OptionsGet())
+            CandidateMask options = finalOptions.at(it->first);
+            for (unsigned short v = 1; options; ++v, options >>= 1)
             {
-                it->second.erase(v);
+                if (options & 1)
+                {
+                    it->second.erase(v);
+                }
             }
 
             if(it->second.size() == 0)
@@ -91,7 +97,7 @@ void RandomGuessTreeRoot::NodeHasFinished(unsigned short nodeIndex)
     else
     {
         unsigned short option = mChildNodes.at(nodeIndex)->PivotValueGet();
-        progressManager->RegisterProgress(std::make_shared<Progress_OptionRemovedViaGuessing>(mParentGrid->CellGet(mPivot), option));
+        progressManager->RegisterProgress<Progress_OptionRemovedViaGuessing>(mParentGrid->CellGet(mPivot), option);
     }
 
     mChildNodes[nodeIndex]->Uninit();
@@ -100,7 +106,7 @@ void RandomGuessTreeRoot::NodeHasFinished(unsigned short nodeIndex)
         for (auto& eliminations : mEliminatedValues)
         {
             SudokuCell* cell = mParentGrid->CellGet(eliminations.first);
-            progressManager->RegisterProgress(std::make_shared<Progress_ValueDisallowedByBifurcation>(cell, std::move(eliminations.second), mParentGrid->CellGet(mPivot)));
+            progressManager->RegisterProgress<Progress_ValueDisallowedByBifurcation>(cell, CandidatesMaskGet(eliminations.second), mParentGrid->CellGet(mPivot));
         }
     }
     else
@@ -116,14 +122,32 @@ RandomGuessTreeNode::RandomGuessTreeNode(SudokuGrid* bifurcGrid, CellId pivot, u
     mPivot(pivot),
     mPivotValue(pivotValue),
     mIsNodeValid(true),
+    mStateHash(0),
+    mIsResultCached(false),
+    mFinalOptions(),
     mTechnique(technique)
 {
 }
 
+unsigned int RandomGuessTreeNode::DepthBudgetGet() const
+{
+    return mTechnique->TargetDepthGet() - mTechnique->DepthGet();
+}
+
 void RandomGuessTreeNode::Init()
 {
     mGrid->TakeSnapshot();
     mGrid->CellGet(mPivot)->RemoveAllOtherOptions(mPivotValue);
+
+    // the same state may have been searched already from another pivot or in a previous pass
+    mStateHash = mGrid->CandidatesHashGet();
+    const BifurcationResult* result = mGrid->TranspositionTableGet()->Find(mStateHash, DepthBudgetGet());
+    mIsResultCached = result != nullptr;
+    if(mIsResultCached)
+    {
+        mIsNodeValid = result->mIsValid;
+        mFinalOptions = result->mOptions;
+    }
 }
 
 void RandomGuessTreeNode::Uninit()
@@ -141,23 +165,39 @@ unsigned short RandomGuessTreeNode::PivotValueGet() const
     return mPivotValue;
 }
 
+const std::vector<CandidateMask> &RandomGuessTreeNode::FinalOptionsGet() const
+{
+    return mFinalOptions;
+}
+
 void RandomGuessTreeNode::NextStep()
 {
     GridProgressManager* progressManager = mGrid->ProgressManagerGet();
     assert(mParentNode != nullptr);
 
-    if(progressManager->HasFinished())
+    if(mIsResultCached)
+    {
+        mParentNode->NodeHasFinished(mIndex);
+    }
+    else if(progressManager->HasFinished())
     {
         if(progressManager->HasAborted())
         {
             mIsNodeValid = false;
-            mParentNode->NodeHasFinished(mIndex);
+            mFinalOptions.clear();
         }
         else
         {
             mIsNodeValid = true;
-            mParentNode->NodeHasFinished(mIndex);
+            const size_t cellsCount = static_cast<size_t>(mGrid->SizeGet()) * mGrid->SizeGet();
+            mFinalOptions.resize(cellsCount);
+            for (size_t i = 0; i < cellsCount; ++i)
+            {
+                mFinalOptions[i] = mGrid->CellGet(i)->OptionsMaskGet();
+            }
         }
+        mGrid->TranspositionTableGet()->Store(mStateHash, DepthBudgetGet(), {mIsNodeValid, mFinalOptions});
+        mParentNode->NodeHasFinished(mIndex);
     }
     else
     {
@@ -2,6 +2,8 @@
 #define RANDOMGUESSTREENODE_H
 
 #include "Types.h"
+#include "CandidateMask.h"
+#include <cstdint>
 
 class RandomGuessTreeRoot;
 class RandomGuessTreeNode;
@@ -38,8 +40,17 @@ class RandomGuessTreeNode
     CellId mPivot;
     unsigned short mPivotValue;
     bool mIsNodeValid;
+    std::uint64_t mStateHash;                   // candidates hash of the grid once the pivot value is set
+    bool mIsResultCached;                       // the result was found in the transposition table
+    std::vector<CandidateMask> mFinalOptions;   // options of each cell at the end of a valid search
 
     BifurcationTechnique* mTechnique;
+
+    /// <summary>
+    /// Bifurcation depth the search of this node is allowed to use
+    /// </summary>
+    unsigned int DepthBudgetGet() const;
+
 public:
     RandomGuessTreeNode(SudokuGrid* bifurcGrid, CellId pivot, unsigned short pivotValue, RandomGuessTreeRoot* parent, unsigned short index, BifurcationTechnique* technique);
 
@@ -47,6 +58,7 @@ public:
     void Uninit();
     bool IsValidGet() const;
     unsigned short PivotValueGet() const;
+    const std::vector<CandidateMask>& FinalOptionsGet() const;
     void NextStep();
 };
 
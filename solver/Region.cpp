@@ -3,13 +3,15 @@
 #include "SudokuGrid.h"
 #include "RegionUpdatesManager.h"
 #include "GridProgressManager.h"
+#include "RegionArena.h"
 #include <algorithm>
 #include <iterator>
 #include <cassert>
 #include <numeric>
 #include <sstream>
 
-Region::Region(SudokuGrid* parentGrid, CellSet&& cells, bool startingRegion):
+Region::Region(SudokuGrid* parentGrid, RegionId id, CellSet&& cells, bool startingRegion):
+    mId(id),
     mName(),
     mCells(cells),
     mConfirmedValues(),
@@ -37,8 +39,9 @@ void Region::Init()
     mAllowedValues.clear();
     mValueToCellMap.clear();
     mUpdateManager->Reset();
-    mRightNode.reset();
-    mLeftNode.reset();
+    mRightNode = nullptr;
+    mLeftNode = nullptr;
+    mParents.clear();
     mSnapshot.reset();
 
     // construct the value to cell map and find the allowed and confirmed values if any
@@ -48,8 +51,9 @@ void Region::Init()
     }
     for (SudokuCell* const c : mCells)
     {
-        for (const unsigned short& v : c->OptionsGet())
+        for (CandidateMask options = c->OptionsMaskGet(); options; options &= options - 1)
         {
+            const unsigned short v = static_cast<unsigned short>(LowestBitIndexGet(options) + 1);
             mAllowedValues.insert(v);
             mValueToCellMap.at(v).insert(c);
         }
@@ -64,7 +68,7 @@ void Region::Init()
     }
     else if (mAllowedValues.size() < mCells.size())
     {
-        mParentGrid->ProgressManagerGet()->RegisterProgress(std::make_shared<Impossible_TooFewValuesForRegion>(mCells, mAllowedValues, mParentGrid));
+        mParentGrid->ProgressManagerGet()->RegisterProgress<Impossible_TooFewValuesForRegion>(mCells, CandidatesMaskGet(mAllowedValues));
     }
 
     for(const auto& constraint : mAdditionalConstraints)
@@ -73,9 +77,9 @@ void Region::Init()
     }
 }
 
-std::string Region::IdGet() const
+RegionId Region::IdGet() const
 {
-    return mName;
+    return mId;
 }
 
 const CellSet& Region::CellsGet() const
@@ -94,6 +98,17 @@ std::vector<std::array<unsigned short, 2> > Region::CellCoordsGet() const
     return cells;
 }
 
+std::vector<CellId> Region::CellIdsGet() const
+{
+    std::vector<CellId> ids;
+    ids.reserve(mSize);
+    for(const auto &c : mCells)
+    {
+        ids.push_back(c->IdGet());
+    }
+    return ids;
+}
+
 unsigned short Region::SizeGet() const
 {
     return mSize;
@@ -160,19 +175,19 @@ RegionUpdatesManager* Region::UpdateManagerGet() const
     return mUpdateManager.get();
 }
 
-const RegionList& Region::ParentNodesGet() const
+const std::vector<Region*>& Region::ParentNodesGet() const
 {
     return mParents;
 }
 
 Region* Region::LeftNodeGet() const
 {
-    return mLeftNode.get();
+    return mLeftNode;
 }
 
 Region* Region::RightNodeGet() const
 {
-    return mRightNode.get();
+    return mRightNode;
 }
 
 bool Region::IsLeafNode() const
@@ -193,24 +208,6 @@ void Region::LeafNodesGet(RegionSet& regions)
     }
 }
 
-RegionSPtr Region::RegionSharedPtrGet() const
-{
-    RegionSPtr result;
-    if (mParents.size() > 0) // the region is not a starting region
-    {
-        auto it = mParents.begin();
-        if ((*it)->LeftNodeGet() == this)
-        {
-            result = (*it)->mLeftNode;
-        }
-        else if ((*it)->RightNodeGet() == this)
-        {
-            result = (*it)->mRightNode;
-        }
-    }
-    return result;
-}
-
 Region* Region::FindLeafNodeWithCell(const SudokuCell* cell)
 {
     Region* result = nullptr;
@@ -314,13 +311,13 @@ bool Region::IsContainedInCells(const CellSet &cells) const
     return true;
 }
 
-bool Region::PartitionRegion(const RegionSPtr& leftNode, Region*& outRightNode)
+bool Region::PartitionRegion(Region* leftNode, Region*& outRightNode)
 {
     // Assumption: the cells in the left and right node have no viable option in common.
     // This function must be called AFTER the allowed values in the left node have been removed from the right node!
     bool result = false;
     outRightNode = nullptr;
-    if (leftNode.get() != this && this->IsLeafNode())
+    if (leftNode != this && this->IsLeafNode())
     {
         CellSet rightRegionCells;
         for (SudokuCell* cell : mCells)
@@ -339,7 +336,7 @@ bool Region::PartitionRegion(const RegionSPtr& leftNode, Region*& outRightNode)
             if (rightRegionCells.size() > 0 && leftSize > 0) // the left node does not already include all the cells in this region
             {
                 mLeftNode = leftNode;
-                mRightNode = std::make_shared<Region>(mParentGrid, std::move(rightRegionCells), false);
+                mRightNode = mParentGrid->RegionArenaGet()->Create(mParentGrid, std::move(rightRegionCells), false);
                 mLeftNode->mParents.push_back(this);
                 mRightNode->mParents.push_back(this);
 
@@ -361,10 +358,10 @@ bool Region::PartitionRegion(const RegionSPtr& leftNode, Region*& outRightNode)
                 // Notify the additonal constraints of the partition
                 for (const auto& constraint : mAdditionalConstraints)
                 {
-                    constraint->OnRegionPartitioned(mLeftNode.get(), mRightNode.get());
+                    constraint->OnRegionPartitioned(mLeftNode, mRightNode);
                 }
 
-                outRightNode = mRightNode.get();
+                outRightNode = mRightNode;
             }
             else if (leftSize > 0)
             {
@@ -384,23 +381,23 @@ bool Region::PartitionRegion(const RegionSPtr& leftNode, Region*& outRightNode)
                 // Notify the additonal constraints of the partition
                 for (const auto& constraint : mAdditionalConstraints)
                 {
-                    constraint->OnRegionPartitioned(mLeftNode.get(), mRightNode.get());
+                    constraint->OnRegionPartitioned(mLeftNode, mRightNode);
                 }
             }
             else
             {
-                auto rightNode = std::make_shared<Region>(mParentGrid, std::move(rightRegionCells), false);
+                Region* rightNode = mParentGrid->RegionArenaGet()->Create(mParentGrid, std::move(rightRegionCells), false);
                 MergeRegions(rightNode);
-                outRightNode = mRightNode.get();
+                outRightNode = mRightNode;
             }
         }
     }
     return result;
 }
 
-void Region::MergeRegions(const RegionSPtr& rightNode)
+void Region::MergeRegions(Region* rightNode)
 {
-    if (rightNode.get() == this)
+    if (rightNode == this)
         return;
 
     // this assumes that this and right node are made up of the same cells.
@@ -421,7 +418,7 @@ void Region::MergeRegions(const RegionSPtr& rightNode)
     // Notify the additonal constraints of the partition
     for (const auto& constraint : mAdditionalConstraints)
     {
-        constraint->OnRegionPartitioned(mLeftNode.get(), mRightNode.get());
+        constraint->OnRegionPartitioned(mLeftNode, mRightNode);
     }
 }
 
@@ -429,7 +426,7 @@ void Region::AddConfirmedValue(unsigned value)
 {
     if (mAllowedValues.count(value) == 0) // the value we are trying to add must be in the allowed values
     {
-        mParentGrid->ProgressManagerGet()->RegisterProgress(std::make_shared<Impossible_NoCellLeftForValueInRegion>(this, value, mParentGrid));
+        mParentGrid->ProgressManagerGet()->RegisterProgress<Impossible_NoCellLeftForValueInRegion>(this, value, mParentGrid);
         return;
     }
 
@@ -444,7 +441,7 @@ void Region::AddConfirmedValue(unsigned value)
             SudokuCell* nakedSingle = *(mValueToCellMap.at(value).begin());
             if(!nakedSingle->IsSolved())
             {
-                mParentGrid->ProgressManagerGet()->RegisterProgress(std::make_shared<Progress_SingleCellForOption>(nakedSingle, this, value));
+                mParentGrid->ProgressManagerGet()->RegisterProgress<Progress_SingleCellForOption>(nakedSingle, this, value);
             }
         }
 
@@ -463,11 +460,11 @@ void Region::AddConfirmedValue(unsigned value)
                     RemoveAllowedValue(v);
                 }
             }
-            mParentGrid->ProgressManagerGet()->RegisterProgress(std::make_shared <Progress_RegionBecameClosed>(this));
+            mParentGrid->ProgressManagerGet()->RegisterProgress<Progress_RegionBecameClosed>(this);
         }
         else if (mConfirmedValues.size() > mCells.size())
         {
-            mParentGrid->ProgressManagerGet()->RegisterProgress(std::make_shared<Impossible_TooManyValuesForRegion>(mCells, mConfirmedValues, mParentGrid));
+            mParentGrid->ProgressManagerGet()->RegisterProgress<Impossible_TooManyValuesForRegion>(mCells, CandidatesMaskGet(mConfirmedValues));
         }
     }
 }
@@ -482,7 +479,7 @@ void Region::UpdateValueMap(unsigned short removedValue, SudokuCell* removedFrom
             SudokuCell* nakedSingle = *(mValueToCellMap.at(removedValue).begin());
             if(!nakedSingle->IsSolved())
             {
-                mParentGrid->ProgressManagerGet()->RegisterProgress(std::make_shared<Progress_SingleCellForOption>(nakedSingle, this, removedValue));
+                mParentGrid->ProgressManagerGet()->RegisterProgress<Progress_SingleCellForOption>(nakedSingle, this, removedValue);
             }
         }
         // Notify the additonal constraints of the removed option
@@ -525,7 +522,7 @@ void Region::TakeSnapshot()
         v->TakeSnaphot();
     }
     mUpdateManager->TakeSnapshot();
-    mSnapshot = std::make_unique<Snapshot>(mConfirmedValues, mAllowedValues, mValueToCellMap);
+    mSnapshot = std::make_unique<Snapshot>(mConfirmedValues, mAllowedValues, mValueToCellMap, mParents.size());
 }
 
 void Region::RestoreSnapshot()
@@ -535,6 +532,8 @@ void Region::RestoreSnapshot()
         mConfirmedValues = std::move(mSnapshot->mConfirmedValues);
         mAllowedValues = std::move(mSnapshot->mAllowedValues);
         mValueToCellMap = std::move(mSnapshot->mValueToCellMap);
+        // parents added after the snapshot may not exist anymore
+        mParents.resize(mSnapshot->mParentsCount);
         mSnapshot.reset();
 
         mUpdateManager->RestoreSnapshot();
@@ -542,8 +541,8 @@ void Region::RestoreSnapshot()
         {
             v->RestoreSnaphot();
         }
-        mLeftNode.reset();
-        mRightNode.reset();
+        mLeftNode = nullptr;
+        mRightNode = nullptr;
     }
 }
 
@@ -551,7 +550,7 @@ void Region::RemoveAllowedValue(unsigned short value)
 {
     if (mConfirmedValues.count(value) > 0) // the value we are trying to remove must NOT be in the confirmed values
     {
-        mParentGrid->ProgressManagerGet()->RegisterProgress(std::make_shared<Impossible_NoCellLeftForValueInRegion>(this, value, mParentGrid));
+        mParentGrid->ProgressManagerGet()->RegisterProgress<Impossible_NoCellLeftForValueInRegion>(this, value, mParentGrid);
         return;
     }
 
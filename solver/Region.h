@@ -15,6 +15,7 @@ class RegionUpdatesManager;
 class Region
 {
 protected:
+    const RegionId mId;                         // index of the region in the arena of its grid
     std::string mName;
     CellSet mCells;				// cells that make up the region
     std::set<unsigned short> mConfirmedValues;	// values that must be in this group
@@ -27,25 +28,29 @@ protected:
     std::list<std::unique_ptr<VariantConstraint>> mAdditionalConstraints;	// additional constraints applying to this region
     std::unique_ptr<RegionUpdatesManager> mUpdateManager;
 
-    RegionSPtr mRightNode;			// for efficiency purposes, a region can be partitioned into child regions
-    RegionSPtr mLeftNode;			// for efficiency purposes, a region can be partitioned into child regions
-    RegionList mParents;			// parent Regions that this Region has been partitioned from
+    Region* mRightNode;				// for efficiency purposes, a region can be partitioned into child regions
+    Region* mLeftNode;				// for efficiency purposes, a region can be partitioned into child regions
+    std::vector<Region*> mParents;	// parent Regions that this Region has been partitioned from
 
     friend class RegionsManager;
     friend class GhostCagesManager;
+    friend struct RegionIdLess;
 
     struct Snapshot
     {
         std::set<unsigned short> mConfirmedValues;
         std::set<unsigned short> mAllowedValues;
         std::map<unsigned short, CellSet> mValueToCellMap;
+        size_t mParentsCount;
 
         Snapshot(const std::set<unsigned short>& confirmed,
                  const std::set<unsigned short>& allowed,
-                 const std::map<unsigned short, CellSet>& map):
+                 const std::map<unsigned short, CellSet>& map,
+                 size_t parentsCount):
             mConfirmedValues(confirmed),
             mAllowedValues(allowed),
-            mValueToCellMap(map)
+            mValueToCellMap(map),
+            mParentsCount(parentsCount)
         {}
     };
     std::unique_ptr<Snapshot> mSnapshot;
@@ -53,15 +58,16 @@ protected:
 public:
 // Constructors
 
-    Region(SudokuGrid* parentGrid, CellSet&& cells, bool startingRegion);
+    Region(SudokuGrid* parentGrid, RegionId id, CellSet&& cells, bool startingRegion);
     ~Region();
     void Init();
 
 // Public getters
 
-    std::string IdGet() const;
+    RegionId IdGet() const;
     const CellSet& CellsGet() const;
     std::vector<std::array<unsigned short, 2>> CellCoordsGet() const;
+    std::vector<CellId> CellIdsGet() const;
     unsigned short SizeGet() const;
     const std::set<unsigned short>& ConfirmedValuesGet() const;
     const std::set<unsigned short>& AllowedValuesGet() const;
@@ -71,16 +77,12 @@ public:
     bool IsValueAllowed(unsigned short value) const;
     SudokuGrid* GridGet() const;
     RegionUpdatesManager* UpdateManagerGet() const;
-    const RegionList& ParentNodesGet() const;
+    const std::vector<Region*>& ParentNodesGet() const;
     Region* LeftNodeGet() const;
     Region* RightNodeGet() const;
     bool IsLeafNode() const;
     void LeafNodesGet(RegionSet& regions);
     /// <summary>
-    /// get the shared pointer managing this Region
-    /// </summary>
-    RegionSPtr RegionSharedPtrGet() const;
-    /// <summary>
     /// Find the leaf node containing the specified cell
     /// </summary>
     Region* FindLeafNodeWithCell(const SudokuCell* cell);
@@ -126,12 +128,17 @@ private:
     /// If this Region is a leaf node, creates two childred nodes from this Region.
     /// The two new nodes will not share any cell or value
     /// </summary>
-    bool PartitionRegion(const RegionSPtr& leftNode, Region*& outRightNode);
+    bool PartitionRegion(Region* leftNode, Region*& outRightNode);
 
     /// <summary>
     /// Merge this region to the one passed as parameter
     /// </summary>
-    void MergeRegions(const RegionSPtr& rightNode);
+    void MergeRegions(Region* rightNode);
 };
 
+inline bool RegionIdLess::operator()(const Region* a, const Region* b) const
+{
+    return a->mId < b->mId;
+}
+
 #endif // !REGION_H
@@ -0,0 +1,98 @@
+#include "RegionArena.h"
+#include "SudokuGrid.h"
+#include "SudokuCell.h"
+#include <algorithm>
+#include <cassert>
+
+RegionArena::RegionArena():
+    mRegions(),
+    mFreeIds(),
+    mSnapshotSize(kNoSnapshot)
+{
+}
+
+RegionArena::~RegionArena()
+{
+    Clear();
+}
+
+size_t RegionArena::SizeGet() const
+{
+    return mRegions.size();
+}
+
+Region* RegionArena::RegionGet(RegionId id)
+{
+    std::optional<Region>& slot = mRegions.at(id);
+    return slot ? &*slot : nullptr;
+}
+
+Region* RegionArena::Create(SudokuGrid* parentGrid, CellSet&& cells, bool startingRegion)
+{
+    RegionId id;
+    // free slots are only reused outside snapshots,
+    // so that restoring one only has to drop the slots at the back
+    if (mSnapshotSize == kNoSnapshot && !mFreeIds.empty())
+    {
+        id = mFreeIds.back();
+        mFreeIds.pop_back();
+    }
+    else
+    {
+        id = static_cast<RegionId>(mRegions.size());
+        mRegions.emplace_back();
+    }
+    mRegions[id].emplace(parentGrid, id, std::move(cells), startingRegion);
+    return &*mRegions[id];
+}
+
+Region* RegionArena::Create(SudokuGrid* parentGrid, const IdSpan& cells, bool startingRegion)
+{
+    // the ids come sorted, so each cell goes at the end of the set
+    CellSet cellSet;
+    for (const CellId id : cells)
+    {
+        cellSet.emplace_hint(cellSet.end(), parentGrid->CellGet(id));
+    }
+    return Create(parentGrid, std::move(cellSet), startingRegion);
+}
+
+void RegionArena::Clear()
+{
+    // regions do not touch each other when destroyed, so the order does not matter:
+    // they go in reverse slot order, which differs from the creation order once slots are reused
+    while (!mRegions.empty())
+    {
+        mRegions.pop_back();
+    }
+    mFreeIds.clear();
+    mSnapshotSize = kNoSnapshot;
+}
+
+void RegionArena::TakeSnapshot()
+{
+    mSnapshotSize = mRegions.size();
+}
+
+void RegionArena::RestoreSnapshot()
+{
+    if (mSnapshotSize != kNoSnapshot)
+    {
+        assert(mSnapshotSize <= mRegions.size());
+        while (mRegions.size() > mSnapshotSize)
+        {
+            mRegions.pop_back();
+        }
+        mSnapshotSize = kNoSnapshot;
+    }
+}
+
+void RegionArena::ShrinkToLastRegion()
+{
+    while (!mRegions.empty() && !mRegions.back())
+    {
+        mRegions.pop_back();
+    }
+    const RegionId size = static_cast<RegionId>(mRegions.size());
+    mFreeIds.erase(std::remove_if(mFreeIds.begin(), mFreeIds.end(), [=](RegionId id) { return id >= size; }), mFreeIds.end());
+}
@@ -0,0 +1,90 @@
+#ifndef REGION_ARENA_H
+#define REGION_ARENA_H
+
+// Includes
+#include "Types.h"
+#include "Region.h"
+#include "IdSpan.h"
+#include <deque>
+#include <limits>
+#include <optional>
+
+/// <summary>
+/// Owns all the regions of a grid: the starting regions, the ghost cages
+/// and the child nodes created when a region is partitioned.
+/// Each region is addressed by a compact id, which is its slot in the arena.
+/// Regions never move once created, so Region* can be handed out freely.
+/// </summary>
+class RegionArena
+{
+    static constexpr size_t kNoSnapshot = std::numeric_limits<size_t>::max();
+
+    std::deque<std::optional<Region>> mRegions;     // slot i holds the region with id i, if alive
+    std::vector<RegionId> mFreeIds;                 // released slots that can be reused
+    size_t mSnapshotSize;                           // number of slots when the snapshot was taken
+
+public:
+// Constructors/Destructors
+
+    RegionArena();
+    ~RegionArena();
+
+// Public getters
+
+    /// <summary>
+    /// Number of slots in the arena. Every region id is smaller than this.
+    /// </summary>
+    size_t SizeGet() const;
+    Region* RegionGet(RegionId id);
+
+// Non-constant methods
+
+    /// <summary>
+    /// Construct a new region in the arena
+    /// </summary>
+    Region* Create(SudokuGrid* parentGrid, CellSet&& cells, bool startingRegion);
+    /// <summary>
+    /// Construct a new region in the arena from the ids of its cells, in increasing order
+    /// </summary>
+    Region* Create(SudokuGrid* parentGrid, const IdSpan& cells, bool startingRegion);
+
+    /// <summary>
+    /// Destroy every region for which pred returns true.
+    /// The caller must make sure nothing still points to them.
+    /// Any snapshot taken before is discarded.
+    /// </summary>
+    template<class Predicate>
+    void ReleaseIf(Predicate pred);
+
+    /// <summary>
+    /// Destroy all the regions
+    /// </summary>
+    void Clear();
+
+    /// <summary>
+    /// Regions created after the snapshot are destroyed when it is restored
+    /// </summary>
+    void TakeSnapshot();
+    void RestoreSnapshot();
+
+private:
+    void ShrinkToLastRegion();
+};
+
+template<class Predicate>
+void RegionArena::ReleaseIf(Predicate pred)
+{
+    mSnapshotSize = kNoSnapshot;
+    for (size_t id = 0; id < mRegions.size(); ++id)
+    {
+        std::optional<Region>& slot = mRegions[id];
+        if (slot && pred(&*slot))
+        {
+            slot.reset();
+            mFreeIds.push_back(static_cast<RegionId>(id));
+        }
+    }
+    ShrinkToLastRegion();
+}
+
+#endif // REGION_ARENA_H
@@ -4,95 +4,113 @@
 #include "SudokuGrid.h"
 #include "GridProgressManager.h"
 #include "SolvingTechnique.h"
+#include <algorithm>
 #include <cassert>
 
 RegionUpdatesManager::RegionUpdatesManager(Region* region):
     mRegion(region),
+    mCells(region->CellsGet().begin(), region->CellsGet().end()),
+    mCellTechniques(0),
+    mValueTechniques(0),
     mHotCells(),
     mHotValues(),
     mSnapshot(nullptr)
 {
+    mHotValues.fill(0);
     for (int i = 0; i < static_cast<int>(TechniqueType::MAX_TECHNIQUES); ++i)
     {
         if (mRegion->GridGet()->ProgressManagerGet()->TechniqueGet(static_cast<TechniqueType>(i))
             ->ObservedComponentGet() == SolvingTechnique::ObserveCells)
         {
-            mHotCells[static_cast<TechniqueType>(i)] = CellSet();
+            mCellTechniques |= 1u << i;
+            mHotCells[i] = CellMask(static_cast<unsigned int>(mCells.size()));
         }
         else if (mRegion->GridGet()->ProgressManagerGet()->TechniqueGet(static_cast<TechniqueType>(i))
             ->ObservedComponentGet() == SolvingTechnique::ObserveValues)
         {
-            mHotValues[static_cast<TechniqueType>(i)] = std::set<unsigned short>();
+            mValueTechniques |= 1u << i;
         }
     }
 }
 
-bool RegionUpdatesManager::IsRegionReadyForTechnique(TechniqueType type, std::set<SudokuCell*>& outCells) const
+bool RegionUpdatesManager::ObservesCells(TechniqueType type) const
 {
-    assert(mRegion->IsLeafNode());
+    return (mCellTechniques >> static_cast<int>(type)) & 1;
+}
 
-    if (mHotCells.count(type))
+bool RegionUpdatesManager::CellIndexGet(const SudokuCell* cell, unsigned int& outIndex) const
+{
+    auto it = std::lower_bound(mCells.begin(), mCells.end(), cell, CellIdLess());
+    if (it == mCells.end() || *it != cell)
     {
-        outCells = mHotCells.at(type);
-        return outCells.size() > 0;
+        return false;
     }
-    return false;
+    outIndex = static_cast<unsigned int>(it - mCells.begin());
+    return true;
 }
 
-bool RegionUpdatesManager::IsRegionReadyForTechnique(TechniqueType type, SudokuCell* cell) const
+SudokuCell* RegionUpdatesManager::CellGet(unsigned int index) const
+{
+    return mCells[index];
+}
+
+bool RegionUpdatesManager::IsRegionReadyForTechnique(TechniqueType type, CellMask& outCells) const
 {
     assert(mRegion->IsLeafNode());
 
-    if (mHotCells.count(type))
+    if (!ObservesCells(type))
     {
-        return mHotCells.at(type).count(cell);
+        return false;
     }
-    return false;
+    outCells = mHotCells[static_cast<size_t>(type)];
+    return outCells.Any();
+}
+
+bool RegionUpdatesManager::IsRegionReadyForTechnique(TechniqueType type, SudokuCell* cell) const
+{
+    assert(mRegion->IsLeafNode());
+
+    unsigned int index = 0;
+    return ObservesCells(type) && CellIndexGet(cell, index) && mHotCells[static_cast<size_t>(type)].Test(index);
 }
 
-bool RegionUpdatesManager::IsRegionReadyForTechnique(TechniqueType type, std::set<unsigned short>& outValues) const
+bool RegionUpdatesManager::IsRegionReadyForTechnique(TechniqueType type, CandidateMask& outValues) const
 {
     assert(mRegion->IsLeafNode());
 
-    if (mHotValues.count(type))
-    {
-        outValues = mHotValues.at(type);
-        return outValues.size() > 0;
-    }
-    return false;
+    outValues = mHotValues[static_cast<size_t>(type)];
+    return outValues != 0;
 }
 
 bool RegionUpdatesManager::IsRegionReadyForTechnique(TechniqueType type, unsigned short value) const
 {
     assert(mRegion->IsLeafNode());
 
-    if (mHotValues.count(type))
-    {
-        return mHotValues.at(type).count(value);
-    }
-    return false;
+    return (mHotValues[static_cast<size_t>(type)] & CandidateBitGet(value)) != 0;
 }
 
-void RegionUpdatesManager::OnNakedSetFound(const CellSet& nakedSubset, const std::set<unsigned short>& values, bool isHidden)
+void RegionUpdatesManager::OnNakedSetFound(const IdSpan& nakedSubset, const std::set<unsigned short>& values, bool isHidden)
 {
+    const SudokuGrid* grid = mRegion->GridGet();
     if (!mRegion->IsLeafNode()) // call OnNakedSubsetFound on each child node
     {
-        CellSet leftNakedSubset;
-        CellSet rightNakedSubset;
+        std::vector<CellId> leftNakedSubset;
+        std::vector<CellId> rightNakedSubset;
         std::set<unsigned short> leftValues;
         std::set<unsigned short> rightValues;
         auto leftNode = mRegion->LeftNodeGet();
         auto rightNode = mRegion->RightNodeGet();
 
-        for (auto it = nakedSubset.begin(), end = nakedSubset.end(); it != end; ++it)
+        for (const CellId id : nakedSubset)
         {
-            if (leftNode && leftNode->CellsGet().count(*it))
+            SudokuCell* cell = grid->CellGet(id);
+            if (leftNode && leftNode->CellsGet().count(cell))
             {
-                leftNakedSubset.insert(*it);
+                leftNakedSubset.push_back(id);
             }
-            else if (rightNode && rightNode->CellsGet().count(*it))
+            else if (rightNode && rightNode->CellsGet().count(cell))
             {
-                rightNakedSubset.insert(*it);
+                rightNakedSubset.push_back(id);
             }
         }
         for (auto it = values.begin(), end = values.end(); it != end; ++it)
@@ -108,11 +126,11 @@ void RegionUpdatesManager::OnNakedSetFound(const CellSet& nakedSubset, const std
         }
         if (leftNakedSubset.size() > 0 && leftValues.size() == leftNakedSubset.size())
         {
-            leftNode->UpdateManagerGet()->OnNakedSetFound(leftNakedSubset, leftValues, isHidden);
+            leftNode->UpdateManagerGet()->OnNakedSetFound(IdSpan(leftNakedSubset), leftValues, isHidden);
         }
         if (rightNakedSubset.size() > 0 && rightValues.size() == rightNakedSubset.size())
         {
-            rightNode->UpdateManagerGet()->OnNakedSetFound(rightNakedSubset, rightValues, isHidden);
+            rightNode->UpdateManagerGet()->OnNakedSetFound(IdSpan(rightNakedSubset), rightValues, isHidden);
         }
 
         return;
@@ -122,7 +140,7 @@ void RegionUpdatesManager::OnNakedSetFound(const CellSet& nakedSubset, const std
     {
         // for the cells in the naked subset:
         // remove all the options other than the ones making up the naked subset
-        if (nakedSubset.count(cell) > 0)
+        if (nakedSubset.Contains(cell->IdGet()))
         {
             cell->RemoveAllOtherOptions(values);
         }
@@ -140,14 +158,18 @@ void RegionUpdatesManager::OnNakedSetFound(const CellSet& nakedSubset, const std
         {
             for (const auto& v : values)
             {
-                mHotValues.at(TechniqueType::HiddenSubset).erase(v);
+                mHotValues[static_cast<size_t>(TechniqueType::HiddenSubset)] &= ~CandidateBitGet(v);
             }
         }
-        else
+        else if (ObservesCells(TechniqueType::NakedSubset))
         {
-            for (const auto& c : nakedSubset)
+            for (const CellId id : nakedSubset)
             {
-                mHotCells.at(TechniqueType::NakedSubset).erase(c);
+                unsigned int index = 0;
+                if (CellIndexGet(grid->CellGet(id), index))
+                {
+                    mHotCells[static_cast<size_t>(TechniqueType::NakedSubset)].Reset(index);
+                }
             }
         }
     }
@@ -171,29 +193,26 @@ void RegionUpdatesManager::OnCellOptionRemoved(SudokuCell* cell, unsigned short
         return;
     }
 
-    if (mRegion->CellsGet().count(cell) > 0)
+    unsigned int index = 0;
+    if (CellIndexGet(cell, index))
     {
-        auto it = mHotCells.begin();
-        while (it != mHotCells.end())
+        for (unsigned int t = mCellTechniques; t; t &= t - 1)
         {
-            it->second.insert(cell);
-            ++it;
+            mHotCells[LowestBitIndexGet(t)].Set(index);
         }
     }
     if(mRegion->HasConfirmedValue(value))
     {
-        auto it = mHotValues.begin();
-        while (it != mHotValues.end())
+        for (unsigned int t = mValueTechniques; t; t &= t - 1)
         {
-            it->second.insert(value);
-            ++it;
+            mHotValues[LowestBitIndexGet(t)] |= CandidateBitGet(value);
         }
     }
 
     mRegion->UpdateValueMap(value, cell);
 }
 
-void RegionUpdatesManager::OnLockedCandidatesFound(const CellSet& intersection, unsigned short lockedValue)
+void RegionUpdatesManager::OnLockedCandidatesFound(const IdSpan& intersection, unsigned short lockedValue)
 {
     if (!mRegion->IsLeafNode()) // call OnLockedCandidatesFound on the appropriate child node
     {
@@ -215,17 +234,17 @@ void RegionUpdatesManager::OnLockedCandidatesFound(const CellSet& intersection,
             return;
         }
 
-        CellSet childIntersection;
-        for (auto it = intersection.begin(), end = intersection.end(); it != end; ++it)
+        std::vector<CellId> childIntersection;
+        for (const CellId id : intersection)
         {
-            if (childNode->CellsGet().count(*it))
+            if (childNode->CellsGet().count(mRegion->GridGet()->CellGet(id)))
             {
-                childIntersection.insert(*it);
+                childIntersection.push_back(id);
             }
         }
         if (childNode && childIntersection.size() > 0)
         {
-            childNode->UpdateManagerGet()->OnLockedCandidatesFound(childIntersection, lockedValue);
+            childNode->UpdateManagerGet()->OnLockedCandidatesFound(IdSpan(childIntersection), lockedValue);
         }
 
         return;
@@ -234,15 +253,15 @@ void RegionUpdatesManager::OnLockedCandidatesFound(const CellSet& intersection,
     mRegion->AddConfirmedValue(lockedValue);
     for (SudokuCell* cell : mRegion->CellsGet())
     {
-        if (intersection.count(cell) == 0)
+        if (!intersection.Contains(cell->IdGet()))
         {
             cell->RemoveOption(lockedValue);
         }
     }
-    mHotValues.at(TechniqueType::LockedCandidates).erase(lockedValue);
+    mHotValues[static_cast<size_t>(TechniqueType::LockedCandidates)] &= ~CandidateBitGet(lockedValue);
 }
 
-void RegionUpdatesManager::OnFishFound(const CellSet& definingSet, unsigned short fishValue)
+void RegionUpdatesManager::OnFishFound(const IdSpan& definingSet, unsigned short fishValue)
 {
     if (!mRegion->IsLeafNode()) // call OnFishFound on the appropriate child node
     {
@@ -263,7 +282,7 @@ void RegionUpdatesManager::OnFishFound(const CellSet& definingSet, unsigned shor
 
     for (SudokuCell* c : mRegion->CellsGet())
     {
-        if (definingSet.count(c) == 0)
+        if (!definingSet.Contains(c->IdGet()))
         {
             c->RemoveOption(fishValue);
         }
@@ -275,32 +294,18 @@ void RegionUpdatesManager::OnTechniqueFailed(TechniqueType type)
 {
     assert(mRegion->IsLeafNode());
 
-    {
-        auto it = mHotCells.find(type);
-        if (it != mHotCells.end())
-        {
-            it->second.clear();
-        }
-    }
-    {
-        auto it = mHotValues.find(type);
-        if (it != mHotValues.end())
-        {
-            it->second.clear();
-        }
-    }
+    mHotCells[static_cast<size_t>(type)].Clear();
+    mHotValues[static_cast<size_t>(type)] = 0;
 }
 
 void RegionUpdatesManager::OnTechniqueFailed(TechniqueType type, SudokuCell* cell)
 {
     assert(mRegion->IsLeafNode());
 
+    unsigned int index = 0;
+    if (ObservesCells(type) && CellIndexGet(cell, index))
     {
-        auto it = mHotCells.find(type);
-        if (it != mHotCells.end())
-        {
-            it->second.erase(cell);
-        }
+        mHotCells[static_cast<size_t>(type)].Reset(index);
     }
 }
 
@@ -308,33 +313,16 @@ void RegionUpdatesManager::OnTechniqueFailed(TechniqueType type, unsigned short
 {
     assert(mRegion->IsLeafNode());
 
-    {
-        auto it = mHotValues.find(type);
-        if (it != mHotValues.end())
-        {
-            it->second.erase(value);
-        }
-    }
+    mHotValues[static_cast<size_t>(type)] &= ~CandidateBitGet(value);
 }
 
 void RegionUpdatesManager::ResetHotArrays()
 {
+    for (auto& cells : mHotCells)
     {
-        auto it = mHotCells.begin();
-        while (it != mHotCells.end())
-        {
-            it->second.clear();
-            ++it;
-        }
-    }
-    {
-        auto it = mHotValues.begin();
-        while (it != mHotValues.end())
-        {
-            it->second.clear();
-            ++it;
-        }
+        cells.Clear();
     }
+    mHotValues.fill(0);
 }
 
 void RegionUpdatesManager::OnRegionPartitioned()
@@ -344,42 +332,43 @@ void RegionUpdatesManager::OnRegionPartitioned()
     auto rightNode = mRegion->RightNodeGet();
 
     RegionUpdatesManager* leftManager = leftNode ? leftNode->UpdateManagerGet() : nullptr;
-    RegionUpdatesManager* rightManager = rightNode ? mRegion->UpdateManagerGet() : nullptr;
+    RegionUpdatesManager* rightManager = rightNode ? rightNode->UpdateManagerGet() : nullptr;
 
+    for (unsigned int t = mCellTechniques; t; t &= t - 1)
     {
-        auto it = mHotCells.begin();
-        while (it != mHotCells.end())
+        const unsigned int type = LowestBitIndexGet(t);
+        mHotCells[type].ForEach([&](CellId i)
         {
-            for (SudokuCell* const& c : it->second)
+            SudokuCell* c = mCells[i];
+            unsigned int childIndex = 0;
+            if (leftManager && leftManager->CellIndexGet(c, childIndex))
             {
-                if (leftNode && leftNode->CellsGet().count(c) > 0)
-                {
-                    leftManager->mHotCells.at(it->first).insert(c);
-                }
-                else if(rightNode && rightNode->CellsGet().count(c) > 0)
-                {
-                    rightManager->mHotCells.at(it->first).insert(c);
-                }
+                leftManager->mHotCells[type].Set(childIndex);
             }
-            ++it;
-        }
+            else if (rightManager && rightManager->CellIndexGet(c, childIndex))
+            {
+                rightManager->mHotCells[type].Set(childIndex);
+            }
+        });
     }
+    for (unsigned int t = mValueTechniques; t; t &= t - 1)
     {
-        auto it = mHotValues.begin();
-        while (it != mHotValues.end())
+        const unsigned int type = LowestBitIndexGet(t);
+        CandidateMask values = mHotValues[type];
+        for (unsigned short v = 1; values; ++v, values >>= 1)
         {
-            for (unsigned short const& v : it->second)
+            if (!(values & 1))
             {
-                if (leftNode && leftNode->AllowedValuesGet().count(v) > 0)
-                {
-                    leftManager->mHotValues.at(it->first).insert(v);
-                }
-                else if (rightNode && rightNode->AllowedValuesGet().count(v) > 0)
-                {
-                    rightManager->mHotValues.at(it->first).insert(v);
-                }
+                continue;
+            }
+            if (leftNode && leftNode->AllowedValuesGet().count(v) > 0)
+            {
+                leftManager->mHotValues[type] |= CandidateBitGet(v);
+            }
+            else if (rightNode && rightNode->AllowedValuesGet().count(v) > 0)
+            {
+                rightManager->mHotValues[type] |= CandidateBitGet(v);
             }
-            ++it;
         }
     }
 
@@ -402,24 +391,15 @@ void RegionUpdatesManager::OnConfirmedValueAdded(unsigned short value)
         return;
     }
 
-    auto it = mHotValues.begin();
-    while (it != mHotValues.end())
+    for (unsigned int t = mValueTechniques; t; t &= t - 1)
     {
-        it->second.insert(value);
-        ++it;
+        mHotValues[LowestBitIndexGet(t)] |= CandidateBitGet(value);
     }
 }
 
 void RegionUpdatesManager::Reset()
 {
-    for (auto& cells : mHotCells)
-    {
-        cells.second.clear();
-    }
-    for (auto& values : mHotValues)
-    {
-        values.second.clear();
-    }
+    ResetHotArrays();
     mSnapshot.reset();
 }
 
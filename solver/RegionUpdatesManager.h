@@ -2,9 +2,14 @@
 #define REGION_UPDATES_MANAGER_H
 
 #include"Types.h"
+#include "CandidateMask.h"
+#include "CellMask.h"
+#include "IdSpan.h"
+#include <array>
+#include <vector>
 
-typedef std::map<TechniqueType, CellSet> HotCellsArray;
-typedef std::map<TechniqueType, std::set<unsigned short>> HotValuesArray;
+typedef std::array<CellMask, static_cast<size_t>(TechniqueType::MAX_TECHNIQUES)> HotCellsArray;
+typedef std::array<CandidateMask, static_cast<size_t>(TechniqueType::MAX_TECHNIQUES)> HotValuesArray;
 
 /// <summary>
 /// Deals with updating the viable options of the cells in a Region
@@ -12,8 +17,12 @@ typedef std::map<TechniqueType, std::set<unsigned short>> HotValuesArray;
 class RegionUpdatesManager
 {
     Region* mRegion;	// Region this class acts on
+    std::vector<SudokuCell*> mCells;	// cells of mRegion sorted by id: the hot cells are indexed by position in here
+    unsigned int mCellTechniques;	// bit set of the techniques observing cells
+    unsigned int mValueTechniques;	// bit set of the techniques observing values
     // keep track of the cells whose options have changed
     // since the last time a certain technique was applied
+    // (one bit per cell of the region)
     HotCellsArray mHotCells;
     // keep track of the values that have been removed from any cell in the region
     // since the last time a certain technique was applied
@@ -30,6 +39,12 @@ class RegionUpdatesManager
     };
     std::unique_ptr<Snapshot> mSnapshot;
 
+    bool ObservesCells(TechniqueType type) const;
+    /// <summary>
+    /// Position of a cell within mCells. Returns false if the cell is not in the region
+    /// </summary>
+    bool CellIndexGet(const SudokuCell* cell, unsigned int& outIndex) const;
+
 public:
 // Constructors
 
@@ -38,9 +53,14 @@ public:
 // Const methods
 
     /// <summary>
-    /// Check whether any cell has change that would justify the use of certain technique on this region
+    /// Cell at a certain position of the region, as indexed by the hot cells
+    /// </summary>
+    SudokuCell* CellGet(unsigned int index) const;
+    /// <summary>
+    /// Check whether any cell has change that would justify the use of certain technique on this region.
+    /// The cells are indexed by their position in the region (see CellGet)
     /// </summary>
-    bool IsRegionReadyForTechnique(TechniqueType type, std::set<SudokuCell*>& outCells) const;
+    bool IsRegionReadyForTechnique(TechniqueType type, CellMask& outCells) const;
     /// <summary>
     /// Check whether cell has changed since the last time a certain technique was used
     /// </summary>
@@ -48,7 +68,7 @@ public:
     /// <summary>
     /// Check whether any value has been removed that would justify the use of certain technique on this region
     /// </summary>
-    bool IsRegionReadyForTechnique(TechniqueType type, std::set<unsigned short>& outValues) const;
+    bool IsRegionReadyForTechnique(TechniqueType type, CandidateMask& outValues) const;
     /// <summary>
     /// Check whether a value has been removed since the last time a certain technique was used
     /// </summary>
@@ -57,9 +77,10 @@ public:
 // Non-const methods
 
     /// <summary>
-    /// Callback function for when a naked subset is found within the managed Region
+    /// Callback function for when a naked subset is found within the managed Region.
+    /// The subset is given by cell id
     /// </summary>
-    void OnNakedSetFound(const CellSet& nakedSubset, const std::set<unsigned short>& values, bool isHidden);
+    void OnNakedSetFound(const IdSpan& nakedSubset, const std::set<unsigned short>& values, bool isHidden);
 
     /// <summary>
     /// Callback function for when an option is removed from a cell within the managed Region
@@ -67,14 +88,16 @@ public:
     void OnCellOptionRemoved(SudokuCell* cell, unsigned short value);
 
     /// <summary>
-    /// Callback function for when a locked candidate is found within the managed Region
+    /// Callback function for when a locked candidate is found within the managed Region.
+    /// The intersection is given by cell id
     /// </summary>
-    void OnLockedCandidatesFound(const CellSet& intersection, unsigned short lockedValue);
+    void OnLockedCandidatesFound(const IdSpan& intersection, unsigned short lockedValue);
 
     /// <summary>
-    /// Callback function for when a fish is found whose defining set contains the managed Region
+    /// Callback function for when a fish is found whose defining set contains the managed Region.
+    /// The defining set is given by cell id
     /// </summary>
-    void OnFishFound(const CellSet& definingSet, unsigned short fishValue);
+    void OnFishFound(const IdSpan& definingSet, unsigned short fishValue);
 
     /// <summary>
     /// Notifies the region updates manager that a certain technique
@@ -3,6 +3,7 @@
 #include "Region.h"
 #include "SudokuCell.h"
 #include "RegionUpdatesManager.h"
+#include "RegionArena.h"
 #include <iterator>
 #include <algorithm>
 #include <cassert>
@@ -17,12 +18,12 @@ RegionsManager::RegionsManager(SudokuGrid* parentGrid):
 {
     for (size_t i = 0; i < static_cast<size_t>(RegionType::MAX_TYPES); i++)
     {
-        mStartingRegions.emplace_back(std::list<RegionSPtr>());
+        mStartingRegions.emplace_back(std::list<Region*>());
     }
 
     unsigned short gridSize = parentGrid->SizeGet();
     mCellToRegionsMap = CellToRegionMap(gridSize * gridSize);
-    mCellToConnectedCellsMap = CellToCellsMap(gridSize * gridSize);
+    mCellToConnectedCellsMap = CellToCellsMap(gridSize * gridSize, CellMask(gridSize * gridSize));
 }
 
 RegionsManager::~RegionsManager()
@@ -39,26 +40,6 @@ const RegionSet& RegionsManager::RegionsGet() const
     return mLeafRegions;
 }
 
-RegionSPtr RegionsManager::RegionSharedPtrGet(const Region* r) const
-{
-    RegionSPtr regionSPtr;
-    regionSPtr = r->RegionSharedPtrGet();
-    if (regionSPtr.get() == nullptr) // the region is one of the starting regions
-    {
-        for (size_t i = 0; i < static_cast<size_t>(RegionType::MAX_TYPES); i++)
-        {
-            const std::list<RegionSPtr>& l = mStartingRegions.at(i);
-            auto it = std::find_if(l.begin(), l.end(), [=](RegionSPtr s_ptr) {return s_ptr.get() == r; });
-            if (it != l.end())
-            {
-                regionSPtr = *it;
-                break;
-            }
-        }
-    }
-    return regionSPtr;
-}
-
 const RegionSet& RegionsManager::RegionsWithCellGet(const SudokuCell* cell) const
 {
     return mCellToRegionsMap.at(cell->IdGet());
@@ -77,7 +58,7 @@ void RegionsManager::RegionsWithCellsGet(RegionSet& outSet, const CellSet& cells
         RegionSet group1(std::move(outSet));
         const RegionSet& group2 = RegionsWithCellGet(cell);
         outSet.clear();
-        std::set_intersection(group1.begin(), group1.end(), group2.begin(), group2.end(), std::inserter(outSet, outSet.begin()));
+        std::set_intersection(group1.begin(), group1.end(), group2.begin(), group2.end(), std::inserter(outSet, outSet.begin()), outSet.key_comp());
 
         if (outSet.size() == 0)
         {
@@ -86,7 +67,29 @@ void RegionsManager::RegionsWithCellsGet(RegionSet& outSet, const CellSet& cells
     }
 }
 
-void RegionsManager::PartitionRegionsWithCells(CellSet cells)
+void RegionsManager::RegionsWithCellsGet(RegionSet& outSet, const IdSpan& cells) const
+{
+    if (cells.empty())
+        return;
+
+    outSet = mCellToRegionsMap.at(cells.front());
+
+    // find the regions containing ALL the cells in the set
+    for (const CellId id : cells)
+    {
+        RegionSet group1(std::move(outSet));
+        const RegionSet& group2 = mCellToRegionsMap.at(id);
+        outSet.clear();
+        std::set_intersection(group1.begin(), group1.end(), group2.begin(), group2.end(), std::inserter(outSet, outSet.begin()), outSet.key_comp());
+
+        if (outSet.size() == 0)
+        {
+            break;
+        }
+    }
+}
+
+void RegionsManager::PartitionRegionsWithCells(const IdSpan& cells)
 {
     RegionSet outSplitRegions;
     RegionsWithCellsGet(outSplitRegions, cells);
@@ -104,32 +107,32 @@ void RegionsManager::PartitionRegionsWithCells(CellSet cells)
     }
 
     // check whether a region made up by these cells already exists
-    RegionSPtr regionSPtr;
-    for (const Region* r : outSplitRegions)
+    Region* leftNode = nullptr;
+    for (Region* r : outSplitRegions)
     {
         // region with these cells alreday exists
         if (r->CellsGet().size() == cells.size() && !r->IsStartingRegion())
         {
-            regionSPtr = RegionSharedPtrGet(r);
+            leftNode = r;
             break;
         }
     }
-    if (!regionSPtr) // create a new Region
+    if (!leftNode) // create a new Region
     {
-        regionSPtr = std::make_shared<Region>(mParentGrid, std::move(cells), false);
+        leftNode = mParentGrid->RegionArenaGet()->Create(mParentGrid, cells, false);
     }
 
     for (Region* r : outSplitRegions)
     {
-        PartitionRegionWithCells(regionSPtr, r);
+        PartitionRegionWithCells(leftNode, r);
     }
 }
 
-void RegionsManager::PartitionRegionWithCells(const RegionSPtr& regionSPtr, Region* region)
+void RegionsManager::PartitionRegionWithCells(Region* leftNode, Region* region)
 {
     assert(region->IsLeafNode());
     Region* newRegion;
-    bool success = region->PartitionRegion(regionSPtr, newRegion);
+    bool success = region->PartitionRegion(leftNode, newRegion);
 
     if (success)
     {
@@ -138,9 +141,9 @@ void RegionsManager::PartitionRegionWithCells(const RegionSPtr& regionSPtr, Regi
         {
             mLeafRegions.insert(newRegion);
         }
-        if (regionSPtr)
+        if (leftNode)
         {
-            mLeafRegions.insert(regionSPtr.get());
+            mLeafRegions.insert(leftNode);
         }
         // update the cell to regions map
         for (SudokuCell* c : region->CellsGet())
@@ -151,9 +154,9 @@ void RegionsManager::PartitionRegionWithCells(const RegionSPtr& regionSPtr, Regi
             {
                 regionsWithCell.insert(newRegion);
             }
-            else if (regionSPtr && regionSPtr->CellsGet().count(c) > 0)
+            else if (leftNode && leftNode->CellsGet().count(c) > 0)
             {
-                regionsWithCell.insert(regionSPtr.get());
+                regionsWithCell.insert(leftNode);
             }
             UpdateConnectedCells(c);
         }
@@ -192,7 +195,7 @@ void RegionsManager::PartitionRegionWithCells(const RegionSPtr& regionSPtr, Regi
 
             for (Region* r : outSplitRegions)
             {
-                r->MergeRegions(RegionSharedPtrGet(newRegion));
+                r->MergeRegions(newRegion);
                 mLeafRegions.erase(r);
                 // update the cell to regions map
                 for (SudokuCell* c : newRegion->CellsGet())
@@ -209,26 +212,39 @@ void RegionsManager::PartitionRegionWithCells(const RegionSPtr& regionSPtr, Regi
 void RegionsManager::UpdateConnectedCells(SudokuCell* c)
 {
     const auto& regions = RegionsWithCellGet(c);
-    auto& connectedCellsSet = mCellToConnectedCellsMap[c->IdGet()];
-    connectedCellsSet.clear();
+    auto& connectedCells = mCellToConnectedCellsMap[c->IdGet()];
+    connectedCells.Clear();
 
     for (const auto& r : regions)
     {
-        connectedCellsSet.insert(r->CellsGet().begin(), r->CellsGet().end());
+        for (const auto& rc : r->CellsGet())
+        {
+            connectedCells.Set(rc->IdGet());
+        }
     }
-    connectedCellsSet.erase(c);
+    connectedCells.Reset(c->IdGet());
 }
 
-void RegionsManager::RegisterRegion(RegionSPtr regionSPtr, RegionType regionType)
+void RegionsManager::CellsFromMaskGet(const CellMask& cells, CellSet& outCells, unsigned short value) const
+{
+    outCells.clear();
+    cells.ForEach([&](CellId id)
+    {
+        SudokuCell* c = mParentGrid->CellGet(id);
+        if (value == 0 || c->HasGuess(value))
+        {
+            outCells.emplace_hint(outCells.end(), c);
+        }
+    });
+}
+
+void RegionsManager::RegisterRegion(Region* region, RegionType regionType)
 {
-    Region* region = regionSPtr.get();
     // Add region to the starting regions if it's not there already
-    auto it = std::find_if(mStartingRegions.at(static_cast<size_t>(regionType)).begin(),
-        mStartingRegions.at(static_cast<size_t>(regionType)).end(),
-        [=](const RegionSPtr& r) { return region == r.get(); });
-    if (it == mStartingRegions.at(static_cast<size_t>(regionType)).end())
+    std::list<Region*>& startingRegions = mStartingRegions.at(static_cast<size_t>(regionType));
+    if (std::find(startingRegions.begin(), startingRegions.end(), region) == startingRegions.end())
     {
-        mStartingRegions.at(static_cast<size_t>(regionType)).emplace_back(regionSPtr);
+        startingRegions.emplace_back(region);
     }
 
     // add the group to the list
@@ -244,7 +260,7 @@ void RegionsManager::RegisterRegion(RegionSPtr regionSPtr, RegionType regionType
     // then the former can be partitioned.
     // Any additional constraint needs to be already attached
     // to the region at this point.
-    std::list<RegionSPtr> subsets;
+    std::list<Region*> subsets;
     Region* congruentRegion = nullptr;
     for (Region* r : mLeafRegions)
     {
@@ -256,18 +272,19 @@ void RegionsManager::RegisterRegion(RegionSPtr regionSPtr, RegionType regionType
             }
             else if(r->IsClosed())
             {
-                subsets.push_back(RegionSharedPtrGet(r));
+                subsets.push_back(r);
             }
         }
     }
     if (subsets.size() > 0)
     {
-        for (const RegionSPtr& sub : subsets)
+        for (Region* sub : subsets)
         {
-            region->UpdateManagerGet()->OnNakedSetFound(sub->CellsGet(), sub->ConfirmedValuesGet(), false);
+            const std::vector<CellId> subCells = sub->CellIdsGet();
+            region->UpdateManagerGet()->OnNakedSetFound(IdSpan(subCells), sub->ConfirmedValuesGet(), false);
             if (sub->IsStartingRegion())
             {
-                PartitionRegionsWithCells(sub->CellsGet());
+                PartitionRegionsWithCells(IdSpan(subCells));
             }
             else if(sub->IsLeafNode())
             {
@@ -288,7 +305,7 @@ void RegionsManager::RegisterRegion(RegionSPtr regionSPtr, RegionType regionType
         }
         else
         {
-            region->MergeRegions(RegionSharedPtrGet(congruentRegion));
+            region->MergeRegions(congruentRegion);
             mLeafRegions.erase(region);
             // update the cell to regions map
             for (SudokuCell* c : region->CellsGet())
@@ -311,15 +328,21 @@ void RegionsManager::Reset()
     }
     for (auto& c : mCellToConnectedCellsMap)
     {
-        c.clear();
+        c.Clear();
     }
+    std::set<const Region*> startingRegions;
     for (size_t i = 0; i < static_cast<size_t>(RegionType::MAX_TYPES); i++)
     {
         for (auto& r : mStartingRegions.at(i))
         {
             r->Reset();
+            startingRegions.insert(r);
         }
     }
+    // once the starting regions have been reset, nothing points to
+    // the regions they were partitioned into
+    mParentGrid->RegionArenaGet()->ReleaseIf([&](const Region* r) { return startingRegions.count(r) == 0; });
+
     for (size_t i = 0; i < static_cast<size_t>(RegionType::MAX_TYPES); i++)
     {
         for (auto& r : mStartingRegions.at(i))
@@ -339,7 +362,7 @@ void RegionsManager::Clear()
     }
     for (auto& c : mCellToConnectedCellsMap)
     {
-        c.clear();
+        c.Clear();
     }
     for (size_t i = 0; i < static_cast<size_t>(RegionType::MAX_TYPES); i++)
     {
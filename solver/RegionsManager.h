@@ -4,12 +4,14 @@
 // Include
 #include "Types.h"
 #include "Region.h"
+#include "IdSpan.h"
+#include "CellMask.h"
 #include "SudokuCell.h"
 
 // Typedefs
 typedef std::vector<RegionSet> CellToRegionMap;
-typedef std::vector<CellSet> CellToCellsMap;
-typedef std::vector<std::list<RegionSPtr>> RegionsList;
+typedef std::vector<CellMask> CellToCellsMap;
+typedef std::vector<std::list<Region*>> RegionsList;
 
 /// <summary>
 /// This class keeps track of the regions defined by the puzzle.
@@ -59,6 +61,7 @@ public:
     /// Finds a returns all the regions cantaining all the cells passed as parameters.
     /// </summary>
     void RegionsWithCellsGet(RegionSet& outSet, const CellSet& cells) const;
+    void RegionsWithCellsGet(RegionSet& outSet, const IdSpan& cells) const;
 
     /// <summary>
     /// Find the list of cells that can "see" all the defining cells
@@ -80,12 +83,12 @@ public:
     /// one made up by the cells in the argument and the other made up by
     /// the remaining cells.
     /// </summary>
-    void PartitionRegionsWithCells(CellSet cells);
+    void PartitionRegionsWithCells(const IdSpan& cells);
 
     /// <summary>
     /// Define a staring region of the puzzle
     /// </summary>
-    void RegisterRegion(RegionSPtr regionSPtr, RegionType regionType);
+    void RegisterRegion(Region* region, RegionType regionType);
 
     /// <summary>
     /// Reset all the regions to their initial state
@@ -101,19 +104,23 @@ public:
     void RestoreSnapshot();
 
 private:
-    RegionSPtr RegionSharedPtrGet(const Region* r) const;
-
     /// <summary>
     /// Partition the argument region into two new smaller regions,
-    /// one made up by the cells in the argument regionSPtr and the other
-    /// made up by theremaining cells.
+    /// one made up by the cells in the argument leftNode and the other
+    /// made up by the remaining cells.
     /// </summary>
-    void PartitionRegionWithCells(const RegionSPtr& regionSPtr, Region* region);
+    void PartitionRegionWithCells(Region* leftNode, Region* region);
 
     /// <summary>
     /// Update the set of cells that can see cell c
     /// </summary>
     void UpdateConnectedCells(SudokuCell* c);
+
+    /// <summary>
+    /// Replace the content of outCells with the cells in the mask.
+    /// If value is not 0, only the cells that have it as a viable option are kept
+    /// </summary>
+    void CellsFromMaskGet(const CellMask& cells, CellSet& outCells, unsigned short value) const;
 };
 
 template<class T>
@@ -121,32 +128,21 @@ void RegionsManager::FindConnectedCells(const T& definingCells, CellSet& outConn
 {
     auto it = definingCells.begin();
     const auto end = definingCells.end();
-
-    if (it != end)
+    if (it == end)
     {
-        const auto& cells = mCellToConnectedCellsMap[(*it)->IdGet()];
-        outConnectedCells.insert(cells.begin(), cells.end());
-        ++it;
+        return;
     }
 
-    while (it != end)
+    CellMask cells = mCellToConnectedCellsMap[(*it)->IdGet()];
+    for (const auto& c : outConnectedCells)
     {
-        const auto& cells = mCellToConnectedCellsMap[(*it)->IdGet()];
-
-        auto inIt = outConnectedCells.begin();
-        while (inIt != outConnectedCells.end())
-        {
-            if (cells.count(*inIt) == 0)
-            {
-                inIt = outConnectedCells.erase(inIt);
-            }
-            else
-            {
-                ++inIt;
-            }
-        }
-        ++it;
+        cells.Set(c->IdGet());
     }
+    for (++it; it != end; ++it)
+    {
+        cells &= mCellToConnectedCellsMap[(*it)->IdGet()];
+    }
+    CellsFromMaskGet(cells, outConnectedCells, 0);
 }
 
 template<class T>
@@ -154,45 +150,21 @@ void RegionsManager::FindConnectedCellsWithValue(const T& definingCells, CellSet
 {
     auto it = definingCells.begin();
     const auto end = definingCells.end();
-
-    if (it != end)
+    if (it == end)
     {
-        const auto& cells = mCellToConnectedCellsMap[(*it)->IdGet()];
-        outConnectedCells.insert(cells.begin(), cells.end());
-        ++it;
-
-        auto inIt = outConnectedCells.begin();
-        while (inIt != outConnectedCells.end())
-        {
-            if ((*inIt)->HasGuess(value))
-            {
-                ++inIt;
-            }
-            else
-            {
-                inIt = outConnectedCells.erase(inIt);
-            }
-        }
+        return;
     }
 
-    while (it != end)
+    CellMask cells = mCellToConnectedCellsMap[(*it)->IdGet()];
+    for (const auto& c : outConnectedCells)
+    {
+        cells.Set(c->IdGet());
+    }
+    for (++it; it != end; ++it)
     {
-        const auto& cells = mCellToConnectedCellsMap[(*it)->IdGet()];
-
-        auto inIt = outConnectedCells.begin();
-        while (inIt != outConnectedCells.end())
-        {
-            if (cells.count(*inIt) == 0)
-            {
-                inIt = outConnectedCells.erase(inIt);
-            }
-            else
-            {
-                ++inIt;
-            }
-        }
-        ++it;
+        cells &= mCellToConnectedCellsMap[(*it)->IdGet()];
     }
+    CellsFromMaskGet(cells, outConnectedCells, value);
 }
 #endif // REGIONS_MANAGER_H
 
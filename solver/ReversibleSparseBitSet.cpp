@@ -0,0 +1,154 @@
+#include "ReversibleSparseBitSet.h"
+
+ReversibleSparseBitSet::ReversibleSparseBitSet() :
+    mWords(),
+    mIndex(),
+    mLimit(0),
+    mTrail(),
+    mSavedGeneration(),
+    mGeneration(0),
+    mSnapshotLimit(0),
+    mHasSnapshot(false)
+{
+}
+
+size_t ReversibleSparseBitSet::WordsCountGet() const
+{
+    return mWords.size();
+}
+
+bool ReversibleSparseBitSet::IsEmpty() const
+{
+    return mLimit == 0;
+}
+
+bool ReversibleSparseBitSet::Intersects(const BitMask& mask, size_t& residue) const
+{
+    if (mLimit == 0)
+    {
+        return false;
+    }
+    if (mWords[residue] & mask[residue])
+    {
+        return true;
+    }
+    for (size_t i = 0; i < mLimit; ++i)
+    {
+        const size_t w = mIndex[i];
+        if (mWords[w] & mask[w])
+        {
+            residue = w;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ReversibleSparseBitSet::IsSubsetOf(const BitMask& mask) const
+{
+    for (size_t i = 0; i < mLimit; ++i)
+    {
+        const size_t w = mIndex[i];
+        if (mWords[w] & ~mask[w])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void ReversibleSparseBitSet::Init(size_t bitsCount)
+{
+    const size_t wordsCount = (bitsCount + 63) / 64;
+    mWords.assign(wordsCount, ~std::uint64_t(0));
+    if (bitsCount % 64)
+    {
+        mWords.back() = (std::uint64_t(1) << (bitsCount % 64)) - 1;
+    }
+    mIndex.resize(wordsCount);
+    for (size_t i = 0; i < wordsCount; ++i)
+    {
+        mIndex[i] = i;
+    }
+    mLimit = wordsCount;
+
+    mTrail.clear();
+    mSavedGeneration.assign(wordsCount, 0);
+    mGeneration = 0;
+    mHasSnapshot = false;
+}
+
+bool ReversibleSparseBitSet::Remove(const BitMask& mask)
+{
+    bool changed = false;
+    // iterate backwards, so that the words dropped from the front are not visited twice
+    for (size_t i = mLimit; i-- > 0;)
+    {
+        const size_t w = mIndex[i];
+        const std::uint64_t word = mWords[w] & ~mask[w];
+        if (word != mWords[w])
+        {
+            WordSet(i, word);
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+bool ReversibleSparseBitSet::IntersectWith(const BitMask& mask)
+{
+    bool changed = false;
+    for (size_t i = mLimit; i-- > 0;)
+    {
+        const size_t w = mIndex[i];
+        const std::uint64_t word = mWords[w] & mask[w];
+        if (word != mWords[w])
+        {
+            WordSet(i, word);
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+void ReversibleSparseBitSet::TakeSnapshot()
+{
+    mTrail.clear();
+    // a new generation marks every word as not saved yet
+    ++mGeneration;
+    mSnapshotLimit = mLimit;
+    mHasSnapshot = true;
+}
+
+void ReversibleSparseBitSet::RestoreSnapshot()
+{
+    if (mHasSnapshot)
+    {
+        for (const auto& saved : mTrail)
+        {
+            mWords[saved.first] = saved.second;
+        }
+        // the words dropped since the snapshot are the ones right after the old limit
+        mLimit = mSnapshotLimit;
+        mTrail.clear();
+        mHasSnapshot = false;
+    }
+}
+
+void ReversibleSparseBitSet::WordSet(size_t i, std::uint64_t word)
+{
+    const size_t w = mIndex[i];
+    if (mHasSnapshot && mSavedGeneration[w] != mGeneration)
+    {
+        mSavedGeneration[w] = mGeneration;
+        mTrail.emplace_back(w, mWords[w]);
+    }
+    mWords[w] = word;
+
+    if (word == 0)
+    {
+        --mLimit;
+        mIndex[i] = mIndex[mLimit];
+        mIndex[mLimit] = w;
+    }
+}
@@ -0,0 +1,78 @@
+#ifndef REVERSIBLE_SPARSE_BITSET_H
+#define REVERSIBLE_SPARSE_BITSET_H
+
+// Includes
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+typedef std::vector<std::uint64_t> BitMask;
+
+/// <summary>
+/// Bit set that keeps the indices of its non-zero words packed at the front of an array,
+/// so that the operations only visit the words that can still contain set bits.
+/// After a snapshot the words are saved the first time they change,
+/// so restoring it only writes back the words that have been modified.
+/// </summary>
+class ReversibleSparseBitSet
+{
+    std::vector<std::uint64_t> mWords;
+    std::vector<size_t> mIndex;             // indices of the words, the non-zero ones first
+    size_t mLimit;                          // number of non-zero words
+
+    std::vector<std::pair<size_t, std::uint64_t>> mTrail;  // words changed since the snapshot and their old value
+    std::vector<unsigned int> mSavedGeneration;            // generation in which each word was last saved
+    unsigned int mGeneration;
+    size_t mSnapshotLimit;
+    bool mHasSnapshot;
+
+public:
+// Constructors
+
+    ReversibleSparseBitSet();
+
+// Const methods
+
+    /// <summary>
+    /// Number of words needed by a mask over the bits of this set
+    /// </summary>
+    size_t WordsCountGet() const;
+    bool IsEmpty() const;
+    /// <summary>
+    /// Whether the set has a bit in common with the mask.
+    /// residue is the index of the word where the last intersection was found,
+    /// it is checked first and updated.
+    /// </summary>
+    bool Intersects(const BitMask& mask, size_t& residue) const;
+    /// <summary>
+    /// Whether all the bits in the set are also in the mask
+    /// </summary>
+    bool IsSubsetOf(const BitMask& mask) const;
+
+// Non-const methods
+
+    /// <summary>
+    /// Set the first bitsCount bits, clear any snapshot
+    /// </summary>
+    void Init(size_t bitsCount);
+    /// <summary>
+    /// Remove the bits that are set in the mask. Returns true if the set has changed
+    /// </summary>
+    bool Remove(const BitMask& mask);
+    /// <summary>
+    /// Remove the bits that are not set in the mask. Returns true if the set has changed
+    /// </summary>
+    bool IntersectWith(const BitMask& mask);
+
+    void TakeSnapshot();
+    void RestoreSnapshot();
+
+private:
+    /// <summary>
+    /// Replace the word at position i of mIndex, dropping it from the non-zero words if needed
+    /// </summary>
+    void WordSet(size_t i, std::uint64_t word);
+};
+
+#endif // REVERSIBLE_SPARSE_BITSET_H
@@ -5,7 +5,7 @@
 #include "RegionsManager.h"
 #include "GhostCagesManager.h"
 
-void ScanNaked(const CellSet& nakedSubset, const std::set<unsigned short> & cellValues, const SudokuGrid* grid, bool isHidden)
+void ScanNaked(const IdSpan& nakedSubset, const std::set<unsigned short> & cellValues, const SudokuGrid* grid, bool isHidden)
 {
     // Get all the regions the naked subset is in
     RegionSet regions;
@@ -20,7 +20,7 @@ void ScanNaked(const CellSet& nakedSubset, const std::set<unsigned short> & cell
 
 }
 
-void ScanLocked(const CellSet& intersection, const Region* region, unsigned short lockedValue)
+void ScanLocked(const IdSpan& intersection, const Region* region, unsigned short lockedValue)
 {
     region->UpdateManagerGet()->OnLockedCandidatesFound(intersection, lockedValue);
 }
@@ -3,15 +3,18 @@
 
 // includes
 #include "Types.h"
+#include "IdSpan.h"
 
 /// <summary>
 /// Given a naked subset, remove its values from the options of all cell that "see" it.
+/// The subset is given by cell id
 /// </summary>
-void ScanNaked(const CellSet& nakedSubset, const std::set<unsigned short>& cellValues, const SudokuGrid* grid, bool isHidden);
+void ScanNaked(const IdSpan& nakedSubset, const std::set<unsigned short>& cellValues, const SudokuGrid* grid, bool isHidden);
 
 /// <summary>
 /// Given a subset of locked candidates in a region, remove its values from the other cells not in the subset.
+/// The subset is given by cell id
 /// </summary>
-void ScanLocked(const CellSet& intersection, const Region* intersectingRegions, unsigned short lockedValue);
+void ScanLocked(const IdSpan& intersection, const Region* intersectingRegions, unsigned short lockedValue);
 
 #endif // SCANNING_H
\ No newline at end of file
@@ -0,0 +1,125 @@
+#include "SolverKernels.h"
+#include <array>
+#include <cassert>
+
+namespace
+{
+    /// <summary>
+    /// Kernels for grids of size N, or for any size if N is 0.
+    /// A region holds at most one cell per digit, so the entries of a region
+    /// and the bits of their masks never exceed the capacity
+    /// </summary>
+    template<unsigned short N>
+    class SizedSolverKernels : public SolverKernels
+    {
+        static_assert(N <= kMaxMaskDigits, "Grid size does not fit in a candidate mask");
+        static constexpr unsigned int kCapacity = N ? N : kMaxMaskDigits;
+
+    public:
+        unsigned short SizeGet() const override
+        {
+            return N;
+        }
+
+        bool SubsetFind(const std::uint64_t* masks, unsigned int endIndex, std::uint64_t excluded,
+                        std::uint64_t startMask, unsigned int targetSize,
+                        std::uint64_t& outMembers, std::uint64_t& outUnion, bool& outImpossible) const override
+        {
+            assert(endIndex <= kCapacity && targetSize <= kCapacity);
+
+            // depth first search: at depth d the subset holds the first entry and the entries at chosen[0..d),
+            // unions[d] is the union of their masks and next[d] the next position to try at that depth
+            std::array<unsigned int, kCapacity> chosen;
+            std::array<unsigned int, kCapacity> next;
+            std::array<std::uint64_t, kCapacity + 1> unions;
+
+            unsigned int depth = 0;
+            unions[0] = startMask;
+            bool entered = true;
+            for (;;)
+            {
+                if (entered)
+                {
+                    const unsigned int entries = depth + 1;
+                    const unsigned int count = CandidatesCountGet(unions[depth]);
+                    if (entries == targetSize && count == targetSize) // subset found
+                    {
+                        std::uint64_t members = 0;
+                        for (unsigned int i = 0; i < depth; ++i)
+                        {
+                            members |= std::uint64_t(1) << chosen[i];
+                        }
+                        outMembers = members;
+                        outUnion = unions[depth];
+                        return true;
+                    }
+                    else if (entries == targetSize || count > targetSize) // no subset with these entries
+                    {
+                        if (depth == 0)
+                        {
+                            return false;
+                        }
+                        --depth;
+                        entered = false;
+                        continue;
+                    }
+                    else if (entries > count) // N entries sharing fewer than N bits
+                    {
+                        outImpossible = true;
+                        return false;
+                    }
+                    next[depth] = depth ? chosen[depth - 1] + 1 : 0;
+                }
+
+                // the remaining positions must be enough to reach the target size
+                const unsigned int missing = targetSize - (depth + 1);
+                unsigned int i = next[depth];
+                while (i + missing <= endIndex && ((excluded >> i) & 1))
+                {
+                    ++i;
+                }
+                if (i + missing <= endIndex)
+                {
+                    chosen[depth] = i;
+                    next[depth] = i + 1;
+                    unions[depth + 1] = unions[depth] | masks[i];
+                    ++depth;
+                    entered = true;
+                }
+                else if (depth == 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    --depth;
+                    entered = false;
+                }
+            }
+        }
+    };
+}
+
+const SolverKernels& SolverKernelsGet(unsigned short size)
+{
+    static const SizedSolverKernels<4> s_kernels4;
+    static const SizedSolverKernels<6> s_kernels6;
+    static const SizedSolverKernels<8> s_kernels8;
+    static const SizedSolverKernels<9> s_kernels9;
+    static const SizedSolverKernels<12> s_kernels12;
+    static const SizedSolverKernels<16> s_kernels16;
+    static const SizedSolverKernels<25> s_kernels25;
+    static const SizedSolverKernels<0> s_genericKernels;
+
+    switch (size)
+    {
+    case 4: return s_kernels4;
+    case 6: return s_kernels6;
+    case 8: return s_kernels8;
+    case 9: return s_kernels9;
+    case 12: return s_kernels12;
+    case 16: return s_kernels16;
+    case 25: return s_kernels25;
+    default: return s_genericKernels;
+    }
+}
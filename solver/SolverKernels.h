@@ -0,0 +1,48 @@
+#ifndef SOLVER_KERNELS_H
+#define SOLVER_KERNELS_H
+
+// Includes
+#include "CandidateMask.h"
+#include <cstdint>
+
+/// <summary>
+/// Inner loops of the solver whose bounds only depend on the grid size.
+/// An instance is compiled for each common size, so that those bounds and the scratch
+/// storage of the loops are compile-time constants; other sizes share a generic instance.
+/// A root grid is given its instance when it is created (see SolverKernelsGet)
+/// and its bifurcation grids share it.
+/// </summary>
+class SolverKernels
+{
+public:
+    virtual ~SolverKernels() = default;
+
+    /// <summary>
+    /// Grid size this instance is compiled for, 0 for the generic instance
+    /// </summary>
+    virtual unsigned short SizeGet() const = 0;
+
+    /// <summary>
+    /// Subset search shared by naked and hidden subsets. The entries are the cells of a region
+    /// with the masks of their candidates, or the values of a region with the masks of the
+    /// positions of the cells that can host them.
+    /// Starting from an entry whose mask is startMask, look among the first endIndex masks,
+    /// in order and skipping the excluded positions, for more entries until there are targetSize
+    /// of them and the union of their masks has exactly targetSize bits.
+    /// On success outMembers has the positions of the entries added to the first one
+    /// and outUnion the union of all their masks.
+    /// outImpossible is set, and the search stopped, if some entries have fewer bits in their union
+    /// than there are entries: the puzzle has no solution
+    /// </summary>
+    virtual bool SubsetFind(const std::uint64_t* masks, unsigned int endIndex, std::uint64_t excluded,
+                            std::uint64_t startMask, unsigned int targetSize,
+                            std::uint64_t& outMembers, std::uint64_t& outUnion, bool& outImpossible) const = 0;
+};
+
+/// <summary>
+/// Kernels for a grid size: the instance compiled for 4, 6, 8, 9, 12, 16 or 25,
+/// or the generic one for any other size
+/// </summary>
+const SolverKernels& SolverKernelsGet(unsigned short size);
+
+#endif // SOLVER_KERNELS_H
@@ -0,0 +1,24 @@
+#ifndef SOLVER_OBSERVER_H
+#define SOLVER_OBSERVER_H
+
+// Includes
+#include <string>
+
+// Classes
+class SudokuCell;
+
+/// <summary>
+/// Receives the output of the logical solver running on a root grid.
+/// Grids without an observer solve silently.
+/// </summary>
+class SolverObserver
+{
+public:
+    virtual ~SolverObserver() = default;
+
+    virtual void NotifyCellChanged(SudokuCell* cell, bool isSolved) = 0;
+    virtual void NotifyImpossiblePuzzle(std::string message) = 0;
+    virtual void NotifyLogicalDeduction(std::string message) = 0;
+};
+
+#endif // SOLVER_OBSERVER_H
@@ -16,6 +16,10 @@ SolvingTechnique::SolvingTechnique(SudokuGrid* grid, TechniqueType type, Observe
 {
 }
 
+SolvingTechnique::~SolvingTechnique()
+{
+}
+
 TechniqueType SolvingTechnique::TypeGet() const
 {
     return mType;
@@ -68,12 +72,12 @@ void LockedCandidatesTechnique::NextStep()
 
     if(it != regions.end())
     {
-        std::set<unsigned short> hotValues;
+        CandidateMask hotValues = 0;
         if (mCurrentRegion->UpdateManagerGet()->IsRegionReadyForTechnique(mType, hotValues))
         {
-            for (const auto v : hotValues)
+            for (; hotValues; hotValues &= hotValues - 1)
             {
-                SearchLockedCandidates(v);
+                SearchLockedCandidates(static_cast<unsigned short>(LowestBitIndexGet(hotValues) + 1));
             }
         }
         ++it;
@@ -132,7 +136,7 @@ void NakedSubsetTechnique::NextStep()
         it = regions.find(mCurrentRegion);
     }
 
-    CellSet hotCells;
+    CellMask hotCells;
     if (mCurrentRegion->UpdateManagerGet()->IsRegionReadyForTechnique(mType, hotCells))
     {
         SearchNakedSubsets(hotCells);
@@ -185,7 +189,7 @@ void HiddenSubsetTechnique::NextStep()
         it = regions.find(mCurrentRegion);
     }
 
-    std::set<unsigned short> hotValues;
+    CandidateMask hotValues = 0;
     if (mCurrentRegion->UpdateManagerGet()->IsRegionReadyForTechnique(mType, hotValues))
     {
         SearchHiddenSubsets(hotValues);
@@ -468,7 +472,7 @@ void BifurcationTechnique::Init()
 
     std::stable_sort(mCells.begin(), mCells.end(), [](SudokuCell* const &a, SudokuCell* const &b)
     {
-        return a->OptionsGet().size() < b->OptionsGet().size();
+        return a->OptionsCountGet() < b->OptionsCountGet();
     });
 }
 
@@ -531,11 +535,11 @@ void InniesAndOuties::NextStep()
     {
         for(KillerCage_t k : mInnieCages)
         {
-            mGrid->ProgressManagerGet()->RegisterProgress(std::make_shared<Progress_GhostCage>(std::move(k.second), k.first, true, mGrid));
+            mGrid->ProgressManagerGet()->RegisterProgress<Progress_GhostCage>(k.second, k.first, true);
         }
         for(KillerCage_t k : mOutieCages)
         {
-            mGrid->ProgressManagerGet()->RegisterProgress(std::make_shared<Progress_GhostCage>(std::move(k.second), k.first, false, mGrid));
+            mGrid->ProgressManagerGet()->RegisterProgress<Progress_GhostCage>(k.second, k.first, false);
         }
         mFinished = true;
     }
@@ -3,6 +3,8 @@
 
 #include "Types.h"
 #include "RandomGuessTreeNode.h"
+#include "CandidateMask.h"
+#include "CellMask.h"
 
 class SolvingTechnique
 {
@@ -23,6 +25,7 @@ protected:
 public:
     // Special functions
     SolvingTechnique(SudokuGrid* grid, TechniqueType type, ObservedComponent observedComponent);
+    virtual ~SolvingTechnique();
 
     TechniqueType TypeGet() const;
     bool HasFinished() const;
@@ -69,8 +72,7 @@ private:
     /// A naked subset is a set of N cells whose candidates are picked from a set of exactly N values.
     /// Returns true if any progress was maden (either the technique was successful or the puzzle was found to be impossible)
     /// </summary>
-    void SearchNakedSubsets(const CellSet& cellsToSearch);
-    bool SearchNakedSubsetInner(const CellList& cells, CellList::iterator it, const CellList::iterator endIt, const CellSet& excludeCells, std::set<unsigned short>& candidates, CellList& outNakedSubset, const size_t targetSize, bool& impossible);
+    void SearchNakedSubsets(const CellMask& cellsToSearch);
 };
 
 class HiddenSubsetTechnique : public SolvingTechnique
@@ -89,13 +91,12 @@ private:
     /// A hidden naked subset is a set of N candidates whose viable hosting cells are picked from a set of exactly N cells.
     /// Returns true if any progress was maden (either the technique was successful or the puzzle was found to be impossible)
     /// </summary>
-    void SearchHiddenSubsets(const std::set<unsigned short>& valuesToSearch);
-    bool SearchHiddenSubsetInner(const std::list<ValueMapEntry>& values, std::list<ValueMapEntry>::iterator it, const std::list<ValueMapEntry>::iterator endIt, const std::set<unsigned short>& excludeValues, std::list<unsigned short>& candidates, CellSet& outNakedSubset, const size_t subsetFinalSize, bool& impossible);
+    void SearchHiddenSubsets(CandidateMask valuesToSearch);
 };
 
 typedef std::list<Region*>::iterator RegListIt;
 typedef std::list<RegListIt> DefininfSet;
-typedef std::map<SudokuCell*, RegionSet> IntersectionMap;
+typedef std::map<SudokuCell*, RegionSet, CellIdLess> IntersectionMap;
 class FishTechnique : public SolvingTechnique
 {
     unsigned short mCurrentValue;
@@ -164,7 +165,22 @@ private:
 };
 
 class KillerConstraint;
-typedef std::set<const KillerConstraint*>::iterator KillerSetIt;
+/// <summary>
+/// Orders killer constraints by the id of the region they are attached to
+/// </summary>
+struct KillerConstraintLess
+{
+    bool operator()(const KillerConstraint* a, const KillerConstraint* b) const;
+};
+/// <summary>
+/// Orders killer cages by total, then by cells
+/// </summary>
+struct KillerCageLess
+{
+    bool operator()(const std::pair<unsigned int, CellSet>& a, const std::pair<unsigned int, CellSet>& b) const;
+};
+typedef std::set<const KillerConstraint*, KillerConstraintLess> KillerSet;
+typedef KillerSet::iterator KillerSetIt;
 typedef std::list<KillerSetIt> KillerCombination;
 typedef std::pair<unsigned int, CellSet> KillerCage_t;
 
@@ -173,14 +189,14 @@ class InniesAndOuties : public SolvingTechnique
     RegionSet mRegions;
     RegionSet::iterator mCurrentRegion;
     unsigned int mCurrentRegionTotal;
-    std::map<Region*, std::set<const KillerConstraint*>> mContainedKillers;
-    std::map<Region*, std::set<const KillerConstraint*>> mIntersectingKillers;
+    std::map<Region*, KillerSet, RegionIdLess> mContainedKillers;
+    std::map<Region*, KillerSet, RegionIdLess> mIntersectingKillers;
 
     std::list<KillerCombination> mKillerCombinations;
     std::list<KillerCage_t> mKillerUnions;
 
-    std::set<KillerCage_t> mInnieCages;
-    std::set<KillerCage_t> mOutieCages;
+    std::set<KillerCage_t, KillerCageLess> mInnieCages;
+    std::set<KillerCage_t, KillerCageLess> mOutieCages;
 public:
     InniesAndOuties(SudokuGrid *grid, ObservedComponent observedComponent);
 
@@ -195,7 +211,7 @@ private:
     void SearchInniesInner(KillerCage_t& unionCage);
     void SearchOuties();
     void SearchOutiesInner(KillerCage_t& unionCage);
-    void CalculateCageCombinations(unsigned int size, const std::set<const KillerConstraint*>& availableKillers);
+    void CalculateCageCombinations(unsigned int size, const KillerSet& availableKillers);
     void CalculateCageCombinationsInner(std::list<KillerCombination>& outCombinations, KillerSetIt kIt, const KillerSetIt& end, KillerCombination& nextComb, unsigned int size);
 };
 
@@ -10,7 +10,7 @@ SudokuCell::SudokuCell(SudokuGrid* grid, unsigned short row, unsigned short col,
     mRow(row),
     mCol(col),
     mId(col + sudokuSize * row),
-    mViableOptions(),
+    mOptionsMask(AllCandidatesGet(sudokuSize)),     // already in the hash seeded by the grid
     mEliminationHints(),
     mIsGiven( false ),
     mParentGrid(grid),
@@ -45,9 +45,19 @@ SudokuGrid* SudokuCell::GridGet() const
     return mParentGrid;
 }
 
-const std::set<unsigned short>& SudokuCell::OptionsGet() const
+std::set<unsigned short> SudokuCell::OptionsGet() const
 {
-    return mViableOptions;
+    return CandidatesSetGet(mOptionsMask);
+}
+
+CandidateMask SudokuCell::OptionsMaskGet() const
+{
+    return mOptionsMask;
+}
+
+unsigned int SudokuCell::OptionsCountGet() const
+{
+    return CandidatesCountGet(mOptionsMask);
 }
 
 const std::set<unsigned short>& SudokuCell::HintedEliminationsGet() const
@@ -67,7 +77,7 @@ std::string SudokuCell::CellNameGet() const
 
 bool SudokuCell::HasGuess(unsigned short value) const
 {
-    return mViableOptions.find(value) != mViableOptions.end();
+    return (mOptionsMask & CandidateBitGet(value)) != 0;
 }
 
 bool SudokuCell::IsSolved() const
@@ -86,36 +96,38 @@ void SudokuCell::MakeGiven(unsigned short value)
     {
         mIsGiven = true;
         mValue = value;
-        mParentGrid->ProgressManagerGet()->RegisterProgress(std::make_shared<Progress_GivenCellAdded>(this, value));
+        mParentGrid->ProgressManagerGet()->RegisterProgress<Progress_GivenCellAdded>(this, value);
     }
 }
 
 void SudokuCell::RemoveOption(unsigned short guess)
 {
-    if (mViableOptions.erase(guess))
+    if (mOptionsMask & CandidateBitGet(guess))
     {
-        if (mViableOptions.size() == 1)
+        mOptionsMask &= ~CandidateBitGet(guess);
+        mParentGrid->ToggleCandidateHash(mId, guess);
+        if (mOptionsMask && !(mOptionsMask & (mOptionsMask - 1)))
         {
             Progress_OptionRemoved notification(this, guess);
             notification.ProcessProgress();
             if(!mIsGiven)
             {
-                mParentGrid->ProgressManagerGet()->RegisterProgress(std::make_shared<Progress_SingleOptionLeftInCell>(this, *mViableOptions.begin()));
+                mParentGrid->ProgressManagerGet()->RegisterProgress<Progress_SingleOptionLeftInCell>(this, static_cast<unsigned short>(LowestBitIndexGet(mOptionsMask) + 1));
             }
         }
-        else if (mViableOptions.size() == 0)
+        else if (mOptionsMask == 0)
         {
             if (mIsGiven)
             {
-                mParentGrid->ProgressManagerGet()->RegisterProgress(std::make_shared<Impossible_ClashWithGivenCell>(this, mParentGrid));
+                mParentGrid->ProgressManagerGet()->RegisterProgress<Impossible_ClashWithGivenCell>(this, mParentGrid);
             }
             else if (IsSolved())
             {
-                mParentGrid->ProgressManagerGet()->RegisterProgress(std::make_shared<Impossible_ClashWithSolvedCell>(this, mParentGrid));
+                mParentGrid->ProgressManagerGet()->RegisterProgress<Impossible_ClashWithSolvedCell>(this, mParentGrid);
             }
             else
             {
-                mParentGrid->ProgressManagerGet()->RegisterProgress(std::make_shared<Impossible_NoOptionsLeftInCell>(this, mParentGrid));
+                mParentGrid->ProgressManagerGet()->RegisterProgress<Impossible_NoOptionsLeftInCell>(this, mParentGrid);
             }
         }
         else
@@ -132,10 +144,10 @@ void SudokuCell::RemoveOption(unsigned short guess)
 
 void SudokuCell::RemoveOptionHint(unsigned short option)
 {
-    size_t viableOptCount = mViableOptions.size();
+    const bool isViable = HasGuess(option);
     RemoveOption(option);
 
-    if (mViableOptions.size() < viableOptCount)
+    if (isViable)
     {
         mEliminationHints.insert(option);
     }
@@ -143,20 +155,13 @@ void SudokuCell::RemoveOptionHint(unsigned short option)
 
 void SudokuCell::RemoveAllOtherOptions(unsigned short option)
 {
-    std::set<unsigned int> optionsToDelete;
-
-    auto it = mViableOptions.begin();
-    while (it != mViableOptions.end())
+    CandidateMask toDelete = mOptionsMask & ~CandidateBitGet(option);
+    for (unsigned short v = 1; toDelete; ++v, toDelete >>= 1)
     {
-        if (*it != option)
+        if (toDelete & 1)
         {
-            optionsToDelete.emplace(*it);
+            RemoveOption(v);
         }
-        ++it;
-    }
-    for (const auto& option : optionsToDelete)
-    {
-        RemoveOption(option);
     }
 }
 
@@ -165,12 +170,13 @@ void SudokuCell::Reset()
     mValue = 0;
     mIsGiven = false;
     mEliminationHints.clear();
-    mViableOptions.clear();
     mSnapshot.reset();
-    for (unsigned short i = 1; i <= mParentGrid->SizeGet(); ++i)
+    const CandidateMask allOptions = AllCandidatesGet(mParentGrid->SizeGet());
+    for (CandidateMask toAdd = allOptions & ~mOptionsMask; toAdd; toAdd &= toAdd - 1)
     {
-        mViableOptions.emplace_hint(mViableOptions.end(), i);
+        mParentGrid->ToggleCandidateHash(mId, static_cast<unsigned short>(LowestBitIndexGet(toAdd) + 1));
     }
+    mOptionsMask = allOptions;
     if(!mParentGrid->ParentNodeGet())
     {
         mParentGrid->NotifyCellChanged(this);
@@ -183,7 +189,7 @@ SudokuCell *SudokuCell::DeepCopy(SudokuGrid* parentGrid) const
 
     SudokuCell* cell = new SudokuCell(parentGrid, mRow, mCol, parentGrid->SizeGet());
     cell->mValue = this->mValue;
-    cell->mViableOptions = this->mViableOptions;
+    cell->mOptionsMask = this->mOptionsMask;
     cell->mEliminationHints = this->mEliminationHints;
     cell->mIsGiven = this->mIsGiven;
 
@@ -192,14 +198,14 @@ SudokuCell *SudokuCell::DeepCopy(SudokuGrid* parentGrid) const
 
 void SudokuCell::TakeSnapshot()
 {
-    mSnapshot = std::make_unique<Snapshot>(mViableOptions, mValue);
+    mSnapshot = std::make_unique<Snapshot>(mOptionsMask, mValue);
 }
 
 void SudokuCell::RestoreSnapshot()
 {
     if(mSnapshot)
     {
-        mViableOptions = std::move(mSnapshot->mViableOptions);
+        mOptionsMask = mSnapshot->mOptionsMask;
         mValue = std::move(mSnapshot->mValue);
         mSnapshot.reset();
     }
@@ -207,7 +213,7 @@ void SudokuCell::RestoreSnapshot()
 
 void SudokuCell::ValueSet(unsigned short value)
 {
-    if( value != mValue && mViableOptions.count(value) > 0 )
+    if( value != mValue && HasGuess(value) )
     {
         mValue = value;
         if(!mParentGrid->ParentNodeGet())
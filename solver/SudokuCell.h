@@ -3,6 +3,7 @@
 
 // Includes
 #include "Types.h"
+#include "CandidateMask.h"
 #include <string>
 
 //classes
@@ -15,7 +16,7 @@ private:
     const unsigned short mRow;					// row the cell is in
     const unsigned short mCol;					// column the cell is in
     const unsigned int mId;						// unique id for the cell
-    std::set<unsigned short> mViableOptions;	// vector of digits are still viable
+    CandidateMask mOptionsMask;					// bit set of the digits that are still viable
     std::set<unsigned short> mEliminationHints;	// options that have been ruled out manually by the user
     bool mIsGiven;								// whether th ecell is a given clue
     SudokuGrid* mParentGrid;					// pointer to the grid the cell belongs to
@@ -24,13 +25,14 @@ private:
     friend class Progress_GivenCellAdded;
     friend class Progress_SingleOptionLeftInCell;
     friend class Progress_SingleCellForOption;
+    friend struct CellIdLess;
 
     struct Snapshot
     {
-        std::set<unsigned short> mViableOptions;
+        CandidateMask mOptionsMask;
         unsigned short mValue;
-        Snapshot(const std::set<unsigned short>& opt, const unsigned short& val):
-            mViableOptions(opt),
+        Snapshot(CandidateMask mask, const unsigned short& val):
+            mOptionsMask(mask),
             mValue(val)
         {}
     };
@@ -48,7 +50,12 @@ public:
     unsigned short RowGet() const;
     unsigned short ColGet() const;
     SudokuGrid* GridGet() const;
-    const std::set<unsigned short>& OptionsGet() const;
+    /// <summary>
+    /// Viable digits as a set, built from the options mask
+    /// </summary>
+    std::set<unsigned short> OptionsGet() const;
+    CandidateMask OptionsMaskGet() const;
+    unsigned int OptionsCountGet() const;
     const std::set<unsigned short>& HintedEliminationsGet() const;
     const RegionSet& GetRegionsWithCell() const;
     std::string CellNameGet() const;
@@ -129,20 +136,25 @@ void SudokuCell::RemoveAllOtherOptions(const T& options)
         return;
     }
 
-    std::set<unsigned int> optionsToDelete;
+    CandidateMask keep = 0;
+    for (const unsigned short& option : options)
+    {
+        keep |= CandidateBitGet(option);
+    }
 
-    auto it = mViableOptions.begin();
-    while (it != mViableOptions.end())
+    CandidateMask toDelete = mOptionsMask & ~keep;
+    for (unsigned short option = 1; toDelete; ++option, toDelete >>= 1)
     {
-        if (options.find(*it) == options.end())
+        if (toDelete & 1)
         {
-            optionsToDelete.emplace(*it);
+            RemoveOption(option);
         }
-        ++it;
-    }
-    for (const auto& option : optionsToDelete)
-    {
-        RemoveOption(option);
     }
 }
+
+inline bool CellIdLess::operator()(const SudokuCell* a, const SudokuCell* b) const
+{
+    return a->mId < b->mId;
+}
+
 #endif // SUDOKU_CELL_H
@@ -1,23 +1,35 @@
 #include "SudokuGrid.h"
 #include "Region.h"
+#include "RegionArena.h"
 #include "RegionsManager.h"
 #include "GridProgressManager.h"
 #include "SudokuCell.h"
 #include "GhostCagesManager.h"
 #include "RegionUpdatesManager.h"
-#include "../sudokusolverthread.h"
+#include "SolverObserver.h"
+#include "Trace.h"
+#include "TranspositionTable.h"
+#include "SolverKernels.h"
 #include <cassert>
 
-SudokuGrid::SudokuGrid(unsigned short size, SudokuSolverThread* solverThread) :
+SudokuGrid::SudokuGrid(unsigned short size, SolverObserver* observer, const SolverKernels& kernels) :
     mSize(size),
+    mKernels(&kernels),
     mParentNode(nullptr), // needs to be initialized before the progress manager
     mGrid(),
+    mRegionArena(std::make_unique<RegionArena>()),
     mRegionsManager(std::make_unique<RegionsManager>(this)),
     mGhostRegionsManager(std::make_unique<GhostCagesManager>(this)),
     mProgressManager(std::make_unique<GridProgressManager>(this)),
     mHasSnapshort(false),
-    mSolverThread(solverThread)
+    mCandidatesHash(0),
+    mSnapshotCandidatesHash(0),
+    mTranspositionTable(std::make_unique<TranspositionTable>()),
+    mObserver(observer)
 {
+    assert(mSize <= kMaxMaskDigits);
+    assert(mKernels->SizeGet() == 0 || mKernels->SizeGet() == mSize);
+
     // populate the grid
     mGrid.reserve(mSize);
     for (size_t i = 0; i < mSize; i++)
@@ -29,18 +41,32 @@ SudokuGrid::SudokuGrid(unsigned short size, SudokuSolverThread* solverThread) :
         }
     }
 
+    // every candidate is viable in a new grid
+    for (CellId cell = 0; cell < static_cast<CellId>(mSize) * mSize; ++cell)
+    {
+        for (unsigned short value = 1; value <= mSize; ++value)
+        {
+            ToggleCandidateHash(cell, value);
+        }
+    }
+
     DefineRowsAndCols();
 }
 
 SudokuGrid::SudokuGrid(const SudokuGrid *grid) :
     mSize(grid->SizeGet()),
+    mKernels(grid->mKernels),
     mParentNode(grid),
     mGrid(),
+    mRegionArena(std::make_unique<RegionArena>()),
     mRegionsManager(std::make_unique<RegionsManager>(this)),
     mGhostRegionsManager(std::make_unique<GhostCagesManager>(this)),
     mProgressManager(std::make_unique<GridProgressManager>(this)),
     mHasSnapshort(false),
-    mSolverThread(nullptr)
+    mCandidatesHash(0),
+    mSnapshotCandidatesHash(0),
+    mTranspositionTable(),
+    mObserver(nullptr)
 {
     // populate the grid with the cells
     mGrid.reserve(mSize);
@@ -52,6 +78,7 @@ SudokuGrid::SudokuGrid(const SudokuGrid *grid) :
             mGrid.at(i).at(j) = CellUPtr(grid->mGrid.at(i).at(j)->DeepCopy(this));
         }
     }
+    mCandidatesHash = grid->mCandidatesHash;
 
     // create regions from the leaf regions of the existing grid
     for(const auto& r : grid->mRegionsManager->RegionsGet())
@@ -101,6 +128,11 @@ unsigned short SudokuGrid::SizeGet() const
     return mSize;
 }
 
+const SolverKernels& SudokuGrid::KernelsGet() const
+{
+    return *mKernels;
+}
+
 SudokuCell* SudokuGrid::CellGet(unsigned short row, unsigned short col) const
 {
     return mGrid.at(row).at(col).get();
@@ -111,6 +143,11 @@ SudokuCell *SudokuGrid::CellGet(unsigned int id) const
     return CellGet(id / mSize, id % mSize);
 }
 
+RegionArena* SudokuGrid::RegionArenaGet() const
+{
+    return mRegionArena.get();
+}
+
 RegionsManager* SudokuGrid::RegionsManagerGet() const
 {
     return mRegionsManager.get();
@@ -146,9 +183,19 @@ const SudokuGrid *SudokuGrid::ParentNodeGet()
     return mParentNode;
 }
 
-SudokuSolverThread *SudokuGrid::SolverThreadGet() const
+SolverObserver *SudokuGrid::ObserverGet() const
+{
+    return mObserver;
+}
+
+std::uint64_t SudokuGrid::CandidatesHashGet() const
 {
-    return mSolverThread;
+    return mCandidatesHash;
+}
+
+TranspositionTable *SudokuGrid::TranspositionTableGet() const
+{
+    return mParentNode ? mParentNode->TranspositionTableGet() : mTranspositionTable.get();
 }
 
 void SudokuGrid::AddGivenCell(unsigned short row, unsigned short col, unsigned short value)
@@ -205,17 +252,22 @@ void SudokuGrid::DefineRegion(const std::vector<std::array<unsigned short, 2> >
     }
 
     mProgressManager->Reset();
-    RegionSPtr regionSPtr = std::make_shared<Region>(this, std::move(cellList), true);
+    if (mTranspositionTable)
+    {
+        // the cached results assume the previous set of constraints
+        mTranspositionTable->Clear();
+    }
+    Region* region = mRegionArena->Create(this, std::move(cellList), true);
     for (auto& constraint: constraints)
     {
-        regionSPtr->AddVariantConstraint(std::unique_ptr<VariantConstraint>(constraint));
+        region->AddVariantConstraint(std::unique_ptr<VariantConstraint>(constraint));
     }
-    regionSPtr->RegionNameSet(name);
+    region->RegionNameSet(name);
     if(wipeUpdateManager)
     {
-        regionSPtr->UpdateManagerGet()->Reset();
+        region->UpdateManagerGet()->Reset();
     }
-    mRegionsManager->RegisterRegion(regionSPtr, regionType);
+    mRegionsManager->RegisterRegion(region, regionType);
 }
 
 void SudokuGrid::ResetContents()
@@ -230,8 +282,13 @@ void SudokuGrid::ResetContents()
         }
     }
     mProgressManager->Clear();
-    mRegionsManager->Reset();
+    // the ghost cages must be dropped before the regions manager releases them
     mGhostRegionsManager->Clear();
+    mRegionsManager->Reset();
+    if (mTranspositionTable)
+    {
+        mTranspositionTable->Clear();
+    }
 }
 
 void SudokuGrid::Clear()
@@ -248,14 +305,19 @@ void SudokuGrid::Clear()
     mProgressManager->Clear();
     mRegionsManager->Clear();
     mGhostRegionsManager->Clear();
+    mRegionArena->Clear();
+    if (mTranspositionTable)
+    {
+        mTranspositionTable->Clear();
+    }
     DefineRowsAndCols();
 }
 
 void SudokuGrid::NotifyCellChanged(SudokuCell *cell) const
 {
-    if(mSolverThread)
+    if(mObserver)
     {
-        mSolverThread->NotifyCellChanged(cell, cell->IsSolved());
+        mObserver->NotifyCellChanged(cell, cell->IsSolved());
     }
 }
 
@@ -266,7 +328,10 @@ void SudokuGrid::NotifyCellChanged(unsigned int cellId) const
 
 void SudokuGrid::TakeSnapshot()
 {
+    SUDOKU_TRACE_SCOPE("SudokuGrid::TakeSnapshot");
     mHasSnapshort = true;
+    mSnapshotCandidatesHash = mCandidatesHash;
+    mRegionArena->TakeSnapshot();
     mRegionsManager->TakeSnapshot();
     mGhostRegionsManager->TakeSnapshot();
     for (size_t i = 0; i < mSize; i++)
@@ -280,6 +345,7 @@ void SudokuGrid::TakeSnapshot()
 
 void SudokuGrid::RestoreSnapshot()
 {
+    SUDOKU_TRACE_SCOPE("SudokuGrid::RestoreSnapshot");
     if(mHasSnapshort)
     {
         mHasSnapshort = false;
@@ -290,7 +356,17 @@ void SudokuGrid::RestoreSnapshot()
                 mGrid.at(i).at(j)->RestoreSnapshot();
             }
         }
+        mCandidatesHash = mSnapshotCandidatesHash;
         mRegionsManager->RestoreSnapshot();
         mGhostRegionsManager->RestoreSnapshot();
+        // the deductions still queued belong to the abandoned branch
+        // and may refer to regions that are about to be destroyed
+        mProgressManager->Clear();
+        mRegionArena->RestoreSnapshot();
     }
 }
+
+void SudokuGrid::ToggleCandidateHash(CellId cell, unsigned short value)
+{
+    mCandidatesHash ^= CandidateKeyGet(cell, value);
+}
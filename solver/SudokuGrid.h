@@ -4,27 +4,40 @@
 // Includes
 #include "Types.h"
 #include <array>
+#include <cstdint>
 #include <vector>
 #include <string>
 
 // Classes
 class RegionsManager;
+class RegionArena;
 class GridProgressManager;
 class VariantConstraint;
-class SudokuSolverThread;
+class SolverObserver;
 class GhostCagesManager;
+class TranspositionTable;
+class SolverKernels;
 
 class SudokuGrid
 {
     const unsigned short mSize;					// length of the grid
+    const SolverKernels* mKernels;				// inner loops compiled for this size, shared with the bifurcation grids
     const SudokuGrid* mParentNode;
     std::vector<std::vector<CellUPtr>> mGrid;	// array of cells representing the grid
+    std::unique_ptr<RegionArena> mRegionArena;  // owns the regions, must outlive the managers below
     RegionsManagerUPtr mRegionsManager;			// manages the subdivision of the grid into regions
     std::unique_ptr<GhostCagesManager> mGhostRegionsManager;    // manages ghost regions added by the solver to aid the solution
     GridProgressManagerUPtr mProgressManager;	// notifies cells when some progress has been made
     bool mHasSnapshort;
 
-    SudokuSolverThread* mSolverThread;
+    // Zobrist hash of the candidates: the XOR of the keys of the cell-value pairs that are still viable.
+    // Seeded with every key when the grid is built, then ToggleCandidateHash XORs a key out or back in
+    // whenever a cell loses or regains that candidate. Bifurcation grids copy the hash of their parent
+    std::uint64_t mCandidatesHash;
+    std::uint64_t mSnapshotCandidatesHash;
+    std::unique_ptr<TranspositionTable> mTranspositionTable;    // bifurcation results. Only owned by the root grid
+
+    SolverObserver* mObserver;                  // receives the solver output, null for headless and child grids
 
 // Private methods
     void DefineRowsAndCols();
@@ -32,21 +45,28 @@ class SudokuGrid
 public:
 // Constructors/Destructors
 
-    SudokuGrid(unsigned short size, SudokuSolverThread* solverThread);
+    SudokuGrid(unsigned short size, SolverObserver* observer, const SolverKernels& kernels);
     SudokuGrid(const SudokuGrid* grid);
     ~SudokuGrid();
 
 // Public getters
 
     unsigned short SizeGet() const;
+    const SolverKernels& KernelsGet() const;
     SudokuCell* CellGet(unsigned short row, unsigned short col) const;
     SudokuCell* CellGet(unsigned int id) const;
+    RegionArena* RegionArenaGet() const;
     RegionsManager* RegionsManagerGet() const;
     GhostCagesManager* GhostRegionsManagerGet() const;
     GridProgressManager* ProgressManagerGet() const;
     bool IsSolved() const;
     const SudokuGrid* ParentNodeGet();
-    SudokuSolverThread* SolverThreadGet() const;
+    SolverObserver* ObserverGet() const;
+    std::uint64_t CandidatesHashGet() const;
+    /// <summary>
+    /// Cache of the bifurcation results shared by the root grid and all its bifurcation grids
+    /// </summary>
+    TranspositionTable* TranspositionTableGet() const;
 
 // Non-constant methods
 
@@ -94,5 +114,11 @@ public:
     void TakeSnapshot();
     void RestoreSnapshot();
 
+    /// <summary>
+    /// Add or remove a candidate of a cell from the candidates hash.
+    /// Must be called by the cell every time one of its options changes.
+    /// </summary>
+    void ToggleCandidateHash(CellId cell, unsigned short value);
+
 };
 #endif // SUDOKU_GRID_H
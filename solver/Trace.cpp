@@ -0,0 +1,197 @@
+#include "Trace.h"
+
+#ifdef SUDOKU_TRACE
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+    struct Event
+    {
+        const char* mName;
+        const char* mArgName;
+        long long mArg;
+        std::uint64_t mStart;           // nanoseconds since the first event
+        std::uint64_t mDuration;
+    };
+
+    // Written by its own thread only: an event is stored before the count is published,
+    // so the events below the count can be read by any thread.
+    // The events are kept in chunks allocated as they fill up, so idle threads cost next to nothing
+    struct ThreadBuffer
+    {
+        static constexpr size_t kChunkSize = 1 << 12;
+        static constexpr size_t kMaxChunks = 256;       // further events are counted as dropped
+        static constexpr size_t kCapacity = kChunkSize * kMaxChunks;
+
+        std::unique_ptr<Event[]> mChunks[kMaxChunks];
+        std::atomic<size_t> mCount;
+        std::atomic<size_t> mDropped;
+        unsigned int mThreadId;
+
+        explicit ThreadBuffer(unsigned int threadId):
+            mChunks(),
+            mCount(0),
+            mDropped(0),
+            mThreadId(threadId)
+        {
+        }
+
+        Event& EventGet(size_t index)
+        {
+            return mChunks[index / kChunkSize][index % kChunkSize];
+        }
+    };
+
+    // The buffers outlive their threads, so that the events of the workers are still there at exit
+    class Registry
+    {
+        std::mutex mMutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> mBuffers;
+        const std::chrono::steady_clock::time_point mEpoch;
+
+    public:
+        Registry():
+            mMutex(),
+            mBuffers(),
+            mEpoch(std::chrono::steady_clock::now())
+        {
+        }
+
+        ~Registry()
+        {
+            const char* path = std::getenv("SUDOKU_TRACE_FILE");
+            std::ofstream stream(path ? path : "sudoku_trace.json");
+            if (stream)
+            {
+                Write(stream);
+            }
+        }
+
+        std::uint64_t Now() const
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - mEpoch).count();
+        }
+
+        ThreadBuffer* NewBuffer()
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mBuffers.push_back(std::make_unique<ThreadBuffer>(static_cast<unsigned int>(mBuffers.size() + 1)));
+            return mBuffers.back().get();
+        }
+
+        void Write(std::ostream& stream)
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            char line[256];
+            bool first = true;
+            stream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+            for (const auto& buffer : mBuffers)
+            {
+                const size_t count = buffer->mCount.load(std::memory_order_acquire);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    const Event& e = buffer->EventGet(i);
+                    // timestamps are in microseconds
+                    int length = std::snprintf(line, sizeof(line), "%s\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f",
+                                               first ? "" : ",", e.mName, buffer->mThreadId, e.mStart / 1000.0, e.mDuration / 1000.0);
+                    Append(stream, line, length);
+                    if (e.mArgName)
+                    {
+                        length = std::snprintf(line, sizeof(line), ",\"args\":{\"%s\":%lld}", e.mArgName, e.mArg);
+                        Append(stream, line, length);
+                    }
+                    stream << "}";
+                    first = false;
+                }
+                const size_t dropped = buffer->mDropped.load(std::memory_order_relaxed);
+                if (dropped > 0)
+                {
+                    std::snprintf(line, sizeof(line), "%s\n{\"name\":\"dropped events\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%u,\"ts\":0,\"args\":{\"count\":%zu}}",
+                                  first ? "" : ",", buffer->mThreadId, dropped);
+                    stream << line;
+                    first = false;
+                }
+            }
+            stream << "\n]}\n";
+        }
+
+    private:
+        // snprintf returns the length the text would have had without truncation
+        template<size_t N>
+        static void Append(std::ostream& stream, const char (&line)[N], int length)
+        {
+            if (length > 0)
+            {
+                stream.write(line, std::min<int>(length, N - 1));
+            }
+        }
+    };
+
+    Registry& RegistryGet()
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    ThreadBuffer* ThreadBufferGet()
+    {
+        thread_local ThreadBuffer* buffer = RegistryGet().NewBuffer();
+        return buffer;
+    }
+}
+
+namespace Trace
+{
+    Scope::Scope(const char *name, const char *argName, long long arg):
+        mName(name),
+        mArgName(argName),
+        mArg(arg),
+        mStart(RegistryGet().Now())
+    {
+    }
+
+    Scope::~Scope()
+    {
+        const std::uint64_t end = RegistryGet().Now();
+        ThreadBuffer* buffer = ThreadBufferGet();
+        const size_t count = buffer->mCount.load(std::memory_order_relaxed);
+        if (count == ThreadBuffer::kCapacity)
+        {
+            buffer->mDropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        if (count % ThreadBuffer::kChunkSize == 0)
+        {
+            buffer->mChunks[count / ThreadBuffer::kChunkSize].reset(new Event[ThreadBuffer::kChunkSize]);
+        }
+        buffer->EventGet(count) = Event{mName, mArgName, mArg, mStart, end - mStart};
+        buffer->mCount.store(count + 1, std::memory_order_release);
+    }
+
+    void WriteChromeJson(std::ostream &stream)
+    {
+        RegistryGet().Write(stream);
+    }
+
+    bool WriteChromeJson(const std::string &path)
+    {
+        std::ofstream stream(path);
+        if (!stream)
+        {
+            return false;
+        }
+        WriteChromeJson(stream);
+        return static_cast<bool>(stream);
+    }
+}
+
+#endif // SUDOKU_TRACE
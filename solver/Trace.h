@@ -0,0 +1,61 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+/// <summary>
+/// Scoped trace events for profiling the solver, enabled by defining SUDOKU_TRACE
+/// (qmake CONFIG+=trace). Each thread records its events in its own buffer without locking,
+/// and all the events are written at exit as Chrome trace JSON, to be opened in
+/// chrome://tracing or Perfetto. The file is sudoku_trace.json in the working directory,
+/// unless the SUDOKU_TRACE_FILE environment variable names another one.
+/// Without SUDOKU_TRACE the macros expand to nothing.
+/// </summary>
+
+#ifdef SUDOKU_TRACE
+
+// Includes
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace Trace
+{
+    /// <summary>
+    /// Records the duration of the enclosing scope when it is left.
+    /// The name and the argument name must be string literals.
+    /// </summary>
+    class Scope
+    {
+        const char* mName;
+        const char* mArgName;
+        long long mArg;
+        std::uint64_t mStart;
+
+    public:
+        explicit Scope(const char* name, const char* argName = nullptr, long long arg = 0);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    /// <summary>
+    /// Write the events recorded so far by all the threads in the Chrome trace event format
+    /// </summary>
+    void WriteChromeJson(std::ostream& stream);
+    bool WriteChromeJson(const std::string& path);
+}
+
+#define SUDOKU_TRACE_CONCAT_IMPL(a, b) a##b
+#define SUDOKU_TRACE_CONCAT(a, b) SUDOKU_TRACE_CONCAT_IMPL(a, b)
+#define SUDOKU_TRACE_SCOPE(name) \
+    Trace::Scope SUDOKU_TRACE_CONCAT(traceScope, __LINE__)(name)
+#define SUDOKU_TRACE_SCOPE_ARG(name, argName, arg) \
+    Trace::Scope SUDOKU_TRACE_CONCAT(traceScope, __LINE__)(name, argName, static_cast<long long>(arg))
+
+#else
+
+#define SUDOKU_TRACE_SCOPE(name)
+#define SUDOKU_TRACE_SCOPE_ARG(name, argName, arg)
+
+#endif // SUDOKU_TRACE
+
+#endif // TRACE_H
@@ -0,0 +1,50 @@
+#include "TranspositionTable.h"
+#include <cassert>
+#include <utility>
+
+const size_t TranspositionTable::sDefaultCapacity = 4096;
+
+TranspositionTable::TranspositionTable(size_t capacity):
+    mCapacity(capacity),
+    mEntries()
+{
+    assert(mCapacity > 0);
+}
+
+size_t TranspositionTable::SlotGet(std::uint64_t hash, unsigned int depth) const
+{
+    // the same state searched at different depths should not evict itself
+    return static_cast<size_t>((hash + depth * 0x9E3779B97F4A7C15ull) % mCapacity);
+}
+
+const BifurcationResult* TranspositionTable::Find(std::uint64_t hash, unsigned int depth) const
+{
+    if (mEntries.empty())
+    {
+        return nullptr;
+    }
+    const Entry& entry = mEntries[SlotGet(hash, depth)];
+    if (entry.mDepth == depth && entry.mHash == hash)
+    {
+        return &entry.mResult;
+    }
+    return nullptr;
+}
+
+void TranspositionTable::Store(std::uint64_t hash, unsigned int depth, BifurcationResult result)
+{
+    assert(depth > 0);
+    if (mEntries.empty())
+    {
+        mEntries.resize(mCapacity, {0, 0, {false, {}}});
+    }
+    Entry& entry = mEntries[SlotGet(hash, depth)];
+    entry.mHash = hash;
+    entry.mDepth = depth;
+    entry.mResult = std::move(result);
+}
+
+void TranspositionTable::Clear()
+{
+    mEntries.clear();
+}
@@ -0,0 +1,73 @@
+#ifndef TRANSPOSITION_TABLE_H
+#define TRANSPOSITION_TABLE_H
+
+// Includes
+#include "Types.h"
+#include "CandidateMask.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// Zobrist key of a candidate of a cell. The hash of a candidate state is the xor
+/// of the keys of all the candidates still viable, so it can be updated incrementally.
+/// The keys are generated by mixing the candidate index rather than stored in a table.
+/// </summary>
+inline std::uint64_t CandidateKeyGet(CellId cell, unsigned short value)
+{
+    // splitmix64 finaliser
+    std::uint64_t z = (static_cast<std::uint64_t>(cell) * kMaxMaskDigits + value) * 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+/// <summary>
+/// Outcome of a bifurcation search started from a candidate state
+/// </summary>
+struct BifurcationResult
+{
+    bool mIsValid;                          // false if the state leads to a contradiction
+    std::vector<CandidateMask> mOptions;    // options left in each cell at the end of a valid search
+};
+
+/// <summary>
+/// Bounded cache of the bifurcation results, keyed by the hash of the candidate state
+/// the search started from and by the bifurcation depth it was allowed to use.
+/// Each key maps to a single slot and a new result overwrites whatever was stored there.
+/// </summary>
+class TranspositionTable
+{
+    struct Entry
+    {
+        std::uint64_t mHash;
+        unsigned int mDepth;                // 0 for an empty slot
+        BifurcationResult mResult;
+    };
+
+    const size_t mCapacity;
+    std::vector<Entry> mEntries;            // allocated on the first store
+
+    size_t SlotGet(std::uint64_t hash, unsigned int depth) const;
+
+public:
+    static const size_t sDefaultCapacity;
+
+// Constructors
+
+    explicit TranspositionTable(size_t capacity = sDefaultCapacity);
+
+// Const methods
+
+    /// <summary>
+    /// Result stored for the state, or nullptr if it is not known
+    /// </summary>
+    const BifurcationResult* Find(std::uint64_t hash, unsigned int depth) const;
+
+// Non-const methods
+
+    void Store(std::uint64_t hash, unsigned int depth, BifurcationResult result);
+    void Clear();
+};
+
+#endif // TRANSPOSITION_TABLE_H
@@ -0,0 +1,125 @@
+#include "TrueCandidatesFinder.h"
+#include "PuzzleSolutionCounter.h"
+#include <mutex>
+
+TrueCandidatesFinder::TrueCandidatesFinder(unsigned int threadsCount, unsigned int seed):
+    mWorkers(threadsCount),
+    mRng(seed)
+{
+}
+
+bool TrueCandidatesFinder::Find(const PuzzleData &puzzleData, bool useHints, Candidates &outCandidates,
+                                const CellSettledCallback &onCellSettled, const std::atomic<bool>* abort)
+{
+    const unsigned int size = puzzleData.mSize;
+    const unsigned int cellsCount = size * size;
+
+    // status of each cell-digit pair, at index cell * size + digit - 1
+    std::vector<PairStatus> status(cellsCount * size, PairStatus::Unknown);
+    std::vector<unsigned int> unknownCount(cellsCount, size);
+    Candidates candidates(cellsCount);
+    std::mutex statusMutex;
+
+    auto settle = [&](CellCoord cell, unsigned short value, PairStatus newStatus)
+    {
+        PairStatus& s = status[cell * size + value - 1];
+        if (s != PairStatus::Unknown) return;
+        s = newStatus;
+        if (newStatus == PairStatus::Witnessed)
+        {
+            candidates[cell].insert(value);
+        }
+        if (--unknownCount[cell] == 0 && onCellSettled)
+        {
+            onCellSettled(cell, candidates[cell]);
+        }
+    };
+    auto witness = [&](const PuzzleSolutionCounter::Solution& solution)
+    {
+        for (CellCoord cell = 0; cell < cellsCount; ++cell)
+        {
+            settle(cell, solution[cell], PairStatus::Witnessed);
+        }
+    };
+
+    // a first random solution witnesses one digit of every cell,
+    // and if there is none all the candidates are ruled out straight away
+    PuzzleSolutionCounter counter(puzzleData, useHints);
+    counter.ShuffleRows(mRng);
+    std::vector<PuzzleSolutionCounter::Solution> solutions;
+    counter.CountSolutions(1, abort, &solutions);
+    if (*abort)
+    {
+        return false;
+    }
+    if (!solutions.empty())
+    {
+        witness(solutions.front());
+    }
+
+    // digits excluded by the givens and the hints need no search
+    std::vector<std::pair<CellCoord, unsigned short>> pairs;
+    for (CellCoord cell = 0; cell < cellsCount; ++cell)
+    {
+        auto givenIt = puzzleData.mGivens.find(cell);
+        auto hintsIt = useHints ? puzzleData.mHints.find(cell) : puzzleData.mHints.end();
+        for (unsigned short v = 1; v <= size; ++v)
+        {
+            if (status[cell * size + v - 1] != PairStatus::Unknown) continue;
+
+            if (solutions.empty() ||
+                (givenIt != puzzleData.mGivens.end() && givenIt->second != v) ||
+                (hintsIt != puzzleData.mHints.end() && hintsIt->second.count(v) > 0))
+            {
+                settle(cell, v, PairStatus::Refuted);
+            }
+            else
+            {
+                pairs.emplace_back(cell, v);
+            }
+        }
+    }
+
+    // the pairs are queued cell by cell, so that the cells settle in order. A job whose pair
+    // has been witnessed by a solution found in the meantime returns without searching.
+    for (const auto& pair : pairs)
+    {
+        const unsigned int seed = mRng();
+        mWorkers.Submit([&, pair, seed]()
+        {
+            {
+                std::lock_guard<std::mutex> lock(statusMutex);
+                if (status[pair.first * size + pair.second - 1] != PairStatus::Unknown) return;
+            }
+
+            PuzzleData test = puzzleData;
+            test.mGivens[pair.first] = pair.second;
+            PuzzleSolutionCounter pairCounter(test, useHints);
+            // random solutions are more likely to witness other pairs
+            std::mt19937 rng(seed);
+            pairCounter.ShuffleRows(rng);
+
+            std::vector<PuzzleSolutionCounter::Solution> pairSolutions;
+            pairCounter.CountSolutions(1, abort, &pairSolutions);
+            if (*abort) return;
+
+            std::lock_guard<std::mutex> lock(statusMutex);
+            if (pairSolutions.empty())
+            {
+                settle(pair.first, pair.second, PairStatus::Refuted);
+            }
+            else
+            {
+                witness(pairSolutions.front());
+            }
+        });
+    }
+    mWorkers.Wait();
+    if (*abort)
+    {
+        return false;
+    }
+
+    outCandidates = std::move(candidates);
+    return true;
+}
@@ -0,0 +1,48 @@
+#ifndef TRUE_CANDIDATES_FINDER_H
+#define TRUE_CANDIDATES_FINDER_H
+
+// Includes
+#include "puzzledata.h"
+#include "WorkerPool.h"
+#include <atomic>
+#include <functional>
+#include <random>
+#include <set>
+#include <vector>
+
+/// <summary>
+/// Finds the true candidates of a puzzle: the digits of each cell that appear in at least one of its solutions.
+/// Every solution found witnesses all of its cell-digit pairs at once, so a targeted search
+/// (the digit placed in the cell, looking for a single solution) is only run for the pairs
+/// that no solution has witnessed yet. The searches run concurrently on a worker pool.
+/// </summary>
+class TrueCandidatesFinder
+{
+public:
+    typedef std::vector<std::set<unsigned short>> Candidates;       // true candidates of each cell
+    typedef std::function<void(CellCoord cell, const std::set<unsigned short>& candidates)> CellSettledCallback;
+
+private:
+    enum class PairStatus : char
+    {
+        Unknown,
+        Witnessed,
+        Refuted
+    };
+
+    WorkerPool mWorkers;
+    std::mt19937 mRng;
+
+public:
+    TrueCandidatesFinder(unsigned int threadsCount = 0, unsigned int seed = std::random_device()());
+
+    /// <summary>
+    /// Find the true candidates of every cell. As soon as all the digits of a cell are settled,
+    /// onCellSettled is called with its candidates, possibly from a worker thread (one call at a time).
+    /// Returns false if the search was aborted.
+    /// </summary>
+    bool Find(const PuzzleData& puzzleData, bool useHints, Candidates& outCandidates,
+              const CellSettledCallback& onCellSettled, const std::atomic<bool>* abort);
+};
+
+#endif // TRUE_CANDIDATES_FINDER_H
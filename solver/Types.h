@@ -18,15 +18,28 @@ class SudokuGrid;
 class RegionsManager;
 class GridProgressManager;
 
+// Comparators
+// Cells and regions are ordered by id rather than by address,
+// so that the solver visits them in the same order on every run.
+// The call operators are defined in SudokuCell.h and Region.h
+struct CellIdLess
+{
+    bool operator()(const SudokuCell* a, const SudokuCell* b) const;
+};
+struct RegionIdLess
+{
+    bool operator()(const Region* a, const Region* b) const;
+};
+
 //Typedefs
 typedef unsigned int CellId;
+typedef unsigned int RegionId;
 typedef std::unique_ptr<SudokuCell> CellUPtr;
 typedef std::unique_ptr<RegionsManager> RegionsManagerUPtr;
 typedef std::unique_ptr<GridProgressManager> GridProgressManagerUPtr;
-typedef std::shared_ptr<Region> RegionSPtr;
-typedef std::set<Region*> RegionSet;
+typedef std::set<Region*, RegionIdLess> RegionSet;
 typedef std::list<Region*> RegionList;
-typedef std::set<SudokuCell*> CellSet;
+typedef std::set<SudokuCell*, CellIdLess> CellSet;
 typedef std::list<SudokuCell*> CellList;
 typedef std::pair<unsigned short, CellSet> ValueMapEntry;
 
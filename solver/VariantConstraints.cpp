@@ -4,6 +4,7 @@
 #include "GridProgressManager.h"
 #include "qglobal.h"
 #include "SudokuCell.h"
+#include "Trace.h"
 #include "thirdparty/dancing_links.h"
 #include <cassert>
 
@@ -34,14 +35,17 @@ KillerConstraint::KillerConstraint(unsigned int sum) :
     mAllowedValues(),
     mCellToOrder(),
     mOrderToCell(),
-    mDLXSolutions(),
-    mValidSolution(),
+    mValidSolutions(),
+    mCellValueSupports(),
+    mValueSupports(),
+    mResidues(),
     mSnapshot(nullptr)
 {
 }
 
 void KillerConstraint::Initialise(Region* region)
 {
+    SUDOKU_TRACE_SCOPE("KillerConstraint::Initialise");
     VariantConstraint::Initialise(region);
     mSnapshot.reset();
 
@@ -50,8 +54,6 @@ void KillerConstraint::Initialise(Region* region)
     mAllowedValues.clear();
     mCellToOrder.clear();
     mOrderToCell.clear();
-    mDLXSolutions.clear();
-    mValidSolution.clear();
 
     unsigned short x = 0;
     for (const auto& c : region->CellsGet())
@@ -79,7 +81,10 @@ void KillerConstraint::Initialise(Region* region)
 
     linked_matrix_GJK::LMatrix DLXMatrix(incidenceMatrix, rowsCount, colsCount);
     std::list<std::vector<size_t>> solutions;
-    dancing_links_GJK::Exact_Cover_Solver(DLXMatrix, solutions);
+    {
+        SUDOKU_TRACE_SCOPE("dancing_links::Exact_Cover_Solver");
+        dancing_links_GJK::Exact_Cover_Solver(DLXMatrix, solutions);
+    }
 
     for (size_t i = 0; i < rowsCount; ++i)
     {
@@ -87,13 +92,16 @@ void KillerConstraint::Initialise(Region* region)
     }
     delete[] incidenceMatrix;
 
-    size_t size = mRegion->SizeGet();
-    mDLXSolutions.reserve(solutions.size());
-    mValidSolution.reserve(solutions.size());
+    // precompute, for each cell-value pair and each value, the bit set of the solutions supporting it
+    mValidSolutions.Init(solutions.size());
+    const BitMask noSolutions(mValidSolutions.WordsCountGet(), 0);
+    mCellValueSupports.assign(region->SizeGet() * gridSize, noSolutions);
+    mValueSupports.assign(gridSize, noSolutions);
+    mResidues.assign(mCellValueSupports.size(), 0);
+    size_t s = 0;
     for(const auto& sol : solutions)
     {
-        mDLXSolutions.push_back(std::vector<unsigned short>(size));
-        mValidSolution.push_back(true);
+        const std::uint64_t bit = std::uint64_t(1) << (s % 64);
         for (const auto& r : sol)
         {
             if(r >= mainRowsCount)
@@ -101,9 +109,10 @@ void KillerConstraint::Initialise(Region* region)
                 continue;
             }
             auto p = PossibilityFromRow(r);
-            unsigned short index = mCellToOrder[p.first];
-            mDLXSolutions.back()[index] = p.second;
+            mCellValueSupports[SupportIndexGet(mCellToOrder[p.first], p.second)][s / 64] |= bit;
+            mValueSupports[p.second - 1][s / 64] |= bit;
         }
+        ++s;
     }
 
     UpdateAllowedAndConfirmedValues();
@@ -130,15 +139,7 @@ void KillerConstraint::OnConfimedValueAdded(unsigned short value)
 void KillerConstraint::OnOptionRemovedFromCell(unsigned short value, SudokuCell* cell)
 {
     unsigned short index = mCellToOrder[cell->IdGet()];
-    bool removed = false;
-    for (size_t i = 0; i < mDLXSolutions.size(); ++i)
-    {
-        if(mValidSolution.at(i) && mDLXSolutions.at(i).at(index) == value)
-        {
-            mValidSolution.at(i) = false;
-            removed = true;
-        }
-    }
+    bool removed = mValidSolutions.Remove(mCellValueSupports[SupportIndexGet(index, value)]);
     mAllowedValues.at(index).erase(value);
 
     if(removed)
@@ -173,14 +174,15 @@ VariantConstraint *KillerConstraint::DeepCopy() const
 
 void KillerConstraint::TakeSnaphot()
 {
-    mSnapshot = std::make_unique<Snapshot>(mValidSolution, mConfirmedValues, mAllowedValues);
+    mValidSolutions.TakeSnapshot();
+    mSnapshot = std::make_unique<Snapshot>(mConfirmedValues, mAllowedValues);
 }
 
 void KillerConstraint::RestoreSnaphot()
 {
     if(mSnapshot)
     {
-        mValidSolution = std::move(mSnapshot->mValidSolution);
+        mValidSolutions.RestoreSnapshot();
         mConfirmedValues = std::move(mSnapshot->mConfirmedValues);
         mAllowedValues = std::move(mSnapshot->mAllowedValues);
         mSnapshot.reset();
@@ -241,18 +243,7 @@ void KillerConstraint::FindCombinationsInner(std::list<unsigned short>::const_it
 
 void KillerConstraint::RemoveCombinationsWithoutValue(unsigned short value)
 {
-    bool removed = false;
-    for (size_t i = 0; i < mDLXSolutions.size(); ++i)
-    {
-        if(mValidSolution.at(i) &&
-           std::find(mDLXSolutions.at(i).begin(), mDLXSolutions.at(i).end(), value) == mDLXSolutions.at(i).end())
-        {
-            mValidSolution.at(i) = false;
-            removed = true;
-        }
-    }
-
-    if (removed)
+    if (mValidSolutions.IntersectWith(mValueSupports[value - 1]))
     {
         UpdateAllowedAndConfirmedValues();
     }
@@ -262,75 +253,51 @@ void KillerConstraint::AddConfirmedValue(unsigned value)
 {
     if (mConfirmedValues.insert(value).second && !mRegion->HasConfirmedValue(value))
     {
-        mRegion->GridGet()->ProgressManagerGet()->RegisterProgress(std::make_shared<Progress_ValueForcedInKiller>(mRegion, value));
+        mRegion->GridGet()->ProgressManagerGet()->RegisterProgress<Progress_ValueForcedInKiller>(mRegion, value);
     }
 }
 
 void KillerConstraint::UpdateAllowedAndConfirmedValues()
 {
     SudokuGrid* grid = mRegion->GridGet();
-    std::vector<std::set<unsigned short>> optionsForbiddenInCell = mAllowedValues;
-    std::set<unsigned short> newConfirmed;
-
-    for (unsigned short i = 1; i <= grid->SizeGet(); ++i)
-    {
-        if(mConfirmedValues.count(i) == 0)
-        {
-            newConfirmed.insert(i);
-        }
-    }
 
-    for (size_t s = 0; s < mDLXSolutions.size(); ++s)
+    // an option of a cell is ruled out when no remaining solution supports it
+    for (unsigned short i = 0; i < mAllowedValues.size(); ++i)
     {
-        if(!mValidSolution.at(s)) continue;
-
-        bool canEliminate = false;
-        const auto& solution = mDLXSolutions.at(s);
-        for (size_t i = 0; i < optionsForbiddenInCell.size(); ++i)
+        std::set<unsigned short> optionsForbiddenInCell;
+        for (const auto v : mAllowedValues.at(i))
         {
-            if(!optionsForbiddenInCell.at(i).empty())
+            const size_t support = SupportIndexGet(i, v);
+            if (!mValidSolutions.Intersects(mCellValueSupports[support], mResidues[support]))
             {
-                canEliminate = true;
-                optionsForbiddenInCell.at(i).erase(solution.at(i));
+                optionsForbiddenInCell.insert(v);
             }
         }
 
-        auto cIt = newConfirmed.begin();
-        while ( cIt!=newConfirmed.end() )
+        if(!optionsForbiddenInCell.empty())
         {
-            if(std::find(solution.begin(), solution.end(), *cIt) == solution.end())
-            {
-                cIt = newConfirmed.erase(cIt);
-            }
-            else
+            SudokuCell* cell = grid->CellGet(mOrderToCell[i]);
+            for (const auto v : optionsForbiddenInCell)
             {
-                ++cIt;
+                mAllowedValues.at(i).erase(v);
             }
-        }
-
-        if(newConfirmed.empty() && !canEliminate)
-        {
-            break;
+            grid->ProgressManagerGet()->RegisterProgress<Progress_ValueNotInKiller>(cell, mRegion, CandidatesMaskGet(optionsForbiddenInCell));
         }
     }
 
-    for (size_t i = 0; i < optionsForbiddenInCell.size(); ++i)
+    // a value is confirmed when all the remaining solutions contain it
+    for (unsigned short v = 1; v <= grid->SizeGet(); ++v)
     {
-        if(!optionsForbiddenInCell.at(i).empty())
+        if(mConfirmedValues.count(v) == 0 && mValidSolutions.IsSubsetOf(mValueSupports[v - 1]))
         {
-            SudokuCell* cell = grid->CellGet(mOrderToCell[i]);
-            for (const auto v : optionsForbiddenInCell.at(i))
-            {
-                mAllowedValues.at(i).erase(v);
-            }
-            grid->ProgressManagerGet()->RegisterProgress(std::make_shared<Progress_ValueNotInKiller>(cell, mRegion, std::move(optionsForbiddenInCell.at(i))));
+            AddConfirmedValue(v);
         }
     }
+}
 
-    for (const auto& v : newConfirmed)
-    {
-        AddConfirmedValue(v);
-    }
+size_t KillerConstraint::SupportIndexGet(unsigned short order, unsigned short value) const
+{
+    return order * mRegion->GridGet()->SizeGet() + value - 1;
 }
 
 size_t KillerConstraint::RowFromPossibility(CellId cell, unsigned short value) const
@@ -3,6 +3,7 @@
 
 // Includes
 #include "Types.h"
+#include "ReversibleSparseBitSet.h"
 
 /// <summary>
 /// Constraint other than standard Sudoku rules
@@ -66,19 +67,20 @@ private:
 
     std::map<CellId, unsigned short> mCellToOrder;
     std::map<unsigned short, CellId> mOrderToCell;
-    std::vector<std::vector<unsigned short>> mDLXSolutions;
-    std::vector<bool> mValidSolution;
+
+    // Compact-Table propagation over the solutions of the cage
+    ReversibleSparseBitSet mValidSolutions;         // solutions still compatible with the options of the cells
+    std::vector<BitMask> mCellValueSupports;        // solutions where a cell holds a value, see SupportIndexGet()
+    std::vector<BitMask> mValueSupports;            // solutions containing value v, at index v - 1
+    std::vector<size_t> mResidues;                  // word where each cell-value pair was last found supported
 
     struct Snapshot
     {
-        std::vector<bool> mValidSolution;
         std::set<unsigned short> mConfirmedValues;
         std::vector<std::set<unsigned short>> mAllowedValues;
 
-        Snapshot(std::vector<bool> validSolution,
-                 std::set<unsigned short> confirmedValues,
+        Snapshot(std::set<unsigned short> confirmedValues,
                  std::vector<std::set<unsigned short>> allowedValues):
-            mValidSolution(validSolution),
             mConfirmedValues(confirmedValues),
             mAllowedValues(allowedValues)
         {}
@@ -128,6 +130,7 @@ private:
     /// </summary>
     void UpdateAllowedAndConfirmedValues();
 
+    size_t SupportIndexGet(unsigned short order, unsigned short value) const;
     size_t RowFromPossibility(CellId cell, unsigned short value) const;
     std::pair<CellId, unsigned short> PossibilityFromRow(size_t row) const;
     void FillIncidenceMatrix(bool** M, size_t mainRows, size_t rows, size_t column);
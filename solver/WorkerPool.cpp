@@ -0,0 +1,80 @@
+#include "WorkerPool.h"
+#include <algorithm>
+
+WorkerPool::WorkerPool(unsigned int threadsCount):
+    mThreads(),
+    mJobs(),
+    mPendingJobs(0),
+    mQuit(false),
+    mMutex(),
+    mJobAvailable(),
+    mJobsDone()
+{
+    if (threadsCount == 0)
+    {
+        threadsCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    mThreads.reserve(threadsCount);
+    for (unsigned int i = 0; i < threadsCount; ++i)
+    {
+        mThreads.emplace_back(&WorkerPool::WorkerLoop, this);
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mQuit = true;
+    }
+    mJobAvailable.notify_all();
+    for (auto& t : mThreads)
+    {
+        t.join();
+    }
+}
+
+void WorkerPool::WorkerLoop()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    for (;;)
+    {
+        mJobAvailable.wait(lock, [this]() { return mQuit || !mJobs.empty(); });
+        if (mJobs.empty())
+        {
+            return;
+        }
+        std::function<void()> job = std::move(mJobs.front());
+        mJobs.pop_front();
+
+        lock.unlock();
+        job();
+        lock.lock();
+
+        if (--mPendingJobs == 0)
+        {
+            mJobsDone.notify_all();
+        }
+    }
+}
+
+unsigned int WorkerPool::ThreadsCountGet() const
+{
+    return static_cast<unsigned int>(mThreads.size());
+}
+
+void WorkerPool::Submit(std::function<void()> job)
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mJobs.push_back(std::move(job));
+        ++mPendingJobs;
+    }
+    mJobAvailable.notify_one();
+}
+
+void WorkerPool::Wait()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    mJobsDone.wait(lock, [this]() { return mPendingJobs == 0; });
+}
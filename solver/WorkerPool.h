@@ -0,0 +1,45 @@
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+// Includes
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// <summary>
+/// Fixed set of worker threads running batches of independent jobs
+/// </summary>
+class WorkerPool
+{
+    std::vector<std::thread> mThreads;
+    std::deque<std::function<void()>> mJobs;
+    size_t mPendingJobs;            // jobs queued or running
+    bool mQuit;
+    std::mutex mMutex;
+    std::condition_variable mJobAvailable;
+    std::condition_variable mJobsDone;
+
+    void WorkerLoop();
+
+public:
+    /// <summary>
+    /// Start the workers. With threadsCount = 0, one worker per hardware thread is started.
+    /// </summary>
+    explicit WorkerPool(unsigned int threadsCount = 0);
+    ~WorkerPool();
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    unsigned int ThreadsCountGet() const;
+    void Submit(std::function<void()> job);
+
+    /// <summary>
+    /// Block until all the submitted jobs have completed
+    /// </summary>
+    void Wait();
+};
+
+#endif // WORKER_POOL_H
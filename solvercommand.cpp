@@ -0,0 +1,108 @@
+#include "solvercommand.h"
+
+SolverCommand::SolverCommand():
+    mType(Command_None),
+    mId(0),
+    mValue(0),
+    mCells()
+{
+}
+
+SolverCommand::SolverCommand(Type type, CellCoord id /* = 0 */, unsigned int value /* = 0 */, CellsInRegion cells /* = {} */):
+    mType(type),
+    mId(id),
+    mValue(value),
+    mCells(std::move(cells))
+{
+}
+
+SolverCommand::Effect SolverCommand::ApplyTo(PuzzleData &data) const
+{
+    switch (mType)
+    {
+    case Command_AddGiven:
+    {
+        if(mValue == 0 || mValue > data.mSize)
+        {
+            return Effect_None;
+        }
+        auto it = data.mGivens.find(mId);
+        if(it == data.mGivens.end())
+        {
+            data.mGivens[mId] = mValue;
+            return Effect_Incremental;
+        }
+        else if(it->second != mValue)
+        {
+            it->second = mValue;
+            return Effect_ReloadCells;
+        }
+        return Effect_None;
+    }
+    case Command_RemoveGiven:
+    {
+        return data.mGivens.erase(mId) > 0 ? Effect_ReloadCells : Effect_None;
+    }
+    case Command_AddHint:
+    {
+        return data.mHints[mId].insert(mValue).second ? Effect_Incremental : Effect_None;
+    }
+    case Command_RemoveHint:
+    {
+        auto it = data.mHints.find(mId);
+        if(it != data.mHints.end() && it->second.erase(mValue) > 0)
+        {
+            return Effect_ReloadCells;
+        }
+        return Effect_None;
+    }
+    case Command_RemoveAllHints:
+    {
+        if(data.mHints.empty())
+        {
+            return Effect_None;
+        }
+        data.mHints.clear();
+        return Effect_ReloadCells;
+    }
+    case Command_SetRegion:
+    {
+        if(mId >= data.mRegions.size() || data.mRegions.at(mId) == mCells)
+        {
+            return Effect_None;
+        }
+        Effect effect = data.mRegions.at(mId).empty() ? Effect_Incremental : Effect_ReloadGrid;
+        data.mRegions.at(mId) = mCells;
+        return effect;
+    }
+    case Command_SetDiagonal:
+    {
+        bool& diagonal = mId == PuzzleData::Diagonal_Positive ? data.mPositiveDiagonal : data.mNegativeDiagonal;
+        if(diagonal == (mValue != 0))
+        {
+            return Effect_None;
+        }
+        diagonal = mValue != 0;
+        return diagonal ? Effect_Incremental : Effect_ReloadGrid;
+    }
+    case Command_AddKillerCage:
+    {
+        if(mCells.empty() || data.mKillerCages.count(mId) > 0)
+        {
+            return Effect_None;
+        }
+        data.mKillerCages[mId] = {mValue, mCells};
+        return Effect_Incremental;
+    }
+    case Command_RemoveKillerCage:
+    {
+        return data.mKillerCages.erase(mId) > 0 ? Effect_ReloadGrid : Effect_None;
+    }
+    case Command_ResetSolver:
+    {
+        return Effect_ReloadGrid;
+    }
+    default:
+        return Effect_None;
+    }
+}
@@ -0,0 +1,52 @@
+#ifndef SOLVERCOMMAND_H
+#define SOLVERCOMMAND_H
+
+#include "puzzledata.h"
+
+/// <summary>
+/// A single edit of the puzzle, posted by the UI thread to the logical solver.
+/// Both threads apply the same sequence of commands to their own copy of the
+/// puzzle data, so the two copies never need to be synchronised wholesale.
+/// </summary>
+class SolverCommand
+{
+public:
+    enum Type
+    {
+        Command_None,
+        Command_AddGiven,
+        Command_RemoveGiven,
+        Command_AddHint,
+        Command_RemoveHint,
+        Command_RemoveAllHints,
+        Command_SetRegion,
+        Command_SetDiagonal,
+        Command_AddKillerCage,
+        Command_RemoveKillerCage,
+        Command_ResetSolver
+    };
+
+    // What the solver has to do to take a command into account
+    enum Effect
+    {
+        Effect_None,            // the command did not change the puzzle
+        Effect_Incremental,     // the new constraint can be added to the current grid
+        Effect_ReloadCells,     // the contents of the cells have to be recomputed
+        Effect_ReloadGrid       // the regions have to be redefined
+    };
+
+    SolverCommand();
+    SolverCommand(Type type, CellCoord id = 0, unsigned int value = 0, CellsInRegion cells = {});
+
+    Type mType;
+    CellCoord mId;          // cell id, cage id or region index
+    unsigned int mValue;    // given, hint, cage total or diagonal flag
+    CellsInRegion mCells;   // cells of a region or of a killer cage
+
+    /// <summary>
+    /// Apply the edit to the puzzle data and return what the solver needs to do about it
+    /// </summary>
+    Effect ApplyTo(PuzzleData& data) const;
+};
+
+#endif // SOLVERCOMMAND_H
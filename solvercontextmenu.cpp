@@ -120,11 +120,9 @@ void SolverContextMenu::CellClicked(SudokuCellWidget *cell)
 
 void SolverContextMenu::KeyboardInput(SudokuCellWidget *cell, QKeyEvent *event)
 {
-    bool ok;
-    int num = event->text().toInt(&ok);
-
     SudokuGridWidget* grid = mMainWindowContent->GridGet();
-    if(ok && num > 0 && num <= grid->SizeGet())
+    int num;
+    if(TypedNumberGet(cell, event, grid->SizeGet(), num) && num > 0)
     {
         cell->SetGivenDigit(static_cast<unsigned short>(num));
     }
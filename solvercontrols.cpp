@@ -2,23 +2,31 @@
 #include "bruteforcesolverthread.h"
 #include "mainwindowcontent.h"
 #include "sudokugridwidget.h"
+#include "truecandidatesthread.h"
 #include <QVBoxLayout>
 #include <QFrame>
 #include <QFormLayout>
 #include <QLabel>
+#include <QFileDialog>
+#include <QMessageBox>
 
 SolverControls::SolverControls(BruteForceSolverThread* bruteForceSolver, MainWindowContent* mainWindow, QWidget *parent)
     : QWidget{parent}
     , mCountSolutionsBtn(new QPushButton("Count Solutions"))
     , mBruteForceSolveBtn(new QPushButton("Display Solution"))
+    , mTrueCandidatesBtn(new QPushButton("Show True Candidates"))
     , mMaxSolutionsCount(new QSpinBox())
     , mUseHintsCheckbox(new QCheckBox("Use hints as constrainsts"))
+    , mLearnConflictsCheckbox(new QCheckBox("Learn from conflicts"))
+    , mAdaptiveSchedulingCheckbox(new QCheckBox("Adaptive technique order"))
+    , mExportDimacsBtn(new QPushButton("Export CNF"))
     , mAbortCalculationsBtn(new QPushButton("Abort Calculation"))
     , mClearGridBtn(new QPushButton("Clear Grid"))
     , mLogicalStepBtn(new QPushButton("Take Logical Step"))
     , mMainWindow(mainWindow)
     , mBruteForceSolver(bruteForceSolver)
     , mSolverThread(mainWindow->GridGet()->SolverGet())
+    , mTrueCandidatesFinder(mSolverThread->TrueCandidatesFinderGet())
 {
     // build the vertical layout
     QVBoxLayout* verticalLayout = new QVBoxLayout(this);
@@ -26,8 +34,11 @@ SolverControls::SolverControls(BruteForceSolverThread* bruteForceSolver, MainWin
     QWidget* formWidget = new QWidget();
     verticalLayout->addWidget(mCountSolutionsBtn);
     verticalLayout->addWidget(mBruteForceSolveBtn);
+    verticalLayout->addWidget(mTrueCandidatesBtn);
     verticalLayout->addWidget(formWidget);
     verticalLayout->addWidget(mUseHintsCheckbox);
+    verticalLayout->addWidget(mLearnConflictsCheckbox);
+    verticalLayout->addWidget(mExportDimacsBtn);
     verticalLayout->addWidget(mAbortCalculationsBtn);
 
     QFrame* line = new QFrame();
@@ -36,6 +47,7 @@ SolverControls::SolverControls(BruteForceSolverThread* bruteForceSolver, MainWin
     line->setFrameStyle(QFrame::HLine | QFrame::Sunken);
     verticalLayout->addWidget(line);
     verticalLayout->addWidget(mLogicalStepBtn);
+    verticalLayout->addWidget(mAdaptiveSchedulingCheckbox);
     verticalLayout->addWidget(mClearGridBtn);
     verticalLayout->addStretch();
 
@@ -50,42 +62,92 @@ SolverControls::SolverControls(BruteForceSolverThread* bruteForceSolver, MainWin
     mMaxSolutionsCount->setRange(100, 100000);
     mMaxSolutionsCount->setValue(1000);
     mAbortCalculationsBtn->setEnabled(false);
+    mLearnConflictsCheckbox->setToolTip("Search with clause learning instead of dancing links.\n"
+                                        "Faster on puzzles with many killer cages, slower on plain ones.");
+    mAdaptiveSchedulingCheckbox->setToolTip("Try first the techniques that have found the most deductions for their cost.\n"
+                                            "Faster, but the order of the deductions may change from run to run.\n"
+                                            "Single logical steps always use the fixed order.");
+    mTrueCandidatesBtn->setToolTip("Show the digits of each cell that appear in at least one solution.\n"
+                                   "Cells are filled in as soon as their candidates are confirmed.");
+    mExportDimacsBtn->setToolTip("Save the constraints of the puzzle in the DIMACS format,\n"
+                                 "to be checked with a standalone SAT solver.");
 
     // events
     connect(mCountSolutionsBtn, SIGNAL(clicked(bool)), this, SLOT(CountSolutionsBtn_Clicked()));
     connect(mBruteForceSolveBtn, SIGNAL(clicked(bool)), this, SLOT(DisplaySolutionsBtn_Clicked()));
+    connect(mTrueCandidatesBtn, SIGNAL(clicked(bool)), this, SLOT(TrueCandidatesBtn_Clicked()));
     connect(mAbortCalculationsBtn, SIGNAL(clicked(bool)), this, SLOT(AbortButton_Clicked()));
+    connect(mLearnConflictsCheckbox, SIGNAL(toggled(bool)), this, SLOT(LearnConflictsCheckbox_Toggled()));
+    connect(mAdaptiveSchedulingCheckbox, SIGNAL(toggled(bool)), this, SLOT(AdaptiveSchedulingCheckbox_Toggled()));
+    connect(mExportDimacsBtn, SIGNAL(clicked(bool)), this, SLOT(ExportDimacsBtn_Clicked()));
     connect(mClearGridBtn, SIGNAL(clicked(bool)), this, SLOT(ClearGridBtn_Clicked()));
     connect(mLogicalStepBtn, SIGNAL(clicked(bool)), this, SLOT(LogicalStepBtn_Clicked()));
     connect(mBruteForceSolver, SIGNAL(CalculationStarted()), this, SLOT(CalculationStarted()));
     connect(mBruteForceSolver, SIGNAL(CalculationFinished()), this, SLOT(CalculationFinished()));
+    connect(mTrueCandidatesFinder, SIGNAL(CalculationStarted()), this, SLOT(CalculationStarted()));
+    connect(mTrueCandidatesFinder, SIGNAL(CalculationFinished(bool)), this, SLOT(CalculationFinished()));
+}
+
+void SolverControls::LearnConflictsCheckbox_Toggled()
+{
+    mBruteForceSolver->SearchEngineSet(mLearnConflictsCheckbox->isChecked() ?
+                                           BruteForceSolver::SearchEngine::ConflictDriven :
+                                           BruteForceSolver::SearchEngine::DancingLinks);
+}
+
+void SolverControls::AdaptiveSchedulingCheckbox_Toggled()
+{
+    mSolverThread->SchedulingModeSet(mAdaptiveSchedulingCheckbox->isChecked() ?
+                                         SchedulingMode::Adaptive :
+                                         SchedulingMode::FixedOrder);
+}
+
+void SolverControls::ExportDimacsBtn_Clicked()
+{
+    QString path = QFileDialog::getSaveFileName(this, "Export CNF", "", "DIMACS CNF (*.cnf)");
+    if(!path.isEmpty() && !mBruteForceSolver->ExportDimacs(mSolverThread->PuzzleDataGet(), path, mUseHintsCheckbox->isChecked()))
+    {
+        QMessageBox::warning(this, "Export CNF", "The file could not be written.");
+    }
 }
 
 void SolverControls::CountSolutionsBtn_Clicked()
 {
     mSolverThread->SetLogicalSolverPaused(true);
+    mTrueCandidatesFinder->AbortCalculation();
     mBruteForceSolver->CountSolutions(mMaxSolutionsCount->value(), mUseHintsCheckbox->isChecked());
 }
 
 void SolverControls::DisplaySolutionsBtn_Clicked()
 {
     mSolverThread->SetLogicalSolverPaused(true);
+    mTrueCandidatesFinder->AbortCalculation();
     mBruteForceSolver->DisplaySolution(mMaxSolutionsCount->value(), mUseHintsCheckbox->isChecked());
 }
 
+void SolverControls::TrueCandidatesBtn_Clicked()
+{
+    mSolverThread->SetLogicalSolverPaused(true);
+    mBruteForceSolver->AbortCalculation();
+    mTrueCandidatesFinder->FindTrueCandidates(mSolverThread->PuzzleDataGet(), mUseHintsCheckbox->isChecked());
+}
+
 void SolverControls::ClearGridBtn_Clicked()
 {
+    mTrueCandidatesFinder->AbortCalculation();
     mSolverThread->ResetSolver();
 }
 
 void SolverControls::AbortButton_Clicked()
 {
     mBruteForceSolver->AbortCalculation();
+    mTrueCandidatesFinder->AbortCalculation();
 }
 
 void SolverControls::LogicalStepBtn_Clicked()
 {
     mBruteForceSolver->AbortCalculation();
+    mTrueCandidatesFinder->AbortCalculation();
     mBruteForceSolver->ResetGridContents();
     mSolverThread->TakeStep();
 }
@@ -9,6 +9,7 @@
 class BruteForceSolverThread;
 class MainWindowContent;
 class SudokuSolverThread;
+class TrueCandidatesThread;
 
 class SolverControls : public QWidget
 {
@@ -19,8 +20,12 @@ public:
 private:
     QPushButton* mCountSolutionsBtn;
     QPushButton* mBruteForceSolveBtn;
+    QPushButton* mTrueCandidatesBtn;
     QSpinBox* mMaxSolutionsCount;
     QCheckBox* mUseHintsCheckbox;
+    QCheckBox* mLearnConflictsCheckbox;
+    QCheckBox* mAdaptiveSchedulingCheckbox;
+    QPushButton* mExportDimacsBtn;
     QPushButton* mAbortCalculationsBtn;
     QPushButton* mClearGridBtn;
     QPushButton* mLogicalStepBtn;
@@ -28,10 +33,15 @@ private:
     MainWindowContent* mMainWindow;
     BruteForceSolverThread* mBruteForceSolver;
     SudokuSolverThread* mSolverThread;
+    TrueCandidatesThread* mTrueCandidatesFinder;
 
 private slots:
+    void LearnConflictsCheckbox_Toggled();
+    void AdaptiveSchedulingCheckbox_Toggled();
+    void ExportDimacsBtn_Clicked();
     void CountSolutionsBtn_Clicked();
     void DisplaySolutionsBtn_Clicked();
+    void TrueCandidatesBtn_Clicked();
     void ClearGridBtn_Clicked();
     void AbortButton_Clicked();
     void LogicalStepBtn_Clicked();
@@ -0,0 +1,73 @@
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <atomic>
+#include <utility>
+
+/// <summary>
+/// Unbounded lock-free queue for exactly one producer thread and one consumer thread.
+/// The producer allocates a node per element and publishes it with a release store;
+/// the consumer frees the nodes it has consumed. Neither side ever waits on the other.
+/// </summary>
+template<class T>
+class SpscQueue
+{
+    struct Node
+    {
+        std::atomic<Node*> mNext;
+        T mValue;
+
+        Node() : mNext(nullptr), mValue() {}
+    };
+
+    alignas(64) Node* mHead;    // consumer side: the last node consumed
+    alignas(64) Node* mTail;    // producer side: the last node pushed
+
+public:
+    SpscQueue() :
+        mHead(new Node()),
+        mTail(mHead)
+    {}
+
+    ~SpscQueue()
+    {
+        while (mHead)
+        {
+            Node* next = mHead->mNext.load(std::memory_order_relaxed);
+            delete mHead;
+            mHead = next;
+        }
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    /// <summary>
+    /// Producer only
+    /// </summary>
+    void Push(T value)
+    {
+        Node* node = new Node();
+        node->mValue = std::move(value);
+        mTail->mNext.store(node, std::memory_order_release);
+        mTail = node;
+    }
+
+    /// <summary>
+    /// Consumer only. Returns false if the queue is empty.
+    /// </summary>
+    bool Pop(T& outValue)
+    {
+        Node* next = mHead->mNext.load(std::memory_order_acquire);
+        if (!next)
+        {
+            return false;
+        }
+        outValue = std::move(next->mValue);
+        delete mHead;
+        mHead = next;
+        return true;
+    }
+};
+
+#endif // SPSCQUEUE_H
@@ -2,14 +2,19 @@
 #include "mainwindow.h"
 #include "puzzledata.h"
 #include "IO/SaveLoadManager.h"
+#include "IO/PuzzleCollection.h"
+#include "IO/BulkPuzzleImporter.h"
 #include <QVBoxLayout>
 #include <QLabel>
 #include <QFrame>
 #include <QFormLayout>
 #include <QFileDialog>
+#include <QFileInfo>
+#include <QInputDialog>
+#include <QMessageBox>
 
 unsigned short kMinPuzzleSize = 4;
-unsigned short kMaxPuzzleSize = 9;
+unsigned short kMaxPuzzleSize = 36;
 unsigned short kDefaultPuzzleSize = 9;
 
 StartMenu::StartMenu(QWidget *parent)
@@ -89,16 +94,60 @@ void StartMenu::NewPuzzleBtn_clicked()
 
 void StartMenu::LoadPuzzleBtn_clicked()
 {
-    // open file with extension .sudoku
-    QString fileName = QFileDialog::getOpenFileName(this,"Open file", "", "*.sudoku");
+    // open file with extension .sudoku or a puzzle collection
+    QString fileName = QFileDialog::getOpenFileName(this,"Open file", "", "Sudoku (*.sudoku);;Sudoku collection (*.sdkc);;One-line puzzles (*.txt)");
     if(!fileName.isEmpty())
     {
         std::unique_ptr<PuzzleData> pd;
-        if(SaveLoadManager::Get()->LoadSudoku(fileName.toStdString(), pd))
+        QString savePath = fileName;
+        bool loaded = false;
+        if(QFileInfo(fileName).suffix() == "txt")
+        {
+            // convert the text file, unless it has not changed since it was last converted,
+            // then open it as any other collection
+            QString collectionPath = fileName + "." + PuzzleCollection::kFileExtension;
+            const QFileInfo collectionInfo(collectionPath);
+            const bool upToDate = collectionInfo.exists() && collectionInfo.lastModified() >= QFileInfo(fileName).lastModified();
+            if(!upToDate && !BulkPuzzleImporter::ImportToCollection(fileName.toStdString(), collectionPath.toStdString()))
+            {
+                QMessageBox::warning(this, "Open file", "The puzzles could not be imported.");
+                return;
+            }
+            fileName = collectionPath;
+        }
+
+        if(QFileInfo(fileName).suffix() == PuzzleCollection::kFileExtension)
+        {
+            PuzzleCollection collection;
+            if(!collection.Open(fileName.toStdString()) || collection.CountGet() == 0)
+            {
+                QMessageBox::warning(this, "Open collection", "The file is not a valid puzzle collection.");
+                return;
+            }
+            bool ok = false;
+            int index = QInputDialog::getInt(this, "Open collection", "Puzzle number:", 1, 1, static_cast<int>(collection.CountGet()), 1, &ok);
+            if(!ok)
+            {
+                return;
+            }
+            loaded = collection.LoadPuzzle(index - 1, pd);
+            // the collection is read-only: saving must ask for a new file
+            savePath = "";
+        }
+        else
+        {
+            loaded = SaveLoadManager::Get()->LoadSudoku(fileName.toStdString(), pd);
+        }
+
+        if(!loaded)
+        {
+            QMessageBox::warning(this, "Open file", "The puzzle could not be loaded.");
+        }
+        else
         {
             close();
             deleteLater();
-            MainWindow* w = new MainWindow(pd->mSize, std::move(pd), fileName);
+            MainWindow* w = new MainWindow(pd->mSize, std::move(pd), savePath);
             w->show();
         }
     }
@@ -8,9 +8,11 @@
 #include <QLabel>
 #include <QStackedLayout>
 #include <QStackedWidget>
+#include <QPainter>
+#include <QStaticText>
 
 SudokuCellWidget::SudokuCellWidget(unsigned short row, unsigned short col, unsigned short gridSize,int cellLength,
-                                   MainWindowContent* mainWindowContent, QWidget *parent)
+                                   MainWindowContent* mainWindowContent, QWidget* paintedBy, QWidget *parent)
     : QFrame{parent},
       mCol(col),
       mRow(row),
@@ -18,16 +20,19 @@ SudokuCellWidget::SudokuCellWidget(unsigned short row, unsigned short col, unsig
       mId(row * gridSize + col),
       mIsSolved(false),
       mMainWindowContent(mainWindowContent),
+      mPaintedBy(paintedBy),
       mNeighbours(4, nullptr),
       mVariantClues(),
-      mOverlayLayout(new QStackedLayout(this)),
-      mStackedContent(new QStackedWidget()),
-      mOptionsLabel(new CellContentButton(gridSize, this)),
-      mValueLabel(new CellContentButton(gridSize, this)),
-      mRegionIdLabel(new CellContentButton(gridSize, this)),
-      mGraphicsOverlay(new QLabel()),
+      mOverlayLayout(paintedBy ? nullptr : new QStackedLayout(this)),
+      mStackedContent(paintedBy ? nullptr : new QStackedWidget()),
+      mOptionsLabel(paintedBy ? nullptr : new CellContentButton(gridSize, this)),
+      mValueLabel(paintedBy ? nullptr : new CellContentButton(gridSize, this)),
+      mRegionIdLabel(paintedBy ? nullptr : new CellContentButton(gridSize, this)),
+      mGraphicsOverlay(paintedBy ? nullptr : new QLabel()),
       mContentString(""),
+      mValueString(""),
       mContentType(ContentType::CellOptions),
+      mCurrentView(CellView::Options),
       mRegionId(0),
       mLength(cellLength),
       mBoldEdges(None),
@@ -35,6 +40,14 @@ SudokuCellWidget::SudokuCellWidget(unsigned short row, unsigned short col, unsig
 {
     this->setObjectName("cell");
 
+    // a painted cell only keeps the state of the cell: it is never shown
+    if(mPaintedBy)
+    {
+        this->setParent(mPaintedBy);
+        this->hide();
+        return;
+    }
+
     // build stacked layout of the cell
     mOverlayLayout->setStackingMode(QStackedLayout::StackingMode::StackAll);
     this->setLayout(mOverlayLayout);
@@ -55,8 +68,8 @@ SudokuCellWidget::SudokuCellWidget(unsigned short row, unsigned short col, unsig
     mRegionIdLabel->setText(mRegionId ? QString::number(mRegionId) : "-");
 
     // text font
-    mValueLabel->setFont(QFont(mValueLabel->font().family(),20, 500));
-    mRegionIdLabel->setFont(QFont(mValueLabel->font().family(),20, 700));
+    mValueLabel->setFont(QFont(mValueLabel->font().family(),mLength / 3, 500));
+    mRegionIdLabel->setFont(QFont(mValueLabel->font().family(),mLength / 3, 700));
 
     // borders and sizes
     // mValueLabel->setFlat(true);
@@ -90,6 +103,12 @@ QString SudokuCellWidget::EdgeNameGet(CellEdge edge) const
 
 void SudokuCellWidget::RefreshLayout()
 {
+    if(mPaintedBy)
+    {
+        // bold edges are drawn across the boundary with the neighbours
+        mPaintedBy->update(RectGet().adjusted(-2, -2, 2, 2));
+        return;
+    }
     this->setStyleSheet(CreateStylesheet());
     mOptionsLabel->setStyleSheet(CreateOptionsLabelStylesheet());
     mRegionIdLabel->setStyleSheet(CreateRegionLabelStylesheet());
@@ -179,6 +198,11 @@ QString SudokuCellWidget::CreateRegionLabelStylesheet() const
     return style;
 }
 
+QRect SudokuCellWidget::RectGet() const
+{
+    return QRect(mCol * mLength, mRow * mLength, mLength, mLength);
+}
+
 SudokuCellWidget::CellEdge SudokuCellWidget::OppositeEdgeGet(CellEdge oppositeTo) const
 {
     switch (oppositeTo) {
@@ -230,6 +254,75 @@ const QSet<VariantClueWidget *> &SudokuCellWidget::VariantCluesGet() const
     return mVariantClues;
 }
 
+void SudokuCellWidget::PaintContent(QPainter& painter, bool focused) const
+{
+    // same colours as the stylesheets of the labels
+    static const QColor highlightBG(0, 255, 0, 51);
+    static const QColor focusBG(255, 200, 0, 51);
+
+    const QRect rect = RectGet();
+    if(focused)
+    {
+        painter.fillRect(rect, focusBG);
+    }
+    else if(mHighlighted)
+    {
+        painter.fillRect(rect, mCurrentView == CellView::RegionId ? highlightBG : focusBG);
+    }
+
+    const QString family = painter.font().family();
+    switch (mCurrentView)
+    {
+    case CellView::RegionId:
+        painter.setFont(QFont(family, mLength / 3, 700));
+        painter.setPen(Qt::GlobalColor::gray);
+        painter.drawText(rect, Qt::AlignCenter, mRegionId ? QString::number(mRegionId) : "-");
+        break;
+    case CellView::Value:
+        painter.setFont(QFont(family, mLength / 3, 500));
+        painter.setPen(Qt::GlobalColor::black);
+        painter.drawText(rect, Qt::AlignCenter, mValueString);
+        break;
+    default:
+    {
+        // the options hold rich text, for the hints in red
+        const int margin = mLength / 16;
+        QStaticText text(mContentString);
+        text.setTextFormat(Qt::RichText);
+        text.setTextOption(QTextOption(Qt::AlignCenter));
+        text.setTextWidth(rect.width() - 2 * margin);
+        painter.setFont(QFont(family, mIsSolved ? mLength / 3 : qMax(5, mLength / 7), mIsSolved ? 500 : -1));
+        painter.setPen(Qt::GlobalColor::gray);
+        text.prepare(painter.transform(), painter.font());
+        const int top = rect.top() + qMax(margin, (rect.height() - qRound(text.size().height())) / 2);
+        painter.setClipRect(rect);
+        painter.drawStaticText(rect.left() + margin, top, text);
+        painter.setClipping(false);
+        break;
+    }
+    }
+}
+
+void SudokuCellWidget::PaintEdges(QPainter& painter) const
+{
+    // as the stylesheet of the cell: the top and right edges, when there is a cell on the other side
+    const QRect rect = RectGet();
+    const int right = rect.left() + rect.width();
+    QPen pen(Qt::GlobalColor::black);
+    if(mNeighbours[0])
+    {
+        pen.setWidth(mBoldEdges & CellEdge::TopEdge ? 3 : 1);
+        painter.setPen(pen);
+        painter.drawLine(rect.left(), rect.top(), right, rect.top());
+    }
+    if(mNeighbours[1])
+    {
+        pen.setWidth(mBoldEdges & CellEdge::RightEdge ? 3 : 1);
+        painter.setPen(pen);
+        painter.drawLine(right, rect.top(), right, rect.top() + rect.height());
+    }
+}
+
 void SudokuCellWidget::SwitchView(size_t view)
 {
     switch (static_cast<MainWindowContent::ContextMenuType>(view))
@@ -247,14 +340,22 @@ void SudokuCellWidget::ShowRegionNumber(bool show)
 {
     if(show)
     {
-        mStackedContent->setCurrentIndex(CellView::RegionId);
+        mCurrentView = CellView::RegionId;
+    }
+    else
+    {
+        mCurrentView = mContentType == ContentType::CellOptions ?
+                       CellView::Options :
+                       CellView::Value;
+    }
+
+    if(mPaintedBy)
+    {
+        RefreshLayout();
     }
     else
     {
-        CellView view = mContentType == ContentType::CellOptions ?
-                        CellView::Options :
-                        CellView::Value;
-        mStackedContent->setCurrentIndex(view);
+        mStackedContent->setCurrentIndex(mCurrentView);
     }
 }
 
@@ -278,7 +379,10 @@ void SudokuCellWidget::UpdateRegionId(unsigned short newId)
 {
     if(newId != mRegionId)
     {
-        mRegionIdLabel->setText(newId ? QString::number(newId) : "-");
+        if(mRegionIdLabel)
+        {
+            mRegionIdLabel->setText(newId ? QString::number(newId) : "-");
+        }
         mRegionId = newId;
 
         int edge = 1;
@@ -303,34 +407,46 @@ void SudokuCellWidget::UpdateRegionId(unsigned short newId)
 
 void SudokuCellWidget::UpdateOptions(const std::set<unsigned short> &options, const std::set<unsigned short> &hints, bool isSolved)
 {
+    // candidates above 9 take two characters, so they are kept apart by spaces
+    // that also let the text wrap. The single digits are packed on two lines
+    const bool separated = mGridSize > 9;
     QString text = "";
     int lineBreak = 0;
-    for (const auto& opt : options)
+    const auto appendOption = [&](unsigned short opt)
     {
-        if(lineBreak == mGridSize/2)
+        if(separated && lineBreak > 0)
+        {
+            text += ' ';
+        }
+        else if(!separated && lineBreak == mGridSize/2)
         {
             text += QChar(0x200b);
         }
         text += QString::number(opt);
         lineBreak++;
+    };
+    for (const auto& opt : options)
+    {
+        appendOption(opt);
     }
     if(hints.size() > 0)
     {
         text += "<font style='color:red;'>";
         for (const auto& opt : hints)
         {
-            if(lineBreak == mGridSize/2)
-            {
-                text += QChar(0x200b);
-            }
-            text += QString::number(opt);
-            lineBreak++;
+            appendOption(opt);
         }
         text += "</font>";
     }
-    mOptionsLabel->setText(text);
     mIsSolved = (isSolved && hints.size() == 0);
-    mOptionsLabel->setFont(QFont(mValueLabel->font().family(),mIsSolved ? 20 : 8, mIsSolved ? 500 : -1));
+    if(mPaintedBy)
+    {
+        mContentString = text;
+        RefreshLayout();
+        return;
+    }
+    mOptionsLabel->setText(text);
+    mOptionsLabel->setFont(QFont(mValueLabel->font().family(),mIsSolved ? mLength / 3 : qMax(5, mLength / 7), mIsSolved ? 500 : -1));
 }
 
 void SudokuCellWidget::NeighboursSet(SudokuCellWidget *top, SudokuCellWidget *right, SudokuCellWidget *btm, SudokuCellWidget *left)
@@ -366,9 +482,14 @@ void SudokuCellWidget::SetGivenDigit(unsigned short value)
     mMainWindowContent->GridGet()->SolverGet()->AddGiven(value, mId);
     mMainWindowContent->GridGet()->SolverGet()->SubmitChangesToSolver();
 
-    mValueLabel->setText(QString::number(value));
+    mValueString = QString::number(value);
     mContentType = ContentType::GivenDigit;
-    mStackedContent->setCurrentIndex(CellView::Value);
+    mCurrentView = CellView::Value;
+    if(!mPaintedBy)
+    {
+        mValueLabel->setText(mValueString);
+        mStackedContent->setCurrentIndex(mCurrentView);
+    }
     RefreshLayout();
 }
 
@@ -377,9 +498,14 @@ void SudokuCellWidget::RemoveGivenDigit()
     mMainWindowContent->GridGet()->SolverGet()->RemoveGiven(mId);
     mMainWindowContent->GridGet()->SolverGet()->SubmitChangesToSolver();
 
-    mValueLabel->setText("");
+    mValueString = "";
     mContentType = ContentType::CellOptions;
-    mStackedContent->setCurrentIndex(CellView::Options);
+    mCurrentView = CellView::Options;
+    if(!mPaintedBy)
+    {
+        mValueLabel->setText(mValueString);
+        mStackedContent->setCurrentIndex(mCurrentView);
+    }
     RefreshLayout();
 }
 
@@ -11,13 +11,14 @@ class VariantClueWidget;
 class QLabel;
 class QStackedLayout;
 class QStackedWidget;
+class QPainter;
 
 class SudokuCellWidget : public QFrame
 {
     Q_OBJECT
 public:
     explicit SudokuCellWidget(unsigned short x, unsigned short y, unsigned short gridSize, int cellLength,
-                              MainWindowContent* mainWindowContent, QWidget *parent = nullptr);
+                              MainWindowContent* mainWindowContent, QWidget* paintedBy = nullptr, QWidget *parent = nullptr);
 
 private:
     enum ContentType
@@ -49,6 +50,7 @@ private:
     bool mIsSolved;
 
     MainWindowContent* mMainWindowContent;
+    QWidget* mPaintedBy;    // widget that paints the cell, if the cell has no child widgets (see LargeGridWidget)
     QList<SudokuCellWidget*> mNeighbours;
     QSet<VariantClueWidget*> mVariantClues;
 
@@ -60,7 +62,9 @@ private:
     QLabel* mGraphicsOverlay;
 
     QString mContentString;
+    QString mValueString;
     ContentType mContentType;
+    CellView mCurrentView;
 
     unsigned short mRegionId;
 
@@ -80,6 +84,7 @@ private:
     QString CreateOptionsLabelStylesheet() const;
     QString CreateValueLabelStylesheet() const;
     QString CreateRegionLabelStylesheet() const;
+    QRect RectGet() const;
 
     // private non-cont functions
     void RefreshLayout();
@@ -96,6 +101,8 @@ public:
     unsigned short RegionIdGet() const;
     const QList<SudokuCellWidget*>& NeighboursGet() const;
     const QSet<VariantClueWidget*>& VariantCluesGet() const;
+    void PaintContent(QPainter& painter, bool focused) const;
+    void PaintEdges(QPainter& painter) const;
 
     // public non-const functions
     void SwitchView(size_t view);
@@ -2,12 +2,13 @@
 #include "sudokucellwidget.h"
 #include "variantclueslayer.h"
 #include "mainwindowcontent.h"
+#include "largegridwidget.h"
 #include <QStackedLayout>
 #include <QPainter>
 
 SudokuGridWidget::SudokuGridWidget(unsigned short size, MainWindowContent* mainWindowContent, QWidget *parent)
     : QFrame{parent},
-      mCellLength(60),
+      mCellLength(size > 16 ? 32 : 60),   // keep the largest grids on screen
       mSize(size),
       mCells(),
       mMainWindowContent(mainWindowContent),
@@ -18,13 +19,21 @@ SudokuGridWidget::SudokuGridWidget(unsigned short size, MainWindowContent* mainW
     QStackedLayout* stackedLayout = new QStackedLayout(this);
     this->setLayout(stackedLayout);
     stackedLayout->setStackingMode(QStackedLayout::StackingMode::StackAll);
-    QWidget* grid = new QWidget();
+    // build grid: one widget per cell, except for the largest grids, which are painted
+    // as a whole by a single widget: their cells only keep the state the context menus work on
+    const bool painted = mSize > 16;
+    LargeGridWidget* paintedGrid = painted ? new LargeGridWidget(this, mMainWindowContent) : nullptr;
+    QWidget* grid = painted ? paintedGrid : new QWidget();
     stackedLayout->addWidget(grid);
     stackedLayout->addWidget(mVariantCluesLayer);
 
-    // build grid
-    QGridLayout* gridLayout = new QGridLayout();
-    grid->setLayout(gridLayout);
+    QGridLayout* gridLayout = painted ? nullptr : new QGridLayout();
+    if(gridLayout)
+    {
+        grid->setLayout(gridLayout);
+        gridLayout->setSpacing(0);
+        gridLayout->setContentsMargins(0, 0, 0, 0);
+    }
 
     mCells.reserve(mSize);
     for(unsigned short row = 0; row < mSize; ++row)
@@ -33,9 +42,12 @@ SudokuGridWidget::SudokuGridWidget(unsigned short size, MainWindowContent* mainW
         mCells.back().reserve(mSize);
         for(unsigned short col = 0; col < mSize; ++col)
         {
-            SudokuCellWidget* cell = new SudokuCellWidget(row, col, mSize, mCellLength, mMainWindowContent);
+            SudokuCellWidget* cell = new SudokuCellWidget(row, col, mSize, mCellLength, mMainWindowContent, paintedGrid);
             mCells.back().push_back(cell);
-            gridLayout->addWidget(cell, row, col);
+            if(gridLayout)
+            {
+                gridLayout->addWidget(cell, row, col);
+            }
         }
     }
     for(unsigned short i = 0; i < mCells.size(); ++i)
@@ -55,18 +67,27 @@ SudokuGridWidget::SudokuGridWidget(unsigned short size, MainWindowContent* mainW
     this->setFrameStyle(QFrame::Box);
     this->setLineWidth(3);
     this->setSizePolicy(QSizePolicy(QSizePolicy::Policy::Fixed,QSizePolicy::Policy::Fixed));
-    gridLayout->setSpacing(0);
-    gridLayout->setContentsMargins(0, 0, 0, 0);
     this->setStyleSheet("SudokuGridWidget{background-color: white;}");
 
     // Solver update event
     connect(mSolver.get(), &SudokuSolverThread::CellUpdated, this, &SudokuGridWidget::UpdateOptionsOfCell);
     connect(mSolver->BruteSolverGet(), &BruteForceSolverThread::CellUpdated, this, &SudokuGridWidget::SetCellValue);
+    connect(mSolver->TrueCandidatesFinderGet(), &TrueCandidatesThread::CellCandidatesFound, this, &SudokuGridWidget::UpdateOptionsOfCell);
     mSolver->Init();
+
+    // record the session for "--replay" when SUDOKU_SESSION_LOG names the file to save it to
+    if(qEnvironmentVariableIsSet("SUDOKU_SESSION_LOG"))
+    {
+        mSolver->SessionLogStart();
+    }
 }
 
 SudokuGridWidget::~SudokuGridWidget()
 {
+    if(mSolver->SessionLogGet())
+    {
+        mSolver->SessionLogEnd(qEnvironmentVariable("SUDOKU_SESSION_LOG").toStdString());
+    }
     delete mVariantCluesLayer;
     mVariantCluesLayer = nullptr;
 }
@@ -1,14 +1,22 @@
 #include "sudokusolverthread.h"
 #include "solver/GridProgressManager.h"
+#include "solver/PuzzleLoader.h"
+#include "solver/SolverKernels.h"
 #include "solver/SudokuCell.h"
-#include "solver/VariantConstraints.h"
+#include "solver/Trace.h"
+#include <QDeadlineTimer>
 #include <QDebug>
 
 SudokuSolverThread::SudokuSolverThread(unsigned short gridSize, QObject *parent)
     : QThread{parent},
       mGrid(nullptr),
       mPuzzleData(gridSize),
+      mSolverPuzzleData(gridSize),
+      mInputQueue(),
+      mSessionLog(nullptr),
       mBruteForceSolver(std::make_unique<BruteForceSolverThread>(this)),
+      mUniquenessMonitor(std::make_unique<UniquenessMonitorThread>(this)),
+      mTrueCandidatesFinder(std::make_unique<TrueCandidatesThread>(this)),
       mGivensToAdd(),
       mHintsToAdd(),
       mRegionsToAdd(),
@@ -20,38 +28,44 @@ SudokuSolverThread::SudokuSolverThread(unsigned short gridSize, QObject *parent)
       mAbort(false),
       mPaused(false),
       mStep(false),
+      mIdle(true),
+      mSchedulingMode(SchedulingMode::FixedOrder),
       mInputMutex(),
       mSolverMutex(),
-      mThreadCondition()
+      mThreadCondition(),
+      mIdleCondition()
 {
 }
 
 SudokuSolverThread::~SudokuSolverThread()
 {
-    mInputMutex.lock();
+    // same locking order as the solver thread, which notifies its observers under the input mutex
     mSolverMutex.lock();
+    mInputMutex.lock();
     mAbort = true;
     mThreadCondition.wakeOne();
-    mSolverMutex.unlock();
     mInputMutex.unlock();
+    mSolverMutex.unlock();
     wait();
 }
 
-void SudokuSolverThread::Init()
+void SudokuSolverThread::Init(bool persistentCache /* = true */)
 {
-    mGrid = std::make_unique<SudokuGrid>(mPuzzleData.mSize, this);
+    // the solver core is compiled for the common grid sizes: pick the instance for this one
+    mGrid = std::make_unique<SudokuGrid>(mPuzzleData.mSize, this, SolverKernelsGet(mPuzzleData.mSize));
     mGrid->ProgressManagerGet()->TechniqueActiveSet(TechniqueType::Fish, false);
-    mBruteForceSolver->Init(mGrid.get(), &mSolverMutex);
+    mBruteForceSolver->Init(mGrid.get(), &mSolverMutex, persistentCache);
 }
 
 void SudokuSolverThread::run()
 {
+    SUDOKU_TRACE_SCOPE("SudokuSolverThread::run");
     GridProgressManager* progressManager = mGrid->ProgressManagerGet();
     forever
     {
         // collect input
-        mInputMutex.lock();
-        const PuzzleData puzzleData = mPuzzleData;
+        const bool newInput = ProcessInputCommands();
+        const PuzzleData& puzzleData = mSolverPuzzleData;
         std::set<CellCoord> newGivens;
         std::set<CellCoord> newHints;
         std::set<unsigned short> newRegions;
@@ -60,17 +74,16 @@ void SudokuSolverThread::run()
         const bool negativeDiagonal = mAddNegativeDiagonal;
         const bool reloadGrid = mReloadGrid;
         const bool reloadCells = mReloadCells;
-        const bool newInput = mNewInput;
 
         if(!reloadCells)
         {
-            newGivens = mGivensToAdd;
-            newHints = mHintsToAdd;
+            newGivens = std::move(mGivensToAdd);
+            newHints = std::move(mHintsToAdd);
         }
         if(!reloadGrid)
         {
-            newRegions = mRegionsToAdd;
-            newKillers = mKillersToAdd;
+            newRegions = std::move(mRegionsToAdd);
+            newKillers = std::move(mKillersToAdd);
         }
 
         mGivensToAdd.clear();
@@ -81,13 +94,11 @@ void SudokuSolverThread::run()
         mAddPositiveDiagonal = false;
         mReloadGrid = false;
         mReloadCells = false;
-        mNewInput = false;
-        mInputMutex.unlock();
 
         if(newInput)
         {
             QMutexLocker locker(&mSolverMutex);
-            mBruteForceSolver->NotifyGridChanged();
+            mBruteForceSolver->NotifyGridChanged(puzzleData);
             mBruteForceSolver->AbortCalculation();
 
             // Clear grid contents if necessary
@@ -102,14 +113,14 @@ void SudokuSolverThread::run()
                 emit SolverHasBeenReset();
             }
 
-            const unsigned short gridSize = puzzleData.mSize;
+            const PuzzleLoader loader(*mGrid, puzzleData);
 
             // define givens
             for (const auto& given : puzzleData.mGivens)
             {
                 if(reloadCells || newGivens.count(given.first))
                 {
-                    mGrid->AddGivenCell(given.first / gridSize, given.first % gridSize, given.second);
+                    loader.LoadGiven(given.first);
                 }
             }
 
@@ -118,27 +129,16 @@ void SudokuSolverThread::run()
             {
                 if(reloadCells || newHints.count(hints.first))
                 {
-                    mGrid->SetCellEliminationHints(hints.first / gridSize, hints.first % gridSize, hints.second);
+                    loader.LoadHints(hints.first);
                 }
             }
 
             // define regions
             for (size_t i = 0; i < puzzleData.mRegions.size(); ++i)
             {
-                const auto& region = puzzleData.mRegions.at(i);
-                if(region.size() == 0) continue;
-
                 if(reloadGrid || newRegions.count(i))
                 {
-                    std::vector<std::array<unsigned short, 2>> cells;
-                    cells.reserve(region.size());
-                    const auto pred = [&](const CellCoord &id) -> std::array<unsigned short, 2>
-                    {
-                        return {static_cast<unsigned short>(id / gridSize),
-                                static_cast<unsigned short>(id % gridSize)};
-                    };
-                    std::transform(region.begin(), region.end(), std::back_inserter(cells), pred);
-                    mGrid->DefineRegion(cells, cells.size() == gridSize ? RegionType::House_Region : RegionType::Generic_region, nullptr, "region " + std::to_string(i+1));
+                    loader.LoadRegion(i);
                 }
             }
 
@@ -147,19 +147,7 @@ void SudokuSolverThread::run()
             {
                 if(reloadGrid || newKillers.count(killer.first))
                 {
-                    unsigned int killerSum = killer.second.first;
-                    const auto& killerCells = killer.second.second;
-                    std::vector<std::array<unsigned short, 2>> cells;
-                    cells.reserve(killerCells.size());
-                    const auto pred = [&](const CellCoord &id) -> std::array<unsigned short, 2>
-                    {
-                        return {static_cast<unsigned short>(id / gridSize),
-                                static_cast<unsigned short>(id % gridSize)};
-                    };
-                    std::transform(killerCells.begin(), killerCells.end(), std::back_inserter(cells), pred);
-                    auto firstCell = pred(killer.first);
-                    mGrid->DefineRegion(cells, RegionType::KillerCage, new KillerConstraint(killerSum),
-                                        "the " + std::to_string(killerSum) + " cage at r" + std::to_string(firstCell[0] + 1) + "c" + std::to_string(firstCell[1] + 1));
+                    loader.LoadKillerCage(killer.first);
                 }
             }
 
@@ -167,16 +155,14 @@ void SudokuSolverThread::run()
             if((reloadGrid && puzzleData.mNegativeDiagonal) ||
                (!reloadGrid && negativeDiagonal))
             {
-                std::vector<std::array<unsigned short, 2>> cells = DiagonalCellsGet(gridSize, PuzzleData::Diagonal_Negative);
-                mGrid->DefineRegion(cells, RegionType::House_Region, nullptr, "negative diagonal");
+                loader.LoadDiagonal(PuzzleData::Diagonal_Negative);
             }
 
             // define positive diagonal
             if((reloadGrid && puzzleData.mPositiveDiagonal) ||
                (!reloadGrid && positiveDiagonal))
             {
-                std::vector<std::array<unsigned short, 2>> cells = DiagonalCellsGet(gridSize, PuzzleData::Diagonal_Positive);
-                mGrid->DefineRegion(cells, RegionType::House_Region, nullptr, "positive diagonal");
+                loader.LoadDiagonal(PuzzleData::Diagonal_Positive);
             }
         }
 
@@ -193,9 +179,21 @@ void SudokuSolverThread::run()
             {
                 QMutexLocker locked(&mInputMutex);
                 mAbort = false;
+                mIdle = true;
+                mIdleCondition.wakeAll();
                 return;
             }
-            progressManager->NextStep();
+            if(mStep)
+            {
+                // single steps are explained to the user: keep them reproducible
+                progressManager->SchedulingModeSet(SchedulingMode::FixedOrder);
+                progressManager->NextStep();
+            }
+            else
+            {
+                progressManager->SchedulingModeSet(mSchedulingMode.load(std::memory_order_relaxed));
+                progressManager->NextBatch();
+            }
         }
         mGrid->ProgressManagerGet()->TechniqueActiveSet(TechniqueType::Fish, false);
         emit CalculationFinished();
@@ -207,12 +205,18 @@ void SudokuSolverThread::run()
         if(mAbort)
         {
             mAbort = false;
+            mIdle = true;
+            mIdleCondition.wakeAll();
+            mInputMutex.unlock();
             return;
         }
         if(!mNewInput)
         {
             // pause this thread while there is nothing to do
+            mIdle = true;
+            mIdleCondition.wakeAll();
             mThreadCondition.wait(&mInputMutex);
+            mIdle = false;
         }
         else if(mStep)
         {
@@ -281,34 +285,79 @@ void SudokuSolverThread::ReloadGrid()
     mReloadCells = true;
 }
 
-std::vector<std::array<unsigned short, 2>> SudokuSolverThread::DiagonalCellsGet(unsigned short gridSize, PuzzleData::Diagonal diagonal) const
+void SudokuSolverThread::PostCommand(SolverCommand &&command)
 {
-    std::vector<std::array<unsigned short, 2>> cells;
-    cells.reserve(gridSize);
-
-    if(diagonal == PuzzleData::Diagonal_Negative)
+    // the UI copy of the puzzle is updated straight away, so that it can be queried
+    // without waiting for the solver. The solver replays the command on its own copy.
+    if(command.ApplyTo(mPuzzleData) != SolverCommand::Effect_None)
     {
-        for (unsigned short i = 0; i < gridSize; ++i)
+        if(mSessionLog)
         {
-            cells.push_back({i, i});
+            mSessionLog->RecordCommand(command);
         }
+        mInputQueue.Push(std::move(command));
     }
-    else if(diagonal == PuzzleData::Diagonal_Positive)
+}
+
+bool SudokuSolverThread::ProcessInputCommands()
+{
+    // clear the flag before draining: a command posted from now on sets it again
+    bool newInput = mNewInput.exchange(false);
+
+    SolverCommand command;
+    while (mInputQueue.Pop(command))
     {
-        for (unsigned short i = 0; i < gridSize; ++i)
+        newInput = true;
+        switch (command.ApplyTo(mSolverPuzzleData))
         {
-            cells.push_back({i, static_cast<unsigned short>(gridSize - 1 - i)});
+        case SolverCommand::Effect_Incremental:
+            switch (command.mType)
+            {
+            case SolverCommand::Command_AddGiven:
+                AddGivenValueToSubmissionQueue(command.mId);
+                break;
+            case SolverCommand::Command_AddHint:
+                AddHintToSubmissionQueue(command.mId);
+                break;
+            case SolverCommand::Command_SetRegion:
+                AddRegionToSubmissionQueue(command.mId);
+                break;
+            case SolverCommand::Command_AddKillerCage:
+                AddKillerToSubmissionQueue(command.mId);
+                break;
+            case SolverCommand::Command_SetDiagonal:
+                AddDiagonalToSubmissionQueue(static_cast<PuzzleData::Diagonal>(command.mId));
+                break;
+            default:
+                break;
+            }
+            break;
+        case SolverCommand::Effect_ReloadCells:
+            ReloadCells();
+            break;
+        case SolverCommand::Effect_ReloadGrid:
+            ReloadGrid();
+            break;
+        default:
+            break;
         }
     }
-
-    return cells;
+    return newInput;
 }
 
 void SudokuSolverThread::SubmitChangesToSolver()
 {
-    QMutexLocker locker(&mInputMutex);
-
     mNewInput = true;
+    mUniquenessMonitor->CheckPuzzle(mPuzzleData);
+    mTrueCandidatesFinder->AbortCalculation();
+    if(mSessionLog)
+    {
+        mSessionLog->RecordSubmit();
+    }
+
+    // the solver only holds the input mutex to check its flags or to go to sleep
+    QMutexLocker locker(&mInputMutex);
+    mIdle = false;
     if (!isRunning())
     {
         start(HighestPriority);
@@ -352,9 +401,18 @@ BruteForceSolverThread *SudokuSolverThread::BruteSolverGet() const
     return mBruteForceSolver.get();
 }
 
-PuzzleData SudokuSolverThread::PuzzleDataGet()
+UniquenessMonitorThread *SudokuSolverThread::UniquenessMonitorGet() const
+{
+    return mUniquenessMonitor.get();
+}
+
+TrueCandidatesThread *SudokuSolverThread::TrueCandidatesFinderGet() const
+{
+    return mTrueCandidatesFinder.get();
+}
+
+PuzzleData SudokuSolverThread::PuzzleDataGet() const
 {
-    QMutexLocker locker(&mInputMutex);
     return mPuzzleData;
 }
 
@@ -363,10 +421,15 @@ void SudokuSolverThread::SetLogicalSolverPaused(bool paused)
     QMutexLocker locker(&mInputMutex);
     if(mPaused != paused)
     {
+        if(mSessionLog)
+        {
+            mSessionLog->RecordSetPaused(paused);
+        }
         mPaused = paused;
         mStep = false;
         if(!mPaused)
         {
+            mIdle = false;
             if (!isRunning())
             {
                 start(HighestPriority);
@@ -384,8 +447,13 @@ void SudokuSolverThread::TakeStep()
     QMutexLocker locker(&mInputMutex);
     if (mPaused)
     {
+        if(mSessionLog)
+        {
+            mSessionLog->RecordTakeStep();
+        }
         mStep = true;
         mPaused = false;
+        mIdle = false;
         mGrid->ProgressManagerGet()->TechniqueActiveSet(TechniqueType::Fish, true);
         if (!isRunning())
         {
@@ -400,9 +468,16 @@ void SudokuSolverThread::TakeStep()
 
 void SudokuSolverThread::ResetSolver()
 {
-    QMutexLocker locker(&mInputMutex);
-    ReloadGrid();
+    SolverCommand command(SolverCommand::Command_ResetSolver);
+    if(mSessionLog)
+    {
+        mSessionLog->RecordCommand(command);
+    }
+    mInputQueue.Push(std::move(command));
     mNewInput = true;
+
+    QMutexLocker locker(&mInputMutex);
+    mIdle = false;
     if(mStep)
     {
         mStep = false;
@@ -417,3 +492,64 @@ void SudokuSolverThread::ResetSolver()
         mThreadCondition.wakeOne();
     }
 }
+
+void SudokuSolverThread::SchedulingModeSet(SchedulingMode mode)
+{
+    // only the UI thread writes the mode: the solver picks it up before its next batch,
+    // without the UI waiting for the solver mutex
+    const SchedulingMode previous = mSchedulingMode.exchange(mode, std::memory_order_relaxed);
+    if(previous != mode && mSessionLog)
+    {
+        mSessionLog->RecordSchedulingMode(static_cast<unsigned int>(mode));
+    }
+}
+
+void SudokuSolverThread::ReplayCommand(const SolverCommand &command)
+{
+    if(command.mType == SolverCommand::Command_ResetSolver)
+    {
+        ResetSolver();
+    }
+    else
+    {
+        PostCommand(SolverCommand(command));
+    }
+}
+
+bool SudokuSolverThread::WaitUntilIdle(unsigned long timeout /* = ULONG_MAX */)
+{
+    const QDeadlineTimer deadline = timeout == ULONG_MAX ? QDeadlineTimer(QDeadlineTimer::Forever)
+                                                         : QDeadlineTimer(static_cast<qint64>(timeout));
+    QMutexLocker locker(&mInputMutex);
+    while(!mIdle)
+    {
+        if(!mIdleCondition.wait(&mInputMutex, deadline))
+        {
+            return mIdle;
+        }
+    }
+    return true;
+}
+
+void SudokuSolverThread::SessionLogStart()
+{
+    mSessionLog = std::make_unique<SessionLog>(mPuzzleData.mSize);
+    mBruteForceSolver->SessionLogSet(mSessionLog.get());
+    // replays start in the fixed order, like the solver
+    const SchedulingMode mode = mSchedulingMode.load(std::memory_order_relaxed);
+    if(mode != SchedulingMode::FixedOrder)
+    {
+        mSessionLog->RecordSchedulingMode(static_cast<unsigned int>(mode));
+    }
+}
+
+bool SudokuSolverThread::SessionLogEnd(const std::string &filepath)
+{
+    mSessionLog->RecordEnd();
+    return mSessionLog->Save(filepath);
+}
+
+const SessionLog *SudokuSolverThread::SessionLogGet() const
+{
+    return mSessionLog.get();
+}
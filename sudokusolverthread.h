@@ -4,20 +4,29 @@
 #include <QThread>
 #include <QMutex>
 #include <QWaitCondition>
+#include <atomic>
+#include <climits>
 #include "puzzledata.h"
+#include "solvercommand.h"
+#include "IO/SessionLog.h"
+#include "spscqueue.h"
+#include "solver/GridProgressManager.h"
 #include "solver/SudokuGrid.h"
+#include "solver/SolverObserver.h"
 #include "bruteforcesolverthread.h"
+#include "truecandidatesthread.h"
+#include "uniquenessmonitorthread.h"
 
 class SudokuCell;
 
-class SudokuSolverThread : public QThread
+class SudokuSolverThread : public QThread, public SolverObserver
 {
     Q_OBJECT
 public:
     explicit SudokuSolverThread(unsigned short gridSize, QObject *parent = nullptr);
     ~SudokuSolverThread();
 
-    void Init();
+    void Init(bool persistentCache = true);
 
 signals:
     void CellUpdated(unsigned int id, const std::set<unsigned short>& content, bool isSolved);
@@ -32,9 +41,15 @@ protected:
 
 private:
     std::unique_ptr<SudokuGrid> mGrid;
-    PuzzleData mPuzzleData;
+    PuzzleData mPuzzleData;                     // edited by the UI thread
+    PuzzleData mSolverPuzzleData;               // solver thread copy, kept in sync by mInputQueue
+    SpscQueue<SolverCommand> mInputQueue;       // edits posted by the UI thread
+    std::unique_ptr<SessionLog> mSessionLog;    // inputs recorded for replay, if enabled
     std::unique_ptr<BruteForceSolverThread> mBruteForceSolver;
+    std::unique_ptr<UniquenessMonitorThread> mUniquenessMonitor;
+    std::unique_ptr<TrueCandidatesThread> mTrueCandidatesFinder;
 
+    // the following are only accessed by the solver thread
     std::set<CellCoord> mGivensToAdd;
     std::set<CellCoord> mHintsToAdd;
     std::set<unsigned short> mRegionsToAdd;
@@ -44,14 +59,18 @@ private:
 
     bool mReloadCells;
     bool mReloadGrid;
-    bool mNewInput;
+
+    std::atomic<bool> mNewInput;
     bool mAbort;
     bool mPaused;
     bool mStep;
+    bool mIdle;                                 // waiting for input, or not started yet
+    std::atomic<SchedulingMode> mSchedulingMode;    // of the solving runs, single steps always use the fixed order
 
     QMutex mInputMutex;
     QMutex mSolverMutex;
     QWaitCondition mThreadCondition;
+    QWaitCondition mIdleCondition;
 
     void AddGivenValueToSubmissionQueue(CellCoord cell);
     void AddHintToSubmissionQueue(CellCoord cell);
@@ -60,8 +79,8 @@ private:
     void AddDiagonalToSubmissionQueue(PuzzleData::Diagonal diagonal);
     void ReloadCells();
     void ReloadGrid();
-
-    std::vector<std::array<unsigned short, 2>> DiagonalCellsGet(unsigned short gridSize, PuzzleData::Diagonal diagonal) const;
+    void PostCommand(SolverCommand&& command);
+    bool ProcessInputCommands();
 public:
     bool HasPositiveDiagonalConstraint() const;
     bool HasNegativeDiagonalConstraint() const;
@@ -81,15 +100,41 @@ public:
     void RemoveAllHints();
 
     void SubmitChangesToSolver();
-    void NotifyCellChanged(SudokuCell* cell, bool isSolved);
-    void NotifyImpossiblePuzzle(std::string message);
-    void NotifyLogicalDeduction(std::string message);
+    void NotifyCellChanged(SudokuCell* cell, bool isSolved) override;
+    void NotifyImpossiblePuzzle(std::string message) override;
+    void NotifyLogicalDeduction(std::string message) override;
     void SetLogicalSolverPaused(bool paused);
     void TakeStep();
     void ResetSolver();
+    /// <summary>
+    /// Adaptive scheduling solves faster, but the order of the deductions
+    /// and their explanations may change from one run to the next
+    /// </summary>
+    void SchedulingModeSet(SchedulingMode mode);
+
+    /// <summary>
+    /// Post an edit recorded in a session log, as the UI would have done
+    /// </summary>
+    void ReplayCommand(const SolverCommand& command);
+    /// <summary>
+    /// Block until the logical solver has processed all its input and is waiting for more,
+    /// or until the timeout in milliseconds. Returns false on timeout.
+    /// </summary>
+    bool WaitUntilIdle(unsigned long timeout = ULONG_MAX);
+    /// <summary>
+    /// Record the following inputs of the solvers in a session log
+    /// </summary>
+    void SessionLogStart();
+    /// <summary>
+    /// Mark the end of the recorded session and save the log. Returns false if the file could not be written
+    /// </summary>
+    bool SessionLogEnd(const std::string& filepath);
+    const SessionLog* SessionLogGet() const;
 
     BruteForceSolverThread* BruteSolverGet() const;
-    PuzzleData PuzzleDataGet();
+    UniquenessMonitorThread* UniquenessMonitorGet() const;
+    TrueCandidatesThread* TrueCandidatesFinderGet() const;
+    PuzzleData PuzzleDataGet() const;
 };
 
 #endif // SUDOKUSOLVERTHREAD_H
@@ -29,7 +29,7 @@ namespace dancing_links_GJK
 
 
 
-void Exact_Cover_Solver(LMatrix& M, std::list<S_Stack>& foundSolutions, const size_t maxSolutionsCount, const bool* abort)
+void Exact_Cover_Solver(LMatrix& M, std::list<S_Stack>& foundSolutions, const size_t maxSolutionsCount, const std::atomic<bool>* abort)
 {
     H_Stack history;
     std::vector<size_t> solution;
@@ -48,7 +48,7 @@ void Exact_Cover_Solver(LMatrix& M, std::list<S_Stack>& foundSolutions)
 
 
 
-void DLX(LMatrix& M, S_Stack& solution, H_Stack& history, std::list<S_Stack>& foundSolutions, const size_t maxSolutionsCount, const bool* abort)
+void DLX(LMatrix& M, S_Stack& solution, H_Stack& history, std::list<S_Stack>& foundSolutions, const size_t maxSolutionsCount, const std::atomic<bool>* abort)
 {
     Column *c = choose_column(M);
     // 'M' is empty => solution successfully found
@@ -84,24 +84,73 @@ void DLX(LMatrix& M, S_Stack& solution, H_Stack& history, std::list<S_Stack>& fo
 
 
 
-/* Given a matrix of linked nodes M, return a pointer to the column with the fewest nodes
- * If there are no columns, return NULL
- */
-Column* choose_column(LMatrix& M)
+Exact_Cover_Search::Exact_Cover_Search(LMatrix& M) : M(M), descending(true), finished(false)
 {
-    if( M.is_trivial() ) return NULL;
+    partial_solution.reserve(M.number_of_rows());
+}
 
-    Column* col = static_cast<Column*>(M.head()->right());
-    Column* max_col = col;
+Exact_Cover_Search::~Exact_Cover_Search()
+{
+    // undo the branches still applied, so that the matrix is left as it was found
+    while( !branches.empty() ) {
+        downdate(M, partial_solution, history);
+        branches.pop_back();
+    }
+}
 
-    while( col != M.head() )
-    {
-        if( col->size() < max_col->size() ) {
-            max_col = col;
+bool Exact_Cover_Search::next(S_Stack& solution, const std::atomic<bool>* abort)
+{
+    while( !finished ) {
+        if( abort && *abort ) {
+            return false;
+        }
+        if( descending ) {
+            Column *c = choose_column(M);
+            // 'M' is empty => solution successfully found, the next call will backtrack from here
+            if( c == NULL ) {
+                descending = false;
+                solution = partial_solution;
+                return true;
+            }
+            // a column that cannot be covered is a dead end
+            if( c->size() == 0 ) {
+                descending = false;
+                continue;
+            }
+            MNode *r = c->down();
+            update(M, partial_solution, history, r);
+            branches.push_back({c, r});
+        } else {
+            if( branches.empty() ) {
+                finished = true;
+                break;
+            }
+            // try the next row of the last column, or go back up a level
+            Branch& b = branches.back();
+            downdate(M, partial_solution, history);
+            b.row = b.row->down();
+            if( b.row == static_cast<MNode*>(b.column) ) {
+                branches.pop_back();
+            } else {
+                update(M, partial_solution, history, b.row);
+                descending = true;
+            }
         }
-        col = static_cast<Column*>(col->right());
     }
-    return max_col;
+    return false;
+}
+
+bool Exact_Cover_Search::is_finished() const
+{
+    return finished;
+}
+
+/* Given a matrix of linked nodes M, return a pointer to the column with the fewest nodes
+ * If there are no columns, return NULL
+ */
+Column* choose_column(LMatrix& M)
+{
+    return M.smallest_column();
 }
 
 /*
@@ -153,7 +202,7 @@ void downdate(LMatrix& M, S_Stack& solution, H_Stack& history)
         return;
     }
     solution.pop_back();
-    RC_Stack last = history.top();
+    RC_Stack& last = history.top();
     RC_Item it;
     while( !last.empty() ) {
         it = last.top();
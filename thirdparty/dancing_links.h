@@ -19,6 +19,7 @@
 #define DANCING_LINKS_H
 
 #include "linked_matrix.h"
+#include <atomic>
 #include <vector>
 #include <stack>
 #include <list>
@@ -58,11 +59,47 @@ typedef std::stack<RC_Item> RC_Stack;
  */
 typedef std::stack<RC_Stack> H_Stack;
 
+/**
+ * \brief Depth first search of \ref DLX() driven by an explicit stack instead of recursion, so that it can be
+ *        suspended after each solution (or when aborted) and resumed later exactly where it stopped.
+ *
+ * The matrix is modified while the search is suspended, and restored when the search is destroyed.
+ * It must outlive the search and must not be used by anything else in the meantime.
+ */
+class Exact_Cover_Search
+{
+public:
+    explicit Exact_Cover_Search(LMatrix& M);
+    ~Exact_Cover_Search();
+    Exact_Cover_Search(const Exact_Cover_Search&) = delete;
+    Exact_Cover_Search& operator=(const Exact_Cover_Search&) = delete;
+    /**
+     * @brief Continues the search up to the next solution.
+     * @param solution At termination, holds the row indices of the solution if one is found.
+     * @param abort Checked at every step, the search is suspended when it is set.
+     * @return true if a solution has been found, false if the search is over or has been aborted.
+     */
+    bool next(S_Stack& solution, const std::atomic<bool>* abort);
+    bool is_finished() const; //!< \return true if all the solutions have been found.
+private:
+    //! A level of the search: the column being covered and the row currently tried for it.
+    struct Branch {
+        Column* column;
+        MNode* row;
+    };
+    LMatrix& M;
+    S_Stack partial_solution;
+    H_Stack history;
+    std::vector<Branch> branches;
+    bool descending;    // whether the next step picks a new column, rather than trying the next row of the last one
+    bool finished;
+};
+
 /**
  * @brief Like \ref dancing_links_GJK#Exact_Cover_Solver(bool**,int,int) but without the initial conversion
  * step.
  */
-void Exact_Cover_Solver(LMatrix& M, std::list<S_Stack>& foundSolutions, const size_t maxSolutionsCount, const bool* abort);
+void Exact_Cover_Solver(LMatrix& M, std::list<S_Stack>& foundSolutions, const size_t maxSolutionsCount, const std::atomic<bool>* abort);
 void Exact_Cover_Solver(LMatrix& M, std::list<S_Stack>& foundSolutions);
 
 /**
@@ -90,7 +127,7 @@ void Exact_Cover_Solver(LMatrix& M, std::list<S_Stack>& foundSolutions);
              delete column j from matrix A.
          Repeat this algorithm recursively on the reduced matrix A
  */
-void DLX(LMatrix& M, S_Stack& solution, H_Stack& history, std::list<S_Stack>& foundSolutions, const size_t maxSolutionsCount, const bool* abort);
+void DLX(LMatrix& M, S_Stack& solution, H_Stack& history, std::list<S_Stack>& foundSolutions, const size_t maxSolutionsCount, const std::atomic<bool>* abort);
 void DLX(LMatrix& M, S_Stack& solution, H_Stack& history, std::list<S_Stack>& foundSolutions);
 
 
@@ -27,14 +27,14 @@ namespace linked_matrix_GJK
  * implementation of class LMatrix
  */
 
-LMatrix::LMatrix(void) : root( new MNode( MData() ) )
+LMatrix::LMatrix(void) : root( new MNode( MData() ) ), min_bucket(0)
 {
     // make root->down_link constant somehow
     join_lr(root, root);
     row_count = 0;
 }
 
-LMatrix::LMatrix(bool **matrix, int m, int n) : root( new MNode( MData() ) )
+LMatrix::LMatrix(bool **matrix, int m, int n) : root( new MNode( MData() ) ), min_bucket(0)
 {
     if( m == 0 || n == 0 ) {
         row_count = 0;
@@ -125,6 +125,116 @@ LMatrix::LMatrix(bool **matrix, int m, int n) : root( new MNode( MData() ) )
     }
     delete[] ptr_matrix;
 
+    init_buckets(std::vector<bool>(n, true));
+}
+
+LMatrix::LMatrix(const std::vector<std::vector<int>>& rows, int n) : LMatrix(rows, n, std::vector<bool>(n, true))
+{
+}
+
+LMatrix::LMatrix(const std::vector<std::vector<int>>& rows, int n, const std::vector<bool>& primary) : root( new MNode( MData() ) ), min_bucket(0)
+{
+    row_count = 0;
+    if( n == 0 ) {
+        join_lr(root, root);
+        return;
+    }
+    // create column header objects
+    std::vector<MNode*> columns(n);
+    std::vector<MNode*> last(n);    // lowest node of each column so far
+    MNode *c = root;
+    for(int j = 0; j < n; j++) {
+        columns[j] = new Column(0);
+        last[j] = columns[j];
+        join_lr(c, columns[j]);
+        c = columns[j];
+    }
+    join_lr(c, root);
+
+    // create the nodes row by row, linking them vertically below the previous ones
+    // and horizontally to the previous node in the same row
+    for(int i = 0; i < static_cast<int>(rows.size()); i++) {
+        MNode *first = NULL, *prev = NULL;
+        for(int j : rows[i]) {
+            MNode *node = new MNode(MData(i, static_cast<Column*>(columns[j])));
+            join_du(node, last[j]);
+            last[j] = node;
+            (static_cast<Column *>(columns[j]))->add_to_size(1);
+            if( first == NULL ) {
+                first = node;
+            } else {
+                join_lr(prev, node);
+            }
+            prev = node;
+        }
+        if( first != NULL ) {
+            join_lr(prev, first);
+            row_count = i + 1;
+        }
+    }
+
+    // close the columns
+    for(int j = 0; j < n; j++) {
+        join_du(columns[j], last[j]);
+    }
+
+    init_buckets(primary);
+}
+
+void LMatrix::init_buckets(const std::vector<bool>& primary)
+{
+    int max_size = 0;
+    size_t j = 0;
+    for(MNode *node = root->right(); node != root; node = node->right(), j++) {
+        Column *c = static_cast<Column*>(node);
+        c->_primary = j < primary.size() && primary[j];
+        if(c->size() > max_size) max_size = c->size();
+    }
+    // column sizes never grow past their initial value
+    bucket_first.assign(2 * (max_size + 1), NULL);
+    min_bucket = 0;
+    for(MNode *node = root->right(); node != root; node = node->right()) {
+        bucket_insert(static_cast<Column*>(node));
+    }
+}
+
+int LMatrix::bucket_index(const Column *c)
+{
+    // the primary columns of each size come before the other ones
+    return 2 * c->size() + (c->_primary ? 0 : 1);
+}
+
+void LMatrix::bucket_insert(Column *c)
+{
+    const int b = bucket_index(c);
+    c->_bucket_prev = NULL;
+    c->_bucket_next = bucket_first[b];
+    if(bucket_first[b]) bucket_first[b]->_bucket_prev = c;
+    bucket_first[b] = c;
+    c->_in_bucket = true;
+    if(b < min_bucket) min_bucket = b;
+}
+
+void LMatrix::bucket_erase(Column *c)
+{
+    if(!c->_in_bucket) return;
+    const int b = bucket_index(c);
+    if(c->_bucket_prev) c->_bucket_prev->_bucket_next = c->_bucket_next;
+    else bucket_first[b] = c->_bucket_next;
+    if(c->_bucket_next) c->_bucket_next->_bucket_prev = c->_bucket_prev;
+    c->_in_bucket = false;
+}
+
+void LMatrix::resize_column(Column *c, int N)
+{
+    // columns already removed from the matrix are not in any bucket
+    if(c->_in_bucket) {
+        bucket_erase(c);
+        c->add_to_size(N);
+        bucket_insert(c);
+    } else {
+        c->add_to_size(N);
+    }
 }
 
 MNode* LMatrix::head() const
@@ -137,6 +247,14 @@ bool LMatrix::is_trivial() const
     return root->right() == root && root->left() == root;
 }
 
+Column* LMatrix::smallest_column()
+{
+    while(min_bucket < static_cast<int>(bucket_first.size()) && bucket_first[min_bucket] == NULL) {
+        min_bucket++;
+    }
+    return min_bucket < static_cast<int>(bucket_first.size()) ? bucket_first[min_bucket] : NULL;
+}
+
 int LMatrix::number_of_rows() const
 {
     int num = 0;
@@ -153,7 +271,7 @@ void LMatrix::remove_row(MNode * node)
     MNode *k = node;
     do {
         join_du( k->down(), k->up() );
-        k->data().column_id->add_to_size(-1);
+        resize_column(k->data().column_id, -1);
         k = k->right();
     } while( k != node ); // stop when we're back where we started
 }
@@ -166,7 +284,7 @@ void LMatrix::restore_row(MNode * node)
     do {
         k->up()->set_down(k);  // connect row back
         k->down()->set_up(k);  // into the matrix
-        k->data().column_id->add_to_size(1);
+        resize_column(k->data().column_id, 1);
         k = k->left();
     } while( k != node );
 }
@@ -177,6 +295,7 @@ void LMatrix::restore_row(MNode * node)
 void LMatrix::remove_column(MNode * node)
 {
     if(node == NULL || node == root ) return;
+    bucket_erase(node->data().column_id);
     MNode *k = node;
     do {
         join_lr( k->left(), k->right() );
@@ -193,6 +312,7 @@ void LMatrix::restore_column(MNode * node)
         k->left()->set_right(k);
         k = k->down();
     } while( k != node );
+    bucket_insert(node->data().column_id);
 }
 
 
@@ -211,7 +331,7 @@ LMatrix::~LMatrix()
         }
         del = a;
         a = a->right();
-        delete del;
+        delete static_cast<Column*>(del);
     }
     delete root;
 }
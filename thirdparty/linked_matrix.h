@@ -19,6 +19,7 @@
 #define LINKED_MATRIX_H
 
 #include <iostream>
+#include <vector>
 
 /** \file linked_matrix.h
  *  \brief Definition of classes \ref linked_matrix_GJK::LMatrix "LMatrix",
@@ -84,9 +85,31 @@ public:
      * @param n The number of columns in @p matrix.
      */
     LMatrix(bool **matrix, int m, int n);
+    /**
+     * @brief Builds an \ref LMatrix from the positions of the non-zero entries of each row.
+     * @param rows For each row, the indices of its non-zero columns in increasing order.
+     * @param n The number of columns.
+     *
+     * Equivalent to the dense constructor, but the cost is linear in the number of non-zero entries.
+     */
+    LMatrix(const std::vector<std::vector<int>>& rows, int n);
+    /**
+     * @brief Like the constructor above, but only the columns flagged in @p primary are preferred by
+     * \ref smallest_column() among the columns of the same size.
+     * @param primary One flag per column.
+     */
+    LMatrix(const std::vector<std::vector<int>>& rows, int n, const std::vector<bool>& primary);
     MNode* head() const; //!< \return the head node of the matrix (see the detailed class description).
     bool is_trivial() const; //!< \return 1 if the matrix is empty (ie consists only of a head node), 0 otherwise.
     int number_of_rows() const; //!< \return the number of rows (equivalently, the maximum column size).
+    /**
+     * @brief Column selector for the dancing links algorithm.
+     * @return a column with the fewest nodes, a primary one if there is any of that size.  If the matrix is empty, return @c NULL.
+     *
+     * The columns are kept in buckets by size, updated as rows and columns are removed and restored,
+     * so that the smallest column is found without scanning all of them.
+     */
+    Column* smallest_column();
     /**
      * @brief Removes the row containing the node @p node.
      * @param node A node of the matrix.
@@ -159,7 +182,15 @@ will be displayed.  This can be used to check that the \ref Column#size() values
  */
     void DEBUG_display(std::ostream& out_stream=std::cout);
 private:
+    void init_buckets(const std::vector<bool>& primary);
+    static int bucket_index(const Column *c);
+    void bucket_insert(Column *c);
+    void bucket_erase(Column *c);
+    void resize_column(Column *c, int N);
+
     MNode *root;
+    std::vector<Column*> bucket_first; // first column of each bucket, see bucket_index()
+    int min_bucket;     // the buckets before this one are empty
     int row_count;      // 1 plus the index of the last nonzero row index of the ORIGINAL matrix
                         // set in the constructor and not ever modified
                         // only needed for DEBUG_display()
@@ -209,12 +240,18 @@ class Column : public MNode
 {
 public:
     Column(int theSize=0)
-        : MNode(MData(-1,this)), _size(theSize) {}
+        : MNode(MData(-1,this)), _size(theSize), _primary(true), _in_bucket(false), _bucket_prev(NULL), _bucket_next(NULL) {}
     int size() const {return _size;} //!< returns the number of nodes in the column.
     void set_size(int N) {_size = N;} //!< sets the number of nodes in the column to @p N.
     void add_to_size(int N) {_size += N;} //!< Adds @p N to the number of nodes in the column.
+    bool is_primary() const {return _primary;} //!< returns whether the column is preferred among the columns of the same size.
 private:
+    friend class LMatrix;
     int _size;
+    bool _primary;
+    bool _in_bucket;        // whether the column is in the matrix, and so in the bucket of its size
+    Column *_bucket_prev;   // neighbours in the bucket of the columns of the same size
+    Column *_bucket_next;
 };
 
 
@@ -0,0 +1,66 @@
+#include "truecandidatesthread.h"
+
+TrueCandidatesThread::TrueCandidatesThread(QObject *parent)
+    : QThread{parent}
+    , mFinder(nullptr)
+    , mPuzzleData(nullptr)
+    , mUseHints(false)
+    , mAbort(false)
+    , mInputMutex()
+{
+}
+
+TrueCandidatesThread::~TrueCandidatesThread()
+{
+    mInputMutex.lock();
+    mAbort = true;
+    mInputMutex.unlock();
+    wait();
+}
+
+void TrueCandidatesThread::run()
+{
+    mInputMutex.lock();
+    std::unique_ptr<PuzzleData> puzzleData = std::move(mPuzzleData);
+    bool useHints = mUseHints;
+    mInputMutex.unlock();
+
+    emit CalculationStarted();
+
+    // the workers are started on first use and kept for the following requests
+    if (!mFinder)
+    {
+        mFinder = std::make_unique<TrueCandidatesFinder>();
+    }
+
+    // each cell is shown as soon as its candidates are confirmed
+    TrueCandidatesFinder::Candidates candidates;
+    bool success = mFinder->Find(*puzzleData, useHints, candidates,
+                                 [this](CellCoord cell, const std::set<unsigned short>& cellCandidates)
+    {
+        emit CellCandidatesFound(cell, cellCandidates, cellCandidates.size() == 1);
+    }, &mAbort);
+
+    emit CalculationFinished(success);
+}
+
+void TrueCandidatesThread::FindTrueCandidates(const PuzzleData &puzzleData, bool useHints)
+{
+    if(!isRunning())
+    {
+        QMutexLocker locker(&mInputMutex);
+        mAbort = false;
+        mUseHints = useHints;
+        mPuzzleData = std::make_unique<PuzzleData>(puzzleData);
+        start(LowPriority);
+    }
+}
+
+void TrueCandidatesThread::AbortCalculation()
+{
+    if(isRunning())
+    {
+        QMutexLocker locker(&mInputMutex);
+        mAbort = true;
+    }
+}
@@ -0,0 +1,38 @@
+#ifndef TRUECANDIDATESTHREAD_H
+#define TRUECANDIDATESTHREAD_H
+
+#include <QThread>
+#include <QMutex>
+#include <atomic>
+#include <set>
+#include "puzzledata.h"
+#include "solver/TrueCandidatesFinder.h"
+
+class TrueCandidatesThread : public QThread
+{
+    Q_OBJECT
+public:
+    explicit TrueCandidatesThread(QObject *parent = nullptr);
+    ~TrueCandidatesThread();
+
+signals:
+    void CalculationStarted();
+    void CalculationFinished(bool success);
+    void CellCandidatesFound(unsigned int id, const std::set<unsigned short>& candidates, bool isSolved);
+
+protected:
+    void run() override;
+
+private:
+    std::unique_ptr<TrueCandidatesFinder> mFinder;
+    std::unique_ptr<PuzzleData> mPuzzleData;
+    bool mUseHints;
+    std::atomic<bool> mAbort;
+    QMutex mInputMutex;
+
+public:
+    void FindTrueCandidates(const PuzzleData& puzzleData, bool useHints);
+    void AbortCalculation();
+};
+
+#endif // TRUECANDIDATESTHREAD_H
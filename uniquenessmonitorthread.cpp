@@ -0,0 +1,126 @@
+#include "uniquenessmonitorthread.h"
+#include <algorithm>
+
+UniquenessMonitorThread::UniquenessMonitorThread(QObject *parent)
+    : QThread{parent}
+    , mPendingPuzzle(nullptr)
+    , mAbort(false)
+    , mQuit(false)
+    , mInputMutex()
+    , mThreadCondition()
+    , mCheckedPuzzle(nullptr)
+    , mKnownSolutions()
+    , mExhaustive(false)
+    , mPartialSolutions()
+{
+}
+
+UniquenessMonitorThread::~UniquenessMonitorThread()
+{
+    mInputMutex.lock();
+    mAbort = true;
+    mQuit = true;
+    mThreadCondition.wakeOne();
+    mInputMutex.unlock();
+    wait();
+}
+
+void UniquenessMonitorThread::run()
+{
+    forever
+    {
+        mInputMutex.lock();
+        while (!mPendingPuzzle && !mQuit)
+        {
+            mThreadCondition.wait(&mInputMutex);
+        }
+        if (mQuit)
+        {
+            mInputMutex.unlock();
+            return;
+        }
+        std::unique_ptr<PuzzleData> puzzleData = std::move(mPendingPuzzle);
+        mAbort = false;
+        mInputMutex.unlock();
+
+        Status status;
+        if (Check(*puzzleData, status))
+        {
+            mCheckedPuzzle = std::move(puzzleData);
+            emit UniquenessChecked(status);
+        }
+    }
+}
+
+bool UniquenessMonitorThread::Check(const PuzzleData &puzzleData, Status &outStatus)
+{
+    // solutions of the previous puzzles that are still valid
+    std::vector<PuzzleSolutionCounter::Solution> solutions;
+    for (const auto& s : mKnownSolutions)
+    {
+        if (PuzzleSolutionCounter::IsSolution(puzzleData, s, false))
+        {
+            solutions.push_back(s);
+        }
+    }
+    for (const auto& s : mPartialSolutions)
+    {
+        if (PuzzleSolutionCounter::IsSolution(puzzleData, s, false) &&
+            std::find(solutions.begin(), solutions.end(), s) == solutions.end())
+        {
+            solutions.push_back(s);
+        }
+    }
+
+    // two of them are enough to know that the solution is not unique;
+    // if the edit has only added constraints and all the previous solutions
+    // were known, the solutions left are all the solutions of the new puzzle
+    bool settled = solutions.size() >= kMaxSolutionsCount ||
+                   (mExhaustive && mCheckedPuzzle && PuzzleSolutionCounter::IsRestrictionOf(puzzleData, *mCheckedPuzzle, false));
+
+    if (!settled)
+    {
+        emit UniquenessChecked(Status_Checking);
+
+        std::vector<PuzzleSolutionCounter::Solution> carriedSolutions = std::move(solutions);
+        solutions.clear();
+        PuzzleSolutionCounter counter(puzzleData, false);
+        counter.CountSolutions(kMaxSolutionsCount, &mAbort, &solutions);
+        if (mAbort)
+        {
+            // superseded by a newer edit: keep the results of the last complete check,
+            // and the solutions known for this puzzle in case they still hold after the edit
+            for (auto& s : solutions)
+            {
+                if (std::find(carriedSolutions.begin(), carriedSolutions.end(), s) == carriedSolutions.end())
+                {
+                    carriedSolutions.push_back(std::move(s));
+                }
+            }
+            mPartialSolutions = std::move(carriedSolutions);
+            return false;
+        }
+    }
+
+    mExhaustive = solutions.size() < kMaxSolutionsCount;
+    mKnownSolutions = std::move(solutions);
+    mPartialSolutions.clear();
+    outStatus = mKnownSolutions.empty() ? Status_NoSolution :
+                (mKnownSolutions.size() == 1 ? Status_Unique : Status_Multiple);
+    return true;
+}
+
+void UniquenessMonitorThread::CheckPuzzle(const PuzzleData &puzzleData)
+{
+    QMutexLocker locker(&mInputMutex);
+    mPendingPuzzle = std::make_unique<PuzzleData>(puzzleData);
+    mAbort = true;
+    if (!isRunning())
+    {
+        start(LowPriority);
+    }
+    else
+    {
+        mThreadCondition.wakeOne();
+    }
+}
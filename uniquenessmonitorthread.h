@@ -0,0 +1,59 @@
+#ifndef UNIQUENESSMONITORTHREAD_H
+#define UNIQUENESSMONITORTHREAD_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <atomic>
+#include "puzzledata.h"
+#include "solver/PuzzleSolutionCounter.h"
+
+/// <summary>
+/// Checks in the background whether the puzzle being set has a unique solution.
+/// Every edit cancels the check in progress and starts a new one; the solutions
+/// found by the previous checks, even cancelled ones, are reused whenever they
+/// settle the answer.
+/// </summary>
+class UniquenessMonitorThread : public QThread
+{
+    Q_OBJECT
+public:
+    enum Status
+    {
+        Status_Checking,
+        Status_NoSolution,
+        Status_Unique,
+        Status_Multiple
+    };
+
+    explicit UniquenessMonitorThread(QObject *parent = nullptr);
+    ~UniquenessMonitorThread();
+
+signals:
+    void UniquenessChecked(int status);
+
+protected:
+    void run() override;
+
+private:
+    static const size_t kMaxSolutionsCount = 2;
+
+    std::unique_ptr<PuzzleData> mPendingPuzzle;     // latest edit, waiting to be checked
+    std::atomic<bool> mAbort;                       // a newer puzzle has been submitted
+    bool mQuit;
+    QMutex mInputMutex;
+    QWaitCondition mThreadCondition;
+
+    // the following are only accessed by the monitor thread
+    std::unique_ptr<PuzzleData> mCheckedPuzzle;                     // last puzzle checked to the end
+    std::vector<PuzzleSolutionCounter::Solution> mKnownSolutions;   // solutions found for mCheckedPuzzle
+    bool mExhaustive;                                               // mKnownSolutions are all the solutions
+    std::vector<PuzzleSolutionCounter::Solution> mPartialSolutions; // solutions found by checks that were cancelled
+
+    bool Check(const PuzzleData& puzzleData, Status& outStatus);
+
+public:
+    void CheckPuzzle(const PuzzleData& puzzleData);
+};
+
+#endif // UNIQUENESSMONITORTHREAD_H